@@ -5,6 +5,7 @@
 #include <aerial_autonomy/actions_guards/manual_control_functors.h>
 #include <aerial_autonomy/actions_guards/shorting_action_sequence.h>
 #include <aerial_autonomy/actions_guards/visual_servoing_functors.h>
+#include <aerial_autonomy/common/clock.h>
 #include <aerial_autonomy/common/conversions.h>
 #include <aerial_autonomy/common/proto_utils.h>
 #include <aerial_autonomy/logic_states/base_state.h>
@@ -650,12 +651,11 @@ public:
         // start grip timer
         VLOG(1) << "Gripping object";
         gripping_ = true;
-        grip_start_time_ = std::chrono::high_resolution_clock::now();
+        grip_start_time_ = Clock::instance().now();
       } else {
         // check grip timer
-        grip_duration_success =
-            std::chrono::high_resolution_clock::now() - grip_start_time_ >
-            required_grip_duration_;
+        grip_duration_success = Clock::instance().now() - grip_start_time_ >
+                                required_grip_duration_;
       }
     } else {
       if (gripping_) {
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <aerial_autonomy/common/clock.h>
+#include <aerial_autonomy/common/timer_executor.h>
+
 #include <atomic>
 #include <chrono>
 #include <functional>
-#include <thread>
+#include <memory>
+#include <string>
 
 /**
- * @brief Calls given function on a timer in its own thread
+ * @brief Calls given function on a timer. The function runs on a shared
+ * TimerExecutor if one is given, otherwise in its own thread. If the process
+ * clock is a SimulatedClock when the timer starts, the function is instead
+ * called by the simulated clock as it advances
  */
 class AsyncTimer {
 public:
@@ -14,39 +21,66 @@ public:
    * @brief Constructor
    * @param function Function to call
    * @param timer_duration The amount of time in between each function call
+   * @param name Name of the timer thread and of its ticks in traces
+   * @param executor Executor running the function. A private executor with a
+   * single thread is used if null
+   * @param priority Priority of the function on the executor
    */
   AsyncTimer(std::function<void()> function,
-             std::chrono::duration<double> timer_duration);
+             std::chrono::duration<double> timer_duration,
+             std::string name = "async_timer",
+             std::shared_ptr<TimerExecutor> executor = nullptr,
+             TimerPriority priority = TimerPriority::Normal);
   /**
-   * @brief Destructor cleans up running thread
+   * @brief Destructor stops the timer
    */
   virtual ~AsyncTimer();
 
   /**
-   * @brief Starts running the timer thread
+   * @brief Starts running the timer
    */
   void start();
 
   /**
-   * @brief Stops running the timer thread
+   * @brief Stops running the timer. Waits for a running function call to
+   * return
    */
   void stop();
 
   /**
-   * @brief Set the duration of the timer
+   * @brief Call the function early, e.g. when new sensor data arrives. The
+   * timer duration then acts as a timeout after the last call. Can be called
+   * from any thread. Ignored on a simulated clock
+   * @param min_interval Minimum time between the starts of two calls
+   */
+  void trigger(std::chrono::duration<double> min_interval);
+
+  /**
+   * @brief Set the duration of the timer. A running timer keeps running and
+   * makes its next call one new duration after the previous one. Can be
+   * called from the timer function
    * @param duration The duration to set
    */
   void setDuration(std::chrono::duration<double> duration);
 
-private:
   /**
-   * @brief The timer loop
+   * @brief Get the start jitter, execution time and overruns of the calls
+   * run by the executor since construction
+   * @return Statistics summary
    */
-  void functionTimer();
+  TimerStatistics::Summary statistics() const;
 
-  std::thread timer_thread_;       ///< The thread used for the timer
+private:
   std::function<void()> function_; ///< The function called by the timer
   std::chrono::duration<double>
       timer_duration_; ///< The amount of time in between each function call
   std::atomic_bool running_; ///< True when the timer is running
+  std::string name_;         ///< Name of the timer
+  const char *tick_name_;    ///< Interned name of the tick spans
+  std::shared_ptr<TimerExecutor> executor_; ///< Runs the function
+  TimerPriority priority_;                  ///< Priority on the executor
+  std::atomic<TimerExecutor::TaskId> task_id_; ///< Id of the scheduled task
+  std::shared_ptr<TimerStatistics> statistics_; ///< Timing of the calls
+  SimulatedClock *simulated_clock_; ///< Clock running the function, if any
+  SimulatedClock::TimerId simulated_timer_id_; ///< Id on the simulated clock
 };
@@ -1,18 +1,263 @@
 #pragma once
 
-#include <boost/thread/mutex.hpp>
+#include <aerial_autonomy/common/profiled_mutex.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief Synchronization schemes of Atomic
+ */
+namespace atomic_policy {
+/**
+* @brief Readers and writers share a mutex. Suits any copyable type
+*/
+struct Mutex {};
+/**
+* @brief Sequence lock. Readers never take a lock; they copy the value and
+* retry if a write overlapped the copy. Writers do not wait for readers.
+* Requires a trivially copyable type, e.g. Velocity
+*/
+struct SeqLock {};
+/**
+* @brief Three buffers. Readers never take a lock nor retry while a value is
+* being written: they copy the last complete value while the writer fills
+* another buffer. Writers wait for readers still copying older values. Suits
+* types with non-trivial copies such as tf::StampedTransform or
+* ControllerStatus
+*/
+struct TripleBuffer {};
+}
+
+/**
+ * @brief Storage of an Atomic value for a synchronization policy
+ *
+ * @tparam T Type of the value
+ * @tparam Policy One of the atomic_policy types
+ */
+template <class T, class Policy> class AtomicStorage;
+
+/**
+ * @brief Storage guarded by a mutex
+ */
+template <class T> class AtomicStorage<T, atomic_policy::Mutex> {
+public:
+  /**
+   * @brief Constructor
+   * @param name Name of the mutex in the lock statistics
+   */
+  explicit AtomicStorage(const char *name = "atomic") : mutex_(name) {}
+
+  /**
+   * @brief Get the lock name
+   * @return Name of the mutex in the lock statistics
+   */
+  const char *name() const { return mutex_.name(); }
+
+  /**
+   * @brief Set the data
+   * @param data Value to set member data to
+   */
+  void set(const T &data) {
+    std::lock_guard<ProfiledMutex> lock(mutex_);
+    data_ = data;
+  }
+
+  /**
+   * @brief Get the data
+   * @return The data
+   */
+  T get() const {
+    std::lock_guard<ProfiledMutex> lock(mutex_);
+    T data_copy = data_;
+    return data_copy;
+  }
+
+private:
+  T data_;                      ///< Data being stored
+  mutable ProfiledMutex mutex_; ///< Synchronize access to data
+};
+
+/**
+ * @brief Storage guarded by a sequence lock. The value is kept in atomic
+ * words so that a read overlapping a write is well defined and discarded
+ */
+template <class T> class AtomicStorage<T, atomic_policy::SeqLock> {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLock requires a trivially copyable type");
+
+public:
+  /**
+   * @brief Constructor stores a default constructed value
+   * @param name Name of the writer mutex in the lock statistics
+   */
+  explicit AtomicStorage(const char *name = "atomic_seqlock")
+      : sequence_(0), write_mutex_(name) {
+    for (auto &word : words_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+    set(T());
+  }
+
+  /**
+   * @brief Get the lock name
+   * @return Name of the writer mutex in the lock statistics
+   */
+  const char *name() const { return write_mutex_.name(); }
+
+  /**
+   * @brief Set the data. Concurrent writers are serialized
+   * @param data Value to set member data to
+   */
+  void set(const T &data) {
+    uint64_t buffer[kWords] = {};
+    std::memcpy(buffer, &data, sizeof(T));
+    std::lock_guard<ProfiledMutex> lock(write_mutex_);
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    // An odd sequence marks a write in progress
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Get the data. Retries while a write is in progress
+   * @return The data
+   */
+  T get() const {
+    uint64_t buffer[kWords];
+    while (true) {
+      uint64_t sequence = sequence_.load(std::memory_order_acquire);
+      if (sequence & 1) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (size_t i = 0; i < kWords; ++i) {
+        buffer[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == sequence) {
+        break;
+      }
+    }
+    T data;
+    std::memcpy(&data, buffer, sizeof(T));
+    return data;
+  }
+
+private:
+  /**
+   * @brief Number of words holding the value
+   */
+  static const size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) /
+                               sizeof(uint64_t);
+  std::atomic<uint64_t> words_[kWords]; ///< Value
+  std::atomic<uint64_t> sequence_;      ///< Incremented around writes
+  ProfiledMutex write_mutex_;           ///< Serializes writers
+};
+
+/**
+ * @brief Storage in three buffers. The writer fills a buffer that is neither
+ * the latest one nor being copied by a reader, then publishes it
+ */
+template <class T> class AtomicStorage<T, atomic_policy::TripleBuffer> {
+public:
+  /**
+   * @brief Constructor publishes the first default constructed buffer
+   * @param name Name of the writer mutex in the lock statistics
+   */
+  explicit AtomicStorage(const char *name = "atomic_triple_buffer")
+      : latest_(0), write_mutex_(name) {
+    for (auto &readers : readers_) {
+      readers.store(0);
+    }
+  }
+
+  /**
+   * @brief Get the lock name
+   * @return Name of the writer mutex in the lock statistics
+   */
+  const char *name() const { return write_mutex_.name(); }
+
+  /**
+   * @brief Set the data. Concurrent writers are serialized
+   * @param data Value to set member data to
+   */
+  void set(const T &data) {
+    std::lock_guard<ProfiledMutex> lock(write_mutex_);
+    int latest = latest_.load();
+    while (true) {
+      for (int i = 0; i < kBuffers; ++i) {
+        if (i != latest && readers_[i].load() == 0) {
+          buffers_[i] = data;
+          latest_.store(i);
+          return;
+        }
+      }
+      // Readers are still copying both older values
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief Get the data
+   * @return The data
+   */
+  T get() const {
+    while (true) {
+      int latest = latest_.load();
+      readers_[latest].fetch_add(1);
+      // The buffer is safe to copy if it was still the latest once reserved
+      if (latest_.load() == latest) {
+        T data_copy = buffers_[latest];
+        readers_[latest].fetch_sub(1);
+        return data_copy;
+      }
+      readers_[latest].fetch_sub(1);
+    }
+  }
+
+private:
+  /**
+   * @brief Number of buffers
+   */
+  static const int kBuffers = 3;
+  T buffers_[kBuffers];                        ///< Values
+  std::atomic<int> latest_;                    ///< Buffer of the last value
+  mutable std::atomic<int> readers_[kBuffers]; ///< Readers copying a buffer
+  ProfiledMutex write_mutex_;                  ///< Serializes writers
+};
 
 /**
  * @brief Template class to create thread-safe variables with internal lock
  * management.
+ *
+ * @tparam T Type of the value
+ * @tparam Policy Synchronization scheme, see atomic_policy. Values read from
+ * control loops while other threads write them should use a lock-free
+ * policy, so that readers never wait for a writer that got preempted
  */
-template <class T> class Atomic {
+template <class T, class Policy = atomic_policy::Mutex> class Atomic {
 public:
   /**
    * @brief Default constructor
    */
   Atomic() = default;
 
+  /**
+   * @brief Constructor naming the lock in the lock statistics. Atomics
+   * without a name share the statistics of their policy
+   * @param name Lock name
+   */
+  explicit Atomic(LockName name) : storage_(name.name) {}
+
   /**
    * @brief Constructor that sets member data
    * @param data Value to set member data to
@@ -20,35 +265,39 @@ public:
   Atomic(const T &data) { this->set(data); }
 
   /**
-   * @brief Copy constructor
+   * @brief Constructor that sets member data and names the lock
+   * @param data Value to set member data to
+   * @param name Lock name
+   */
+  Atomic(const T &data, LockName name) : storage_(name.name) {
+    this->set(data);
+  }
+
+  /**
+   * @brief Copy constructor. The copy keeps the lock name
    * @param a Instance to copy
    */
-  Atomic(const Atomic<T> &a) { this->set(a.get()); }
+  Atomic(const Atomic<T, Policy> &a) : storage_(a.storage_.name()) {
+    this->set(a.get());
+  }
 
   /**
    * @brief Set the data
    * @param data Value to set member data to
    */
-  void set(const T &data) {
-    boost::mutex::scoped_lock lock(mutex_);
-    data_ = data;
-  }
+  void set(const T &data) { storage_.set(data); }
 
   /**
    * @brief Get the data
    * @return The data
    */
-  T get() const {
-    boost::mutex::scoped_lock lock(mutex_);
-    T data_copy = data_;
-    return data_copy;
-  }
+  T get() const { return storage_.get(); }
 
   /**
    * @brief Assignment operator
    * @param a Atomic class whose data we are copying
    */
-  void operator=(const Atomic<T> &a) { this->set(a.get()); }
+  void operator=(const Atomic<T, Policy> &a) { this->set(a.get()); }
 
   /**
    * @brief Assignment operator for data
@@ -63,6 +312,5 @@ public:
   operator T() const { return this->get(); }
 
 private:
-  T data_;                     ///< Data being stored
-  mutable boost::mutex mutex_; ///< Synchronize access to data
+  AtomicStorage<T, Policy> storage_; ///< Data being stored
 };
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Source of the current time.
+ *
+ * Code measuring elapsed time reads it from Clock::instance() instead of
+ * std::chrono clocks, so that tests and simulations can replace the system
+ * clock with a SimulatedClock.
+ */
+class Clock {
+public:
+  /**
+  * @brief Point in time. Same type as the system clock uses
+  */
+  using time_point = std::chrono::high_resolution_clock::time_point;
+  /**
+  * @brief Difference between two points in time
+  */
+  using duration = std::chrono::high_resolution_clock::duration;
+
+  /**
+  * @brief Destructor
+  */
+  virtual ~Clock() {}
+
+  /**
+  * @brief Get the current time
+  * @return Current time
+  */
+  virtual time_point now() const = 0;
+
+  /**
+  * @brief Get the clock used by the process. The system clock by default
+  * @return Current clock
+  */
+  static Clock &instance();
+
+  /**
+  * @brief Replace the clock used by the process. Should be called before
+  * starting any timers. Clocks are kept alive until exit so that references
+  * returned by instance stay valid
+  * @param clock New clock. The system clock is restored if null
+  */
+  static void setInstance(std::shared_ptr<Clock> clock);
+};
+
+/**
+ * @brief Clock that reads std::chrono::high_resolution_clock
+ */
+class SystemClock : public Clock {
+public:
+  /**
+  * @brief Get the current time
+  * @return Current system time
+  */
+  time_point now() const override;
+};
+
+/**
+ * @brief Clock whose time only moves when advanced.
+ *
+ * AsyncTimers started while a SimulatedClock is the process clock are
+ * registered with it instead of running on threads. Advancing the clock
+ * runs every due timer on the calling thread, in the order of their
+ * deadlines, with the time set to each deadline. Closed loops therefore
+ * step deterministically and as fast as the computation allows.
+ */
+class SimulatedClock : public Clock {
+public:
+  /**
+  * @brief Identifies a timer
+  */
+  using TimerId = uint64_t;
+
+  /**
+  * @brief Constructor
+  * @param start Initial time
+  */
+  explicit SimulatedClock(time_point start = time_point());
+
+  /**
+  * @brief Get the current simulated time
+  * @return Current time
+  */
+  time_point now() const override;
+
+  /**
+  * @brief Call a function periodically in simulated time. The first call
+  * is due immediately
+  * @param function Function to call
+  * @param period Time between two calls
+  * @return Id used to remove the timer
+  */
+  TimerId addTimer(std::function<void()> function,
+                   std::chrono::duration<double> period);
+
+  /**
+  * @brief Stop calling a timer function. Waits for a running call to return
+  * unless called from that call. Unknown ids are ignored
+  * @param id Id returned by addTimer
+  */
+  void removeTimer(TimerId id);
+
+  /**
+  * @brief Change the period of a timer. The next call is one new period
+  * after the previous call, or now if that has passed. Can be called from a
+  * timer function. Unknown ids are ignored
+  * @param id Id returned by addTimer
+  * @param period New time between two calls
+  */
+  void setPeriod(TimerId id, std::chrono::duration<double> period);
+
+  /**
+  * @brief Move the time forward, running the timers due until then. Must
+  * not be called from a timer function
+  * @param step Time to advance by
+  */
+  void advance(std::chrono::duration<double> step);
+
+  /**
+  * @brief Move the time forward to a given time, running the timers due
+  * until then. Does nothing if the time is in the past
+  * @param time Time to advance to
+  */
+  void advanceTo(time_point time);
+
+private:
+  /**
+  * @brief A registered timer
+  */
+  struct Timer {
+    std::function<void()> function; ///< Function to call
+    duration period;                ///< Time between calls
+    time_point deadline;            ///< Time of the next call
+    bool called;                    ///< True once the function was called
+  };
+
+  std::atomic<duration::rep> time_; ///< Time since the epoch
+  std::map<TimerId, Timer> timers_; ///< Registered timers by id
+  TimerId next_id_;                 ///< Id of the next timer
+  bool running_;                    ///< True while a timer function runs
+  TimerId running_id_;              ///< Id of the running timer
+  std::thread::id running_thread_;  ///< Thread running the timer
+  std::mutex mutex_;                ///< Guards the timers
+  std::condition_variable done_cv_; ///< Signals the end of a call
+  std::mutex advance_mutex_;        ///< Serializes advancing the time
+};
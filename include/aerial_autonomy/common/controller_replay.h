@@ -0,0 +1,244 @@
+#pragma once
+
+#include "aerial_autonomy/controllers/base_controller.h"
+
+#include <Eigen/Dense>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Controller inputs of a recorded run, reconstructed from DataStream
+ * logs
+ *
+ * @tparam SensorDataT Sensor data type of the controller
+ * @tparam GoalT Goal type of the controller
+ */
+template <class SensorDataT, class GoalT> struct ReplayTrace {
+  GoalT goal;                           ///< Goal tracked during the run
+  std::vector<SensorDataT> sensor_data; ///< Controller input of each step
+  /**
+  * @brief Controller output logged at each step. Empty if the output cannot
+  * be reconstructed from the logs
+  */
+  std::vector<Eigen::VectorXd> recorded_controls;
+};
+
+/**
+ * @brief Solve time and control deviation of one replayed controller config
+ */
+struct ReplayResult {
+  /**
+  * @brief Constructor
+  */
+  ReplayResult()
+      : steps(0), failures(0), mean_solve_time(0), max_solve_time(0) {}
+
+  std::string name;              ///< Name of the config
+  uint64_t steps;                ///< Number of replayed steps
+  uint64_t failures;             ///< Steps for which the controller failed
+  double mean_solve_time;        ///< Mean time of a controller run in seconds
+  double max_solve_time;         ///< Max time of a controller run in seconds
+  Eigen::VectorXd rms_deviation; ///< RMS control deviation of each channel
+  std::string error;             ///< Exception thrown by the replay if any
+};
+
+/**
+ * @brief Replays the recorded inputs of a controller with alternate configs.
+ *
+ * Each config gets its own controller instance which is fed the recorded
+ * sensor data step by step, exactly as its connector would. The time spent in
+ * Controller::run is measured and the computed controls are compared against
+ * the recorded controls of the trace or, if the trace has none, against the
+ * controls of the first (baseline) config. Configs are replayed in parallel on
+ * a fixed number of threads; controllers are constructed one at a time since
+ * constructors may register log streams or generate code.
+ *
+ * @tparam SensorDataT Sensor data type of the controller
+ * @tparam GoalT Goal type of the controller
+ * @tparam ControlT Control type of the controller
+ * @tparam ConfigT Config type of the controller
+ */
+template <class SensorDataT, class GoalT, class ControlT, class ConfigT>
+class ControllerReplay {
+public:
+  /**
+  * @brief Controller interface used for replay
+  */
+  using ControllerT = Controller<SensorDataT, GoalT, ControlT>;
+  /**
+  * @brief Creates a controller for a config
+  */
+  using Factory =
+      std::function<std::unique_ptr<ControllerT>(const ConfigT &config)>;
+  /**
+  * @brief Flattens a control into the channels that are compared
+  */
+  using ControlToVector =
+      std::function<Eigen::VectorXd(const ControlT &control)>;
+  /**
+  * @brief A config together with its name in the report
+  */
+  using NamedConfig = std::pair<std::string, ConfigT>;
+
+  /**
+  * @brief Constructor
+  * @param trace Recorded controller inputs
+  * @param factory Creates a controller for a config
+  * @param to_vector Flattens a control into the compared channels
+  */
+  ControllerReplay(ReplayTrace<SensorDataT, GoalT> trace, Factory factory,
+                   ControlToVector to_vector)
+      : trace_(std::move(trace)), factory_(std::move(factory)),
+        to_vector_(std::move(to_vector)) {}
+
+  /**
+  * @brief Replay a single config
+  * @param config Config to replay
+  * @param reference Controls to compare against. Nothing is compared if
+  * empty
+  * @param controls Output, the controls computed at each step. Can be null
+  * @return Solve time and deviation. rms_deviation is empty if nothing was
+  * compared
+  */
+  ReplayResult replay(const NamedConfig &config,
+                      const std::vector<Eigen::VectorXd> &reference,
+                      std::vector<Eigen::VectorXd> *controls = nullptr) const {
+    ReplayResult result;
+    result.name = config.first;
+    std::unique_ptr<ControllerT> controller;
+    {
+      std::lock_guard<std::mutex> lock(factory_mutex_);
+      controller = factory_(config.second);
+    }
+    controller->reset();
+    controller->setGoal(trace_.goal);
+    Eigen::VectorXd squared_error;
+    uint64_t compared = 0;
+    double total_solve_time = 0;
+    for (size_t i = 0; i < trace_.sensor_data.size(); ++i) {
+      ControlT control;
+      auto start = std::chrono::high_resolution_clock::now();
+      bool success = controller->run(trace_.sensor_data[i], control);
+      std::chrono::duration<double> solve_time =
+          std::chrono::high_resolution_clock::now() - start;
+      total_solve_time += solve_time.count();
+      result.max_solve_time =
+          std::max(result.max_solve_time, solve_time.count());
+      ++result.steps;
+      if (!success) {
+        ++result.failures;
+      }
+      Eigen::VectorXd control_vector = to_vector_(control);
+      if (i < reference.size() &&
+          reference[i].size() == control_vector.size()) {
+        if (squared_error.size() == 0) {
+          squared_error = Eigen::VectorXd::Zero(control_vector.size());
+        }
+        squared_error +=
+            (control_vector - reference[i]).cwiseAbs2().eval();
+        ++compared;
+      }
+      if (controls) {
+        controls->push_back(control_vector);
+      }
+    }
+    if (result.steps > 0) {
+      result.mean_solve_time = total_solve_time / result.steps;
+    }
+    if (compared > 0) {
+      result.rms_deviation = (squared_error / compared).cwiseSqrt();
+    }
+    return result;
+  }
+
+  /**
+  * @brief Replay several configs in parallel
+  *
+  * If the trace has no recorded controls, the first config is replayed
+  * before the others and used as baseline for the deviation.
+  *
+  * @param configs Configs to replay
+  * @param thread_count Number of replay threads. Uses all hardware threads if
+  * 0
+  * @return Results in the order of the configs
+  */
+  std::vector<ReplayResult> replay(const std::vector<NamedConfig> &configs,
+                                   unsigned thread_count = 0) const {
+    std::vector<ReplayResult> results(configs.size());
+    if (configs.empty()) {
+      return results;
+    }
+    std::vector<Eigen::VectorXd> baseline;
+    const std::vector<Eigen::VectorXd> *reference = &trace_.recorded_controls;
+    size_t first = 0;
+    if (trace_.recorded_controls.empty()) {
+      results[0] = guardedReplay(configs[0], *reference, &baseline);
+      if (!baseline.empty()) {
+        results[0].rms_deviation =
+            Eigen::VectorXd::Zero(baseline.front().size());
+      }
+      reference = &baseline;
+      first = 1;
+    }
+    if (thread_count == 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::atomic<size_t> next(first);
+    auto worker = [&]() {
+      for (size_t i = next++; i < configs.size(); i = next++) {
+        results[i] = guardedReplay(configs[i], *reference);
+      }
+    };
+    std::vector<std::thread> threads;
+    size_t pending = configs.size() - first;
+    for (unsigned i = 0; i < std::min<size_t>(thread_count, pending); ++i) {
+      threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return results;
+  }
+
+  /**
+  * @brief Get the replayed trace
+  * @return Recorded controller inputs
+  */
+  const ReplayTrace<SensorDataT, GoalT> &trace() const { return trace_; }
+
+private:
+  /**
+  * @brief Replay a config and record any exception in the result instead of
+  * letting it escape a replay thread
+  */
+  ReplayResult
+  guardedReplay(const NamedConfig &config,
+                const std::vector<Eigen::VectorXd> &reference,
+                std::vector<Eigen::VectorXd> *controls = nullptr) const {
+    try {
+      return replay(config, reference, controls);
+    } catch (const std::exception &e) {
+      LOG(WARNING) << "Replay of " << config.first << " failed: " << e.what();
+      ReplayResult result;
+      result.name = config.first;
+      result.error = e.what();
+      return result;
+    }
+  }
+
+  ReplayTrace<SensorDataT, GoalT> trace_; ///< Recorded controller inputs
+  Factory factory_;                       ///< Creates controllers
+  ControlToVector to_vector_;             ///< Flattens controls
+  mutable std::mutex factory_mutex_;      ///< Serializes construction
+};
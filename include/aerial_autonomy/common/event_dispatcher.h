@@ -0,0 +1,113 @@
+#pragma once
+
+#include <aerial_autonomy/common/latency_histogram.h>
+#include <aerial_autonomy/common/mpsc_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs posted work items one at a time on a dispatch thread.
+ *
+ * Producers push work into a lock-free queue and return immediately; they
+ * only take a lock to wake the dispatch thread when it is sleeping on an
+ * empty queue. Items run in the order they were posted by each producer.
+ * The latency from posting an item to the end of its call is recorded per
+ * item name. The dispatch thread starts with the first posted item.
+ */
+class EventDispatcher {
+public:
+  /**
+  * @brief Latency statistics of the items with the same name, in seconds
+  */
+  struct Summary {
+    std::string name;   ///< Name of the items
+    uint64_t count;     ///< Number of handled items
+    double latency_p50; ///< Median latency from posting to handled
+    double latency_p99; ///< 99th percentile of the latency
+    double latency_max; ///< Largest latency
+  };
+
+  /**
+  * @brief Constructor
+  * @param thread_name Name of the dispatch thread in traces
+  */
+  explicit EventDispatcher(std::string thread_name = "event_dispatch");
+
+  /**
+  * @brief Destructor stops dispatching
+  */
+  ~EventDispatcher();
+
+  EventDispatcher(const EventDispatcher &) = delete;
+  EventDispatcher &operator=(const EventDispatcher &) = delete;
+
+  /**
+  * @brief Queue a work item. Can be called from any thread, including the
+  * dispatch thread. Items posted after stop are dropped
+  * @param name Name of the item in the latency statistics
+  * @param function Work to run on the dispatch thread
+  */
+  void post(const std::string &name, std::function<void()> function);
+
+  /**
+  * @brief Stop the dispatch thread after its current item and wait for it.
+  * Pending items are dropped. Must not be called from a dispatched item
+  */
+  void stop();
+
+  /**
+  * @brief Get the latency statistics of the handled items
+  * @return Statistics of each item name, sorted by name
+  */
+  std::vector<Summary> statistics() const;
+
+private:
+  /**
+  * @brief Clock used for latencies
+  */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+  * @brief Queued work item
+  */
+  struct Item {
+    std::string name;               ///< Name in the statistics
+    std::function<void()> function; ///< Work to run
+    Clock::time_point posted;       ///< Time the item was posted
+  };
+
+  /**
+  * @brief Dispatch thread loop
+  */
+  void dispatchLoop();
+
+  /**
+  * @brief Get the histogram of an item name, creating it if needed
+  * @param name Item name
+  * @return Histogram owned by the dispatcher
+  */
+  LatencyHistogram &histogram(const std::string &name);
+
+  const std::string thread_name_;   ///< Name of the dispatch thread
+  MPSCQueue<Item> queue_;           ///< Posted items
+  std::once_flag start_flag_;       ///< Starts the dispatch thread once
+  std::thread thread_;              ///< Dispatch thread
+  std::atomic<bool> stopping_;      ///< True once stop is called
+  std::atomic<bool> sleeping_;      ///< True while the thread may wait
+  std::mutex wake_mutex_;           ///< Guards sleeping on the queue
+  std::condition_variable wake_cv_; ///< Wakes the dispatch thread
+  /**
+  * @brief Latency histograms by item name
+  */
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;
+  mutable std::mutex histograms_mutex_; ///< Guards the histogram map
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free histogram of durations in nanoseconds.
+ *
+ * Buckets are log-linear: each power of two is split into kSubBuckets
+ * buckets, so percentiles are reported with a relative error below
+ * 1 / kSubBuckets over the whole range without any allocation. Recording is
+ * a few relaxed atomic increments and can run concurrently with reads;
+ * percentiles computed during recording may miss the latest samples.
+ */
+class LatencyHistogram {
+public:
+  /**
+  * @brief Constructor
+  */
+  LatencyHistogram();
+
+  /**
+  * @brief Add a sample
+  * @param value Duration in nanoseconds. Negative values count as zero
+  */
+  void record(int64_t value);
+
+  /**
+  * @brief Getter for the number of samples
+  * @return Number of recorded samples
+  */
+  uint64_t count() const;
+
+  /**
+  * @brief Getter for the largest sample
+  * @return Largest recorded sample in nanoseconds, zero if empty
+  */
+  int64_t max() const;
+
+  /**
+  * @brief Estimate a percentile
+  * @param fraction Fraction of samples below the returned value, in [0, 1]
+  * @return Upper bound of the bucket containing the percentile in
+  * nanoseconds, at most max(). Zero if empty
+  */
+  int64_t percentile(double fraction) const;
+
+private:
+  /**
+  * @brief Bits of the sub bucket index
+  */
+  static const int kSubBucketBits = 3;
+  /**
+  * @brief Number of buckets per power of two
+  */
+  static const int kSubBuckets = 1 << kSubBucketBits;
+  /**
+  * @brief Total number of buckets, enough for any non-negative int64_t
+  */
+  static const int kBuckets = (64 - kSubBucketBits) * kSubBuckets;
+
+  /**
+  * @brief Find the bucket of a value
+  */
+  static int bucketIndex(uint64_t value);
+
+  /**
+  * @brief Largest value of a bucket
+  */
+  static uint64_t bucketUpperBound(int index);
+
+  std::array<std::atomic<uint64_t>, kBuckets> buckets_; ///< Sample counts
+  std::atomic<uint64_t> count_;                         ///< Number of samples
+  std::atomic<int64_t> max_;                            ///< Largest sample
+};
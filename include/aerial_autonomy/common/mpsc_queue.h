@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * @brief Unbounded lock-free queue with many producers and a single
+ * consumer.
+ *
+ * Producers link a new node with a single atomic exchange, so pushing never
+ * waits for other producers or for the consumer. Only one thread may pop at
+ * a time. A value pushed by a producer that is preempted between the
+ * exchange and the link becomes visible to the consumer once the link is
+ * written.
+ *
+ * @tparam T Type of the values, default constructible
+ */
+template <class T> class MPSCQueue {
+public:
+  /**
+  * @brief Constructor creates an empty queue
+  */
+  MPSCQueue() : head_(new Node()), tail_(head_.load()) {}
+
+  /**
+  * @brief Destructor deletes the values left in the queue
+  */
+  ~MPSCQueue() {
+    while (tail_) {
+      Node *next = tail_->next.load(std::memory_order_relaxed);
+      delete tail_;
+      tail_ = next;
+    }
+  }
+
+  MPSCQueue(const MPSCQueue &) = delete;
+  MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+  /**
+  * @brief Add a value. Can be called from any thread
+  * @param value Value to add
+  */
+  void push(T value) {
+    Node *node = new Node();
+    node->value = std::move(value);
+    Node *previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node);
+  }
+
+  /**
+  * @brief Remove the oldest value. Must only be called by the consumer
+  * @param value Output, oldest value
+  * @return False if the queue is empty
+  */
+  bool pop(T &value) {
+    Node *next = tail_->next.load(std::memory_order_acquire);
+    if (!next) {
+      return false;
+    }
+    value = std::move(next->value);
+    // The node of the popped value becomes the new empty tail
+    delete tail_;
+    tail_ = next;
+    return true;
+  }
+
+  /**
+  * @brief Check for values. Must only be called by the consumer
+  * @return True if no value can be popped
+  */
+  bool empty() const { return tail_->next.load() == nullptr; }
+
+private:
+  /**
+  * @brief Element of the linked list
+  */
+  struct Node {
+    Node() : next(nullptr) {}
+    std::atomic<Node *> next; ///< Next newer node
+    T value;                  ///< Stored value
+  };
+
+  std::atomic<Node *> head_; ///< Newest node, written by producers
+  Node *tail_;               ///< Node before the oldest value, consumer only
+};
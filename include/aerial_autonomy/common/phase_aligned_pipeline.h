@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs several periodic functions from a single timer in a fixed
+ * order, phase-locked to the timer.
+ *
+ * Each stage runs every n-th tick, where n is its period divided by the
+ * period of the pipeline. All stages run on tick zero, so a stage that runs
+ * less often (e.g. a high level controller producing a goal) always runs
+ * immediately before the stages added after it (e.g. the controller
+ * consuming that goal) in the same tick.
+ */
+class PhaseAlignedPipeline {
+public:
+  /**
+  * @brief Constructor
+  * @param period Time between two ticks of the pipeline
+  */
+  PhaseAlignedPipeline(std::chrono::duration<double> period);
+
+  /**
+  * @brief Add a stage after the existing ones
+  * @param name Name of the stage for log messages
+  * @param function Function to call
+  * @param period Time between two calls of the function. Rounded to a
+  * multiple of the pipeline period, at least one period
+  */
+  void addStage(std::string name, std::function<void()> function,
+                std::chrono::duration<double> period);
+
+  /**
+  * @brief Run the stages due at the current tick, in order
+  */
+  void tick();
+
+  /**
+  * @brief Get the number of pipeline ticks between two calls of a stage
+  * @param index Index of the stage in the order of addition
+  * @return Ticks between two calls
+  */
+  uint64_t divisor(size_t index) const;
+
+private:
+  /**
+  * @brief A function and the ticks between its calls
+  */
+  struct Stage {
+    std::function<void()> function; ///< Function to call
+    uint64_t divisor;               ///< Ticks between two calls
+  };
+
+  const std::chrono::duration<double> period_; ///< Time between two ticks
+  std::vector<Stage> stages_;                  ///< Stages in order
+  uint64_t tick_;                              ///< Number of ticks so far
+};
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <aerial_autonomy/common/latency_histogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contention statistics of the mutexes sharing a name
+ *
+ * Wait time is measured from the lock call to the acquisition, hold time from
+ * the acquisition to the unlock of the outermost lock. An acquisition is
+ * contended when the mutex was held by another thread.
+ */
+class LockStatistics {
+public:
+  /**
+  * @brief Percentiles of the statistics in seconds
+  */
+  struct Summary {
+    std::string name;      ///< Name of the mutexes
+    uint64_t acquisitions; ///< Number of profiled acquisitions
+    uint64_t contended;    ///< Acquisitions that had to wait
+    double wait_p50;       ///< Median wait time
+    double wait_p99;       ///< 99th percentile of the wait time
+    double wait_max;       ///< Largest wait time
+    double hold_p50;       ///< Median hold time
+    double hold_p99;       ///< 99th percentile of the hold time
+    double hold_max;       ///< Largest hold time
+  };
+
+  /**
+  * @brief Constructor
+  * @param name Name of the mutexes
+  */
+  explicit LockStatistics(std::string name);
+
+  /**
+  * @brief Record an acquisition. Lock-free
+  * @param wait Wait time in nanoseconds
+  * @param contended True if the mutex was held by another thread
+  */
+  void recordWait(int64_t wait, bool contended);
+
+  /**
+  * @brief Record the end of a hold. Lock-free
+  * @param hold Hold time in nanoseconds
+  */
+  void recordHold(int64_t hold);
+
+  /**
+  * @brief Compute the percentiles of the recorded acquisitions
+  * @return Statistics summary
+  */
+  Summary summary() const;
+
+private:
+  const std::string name_;          ///< Name of the mutexes
+  LatencyHistogram wait_;           ///< Wait time histogram
+  LatencyHistogram hold_;           ///< Hold time histogram
+  std::atomic<uint64_t> contended_; ///< Number of contended acquisitions
+};
+
+/**
+ * @brief Process wide registry of lock statistics.
+ *
+ * Profiling is disabled by default; a profiled mutex then costs one atomic
+ * load per lock. Defining AERIAL_AUTONOMY_NO_LOCK_PROFILING at build time
+ * (cmake -DLOCK_PROFILING=OFF) removes the instrumentation altogether.
+ */
+class LockProfiler {
+public:
+  /**
+  * @brief Get the process wide profiler. Never destroyed so that mutexes can
+  * be used during static destruction
+  */
+  static LockProfiler &instance();
+
+  /**
+  * @brief Start recording lock statistics
+  */
+  void enable();
+
+  /**
+  * @brief Stop recording lock statistics. Recorded statistics are kept
+  */
+  void disable();
+
+  /**
+  * @brief Check if locks are profiled
+  * @return True if enabled
+  */
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+  * @brief Get the statistics of a lock name, creating them if needed
+  * @param name Name of the lock
+  * @return Statistics that live as long as the profiler
+  */
+  LockStatistics *statistics(const std::string &name);
+
+  /**
+  * @brief Get the statistics of all lock names
+  * @return Statistics of each lock name, sorted by name
+  */
+  std::vector<LockStatistics::Summary> summaries();
+
+  /**
+  * @brief Write the statistics of all lock names as a text table. Times are
+  * in milliseconds
+  * @param os Stream to write to
+  */
+  void writeReport(std::ostream &os);
+
+  /**
+  * @brief Current time for lock timing
+  * @return Nanoseconds since an arbitrary origin
+  */
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+private:
+  /**
+  * @brief Constructor
+  */
+  LockProfiler();
+
+  std::atomic<bool> enabled_; ///< True while recording
+  /**
+  * @brief Statistics by lock name
+  */
+  std::map<std::string, std::unique_ptr<LockStatistics>> statistics_;
+  std::mutex statistics_mutex_; ///< Guards the statistics map
+};
+
+/**
+ * @brief Name of a lock in the lock statistics, for owners that pass it on
+ * to a profiled mutex (see Atomic)
+ */
+struct LockName {
+  /**
+  * @brief Constructor
+  * @param name Name, must outlive the lock, e.g. a string literal
+  */
+  explicit LockName(const char *name) : name(name) {}
+  const char *name; ///< Name of the lock
+};
+
+/**
+ * @brief Mutex that records its wait and hold times in the LockProfiler
+ * under a name. Mutexes with the same name share their statistics.
+ *
+ * Satisfies the Lockable requirements, so it can be used with
+ * std::lock_guard and std::unique_lock. Constructing a mutex does not touch
+ * the profiler; the statistics of its name are looked up on the first lock
+ * while profiling is enabled.
+ *
+ * @tparam MutexT Wrapped mutex, std::mutex or std::recursive_mutex
+ */
+template <class MutexT> class BasicProfiledMutex {
+public:
+  /**
+  * @brief Constructor
+  * @param name Name of the mutex in the lock statistics. Must outlive the
+  * mutex, e.g. a string literal
+  */
+  explicit BasicProfiledMutex(const char *name)
+      : name_(name), statistics_(nullptr), depth_(0), hold_start_(0) {}
+
+  BasicProfiledMutex(const BasicProfiledMutex &) = delete;
+  BasicProfiledMutex &operator=(const BasicProfiledMutex &) = delete;
+
+  /**
+  * @brief Get the name of the mutex
+  * @return Name in the lock statistics
+  */
+  const char *name() const { return name_; }
+
+  /**
+  * @brief Lock the mutex
+  */
+  void lock() {
+#ifndef AERIAL_AUTONOMY_NO_LOCK_PROFILING
+    if (LockProfiler::instance().enabled()) {
+      int64_t start = LockProfiler::now();
+      bool contended = !mutex_.try_lock();
+      int64_t acquired = start;
+      if (contended) {
+        mutex_.lock();
+        acquired = LockProfiler::now();
+      }
+      statistics()->recordWait(acquired - start, contended);
+      locked(acquired);
+      return;
+    }
+#endif
+    mutex_.lock();
+    locked(0);
+  }
+
+  /**
+  * @brief Try to lock the mutex without waiting
+  * @return True if locked
+  */
+  bool try_lock() {
+    if (!mutex_.try_lock()) {
+      return false;
+    }
+    int64_t acquired = 0;
+#ifndef AERIAL_AUTONOMY_NO_LOCK_PROFILING
+    if (LockProfiler::instance().enabled()) {
+      acquired = LockProfiler::now();
+      statistics()->recordWait(0, false);
+    }
+#endif
+    locked(acquired);
+    return true;
+  }
+
+  /**
+  * @brief Unlock the mutex
+  */
+  void unlock() {
+#ifndef AERIAL_AUTONOMY_NO_LOCK_PROFILING
+    if (--depth_ == 0 && hold_start_ != 0) {
+      statistics()->recordHold(LockProfiler::now() - hold_start_);
+    }
+#else
+    --depth_;
+#endif
+    mutex_.unlock();
+  }
+
+private:
+  /**
+  * @brief Get the statistics of the mutex name, looking them up once
+  * @return Statistics in the profiler
+  */
+  LockStatistics *statistics() {
+    LockStatistics *statistics = statistics_.load(std::memory_order_acquire);
+    if (!statistics) {
+      // Threads racing here get the same statistics from the profiler
+      statistics = LockProfiler::instance().statistics(name_);
+      statistics_.store(statistics, std::memory_order_release);
+    }
+    return statistics;
+  }
+
+  /**
+  * @brief Start the hold time of the outermost lock
+  * @param acquired Acquisition time, zero if not profiled
+  */
+  void locked(int64_t acquired) {
+    if (depth_++ == 0) {
+      hold_start_ = acquired;
+    }
+  }
+
+  MutexT mutex_;     ///< Wrapped mutex
+  const char *name_; ///< Name in the lock statistics
+  /**
+  * @brief Statistics of the mutex name, null until first profiled
+  */
+  std::atomic<LockStatistics *> statistics_;
+  unsigned depth_;     ///< Lock depth, guarded by the mutex
+  int64_t hold_start_; ///< Acquisition time of the outermost lock, or zero
+};
+
+/**
+ * @brief Profiled std::mutex
+ */
+using ProfiledMutex = BasicProfiledMutex<std::mutex>;
+
+/**
+ * @brief Profiled std::recursive_mutex
+ */
+using ProfiledRecursiveMutex = BasicProfiledMutex<std::recursive_mutex>;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Namespace for operating system real-time settings. Failures, e.g.
+ * due to missing privileges, are logged and reported by the return value
+ */
+namespace realtime {
+/**
+* @brief Lock current and future memory of the process in RAM to avoid page
+* faults. Needs CAP_IPC_LOCK or a large enough memlock limit
+* @return True if successful
+*/
+bool lockMemory();
+
+/**
+* @brief Touch stack memory of the calling thread so that it is mapped
+* before time critical work uses it. The number of bytes is clamped to the
+* free stack of the thread minus a safety margin
+* @param bytes Number of bytes of stack to touch
+*/
+void prefaultStack(size_t bytes);
+
+/**
+* @brief Run the calling thread with the SCHED_FIFO policy. Needs
+* CAP_SYS_NICE or a large enough rtprio limit
+* @param priority SCHED_FIFO priority, from 1 to 99
+* @return True if successful
+*/
+bool setThreadPriority(int priority);
+
+/**
+* @brief Restrict the calling thread to a set of CPUs
+* @param cpus Indices of the CPUs
+* @return True if successful
+*/
+bool setThreadAffinity(const std::vector<int> &cpus);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "aerial_autonomy/common/controller_replay.h"
+#include "aerial_autonomy/types/discrete_reference_trajectory_interpolate.h"
+#include "aerial_autonomy/types/mpc_inputs.h"
+#include "aerial_autonomy/types/particle_state.h"
+#include "aerial_autonomy/types/position_yaw.h"
+#include "aerial_autonomy/types/qrotor_backstepping_state.h"
+#include "aerial_autonomy/types/snap.h"
+#include "aerial_autonomy/types/velocity.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+/**
+ * @brief Reference trajectory reconstructed from the references logged at
+ * each control step. Holds the first and last reference outside of the logged
+ * time span so that predictive controllers can look past the end of the log.
+ */
+template <class StateT, class ControlT>
+struct RecordedReferenceTrajectory
+    : public DiscreteReferenceTrajectoryInterpolate<StateT, ControlT> {
+  /**
+  * @brief Gets the trajectory information at the specified time
+  * @param t Time
+  * @return Trajectory state and control
+  */
+  std::pair<StateT, ControlT> atTime(double t) const {
+    if (!this->ts.empty()) {
+      t = std::min(std::max(t, this->ts.front()), this->ts.back());
+    }
+    return DiscreteReferenceTrajectoryInterpolate<StateT, ControlT>::atTime(t);
+  }
+};
+
+/**
+ * @brief Reconstruct the controller inputs of recorded runs from the
+ * DataStream logs of a controller and its connector.
+ *
+ * The connector stream provides the sensor data and the controller stream
+ * provides the tracked reference and the computed controls. Data points of
+ * the two streams are paired by timestamp; data points without a partner
+ * within max_skew (e.g. because the streams were logged at different rates)
+ * are skipped. Sensor data times are relative to the first paired data point.
+ *
+ * Throws std::runtime_error if a stream cannot be read or lacks a column
+ */
+namespace replay_traces {
+/**
+* @brief Inputs of RPYTBasedReferenceControllerEigen
+*/
+using RPYTReferenceTrace =
+    ReplayTrace<std::tuple<double, double, Velocity, PositionYaw>,
+                ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd>>;
+/**
+* @brief Inputs of DDPQuadMPCController
+*/
+using QuadMPCTrace =
+    ReplayTrace<MPCInputs<Eigen::VectorXd>,
+                ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd>>;
+/**
+* @brief Inputs of QrotorBacksteppingController
+*/
+using QrotorBacksteppingTrace =
+    ReplayTrace<std::pair<double, QrotorBacksteppingState>,
+                std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>>>;
+
+/**
+* @brief Reconstruct a run of the rpyt reference controller from the
+* "rpyt_reference_connector" and "rpyt_reference_controller" streams.
+*
+* The reference position, yaw and velocity are the logged state plus the
+* logged errors. Reference yaw rate and attitude are not logged and are zero;
+* the reference thrust is hover thrust. Recorded controls are
+* (roll, pitch, yaw rate, thrust).
+*
+* @param log_directory Directory of the stream files
+* @param max_skew Maximum time between paired data points in seconds
+* @return Reconstructed controller inputs
+*/
+RPYTReferenceTrace
+rpytReferenceTrace(const boost::filesystem::path &log_directory,
+                   double max_skew = 5e-3);
+
+/**
+* @brief Reconstruct a run of the quad MPC controller from the
+* "quad_mpc_state_estimator" and "ddp_quad_mpc_controller" streams.
+*
+* The reference position, attitude and velocity are logged; the reference
+* rates are zero and the reference control is hover thrust. Recorded controls
+* are (thrust, roll, pitch, yaw rate).
+*
+* @param log_directory Directory of the stream files
+* @param max_skew Maximum time between paired data points in seconds
+* @return Reconstructed controller inputs
+*/
+QuadMPCTrace quadMPCTrace(const boost::filesystem::path &log_directory,
+                          double max_skew = 5e-3);
+
+/**
+* @brief Reconstruct a run of the backstepping controller from the
+* "qrotor_backstepping_controller_connector" and
+* "qrotor_backstepping_controller" streams.
+*
+* Angular velocity and thrust rate are not logged and are approximated by
+* finite differences of the logged attitude and thrust; reference
+* acceleration and jerk are finite differences of the reference velocity.
+* The controller output (torque, thrust acceleration) is not logged, so the
+* trace has no recorded controls.
+*
+* @param log_directory Directory of the stream files
+* @param max_skew Maximum time between paired data points in seconds
+* @return Reconstructed controller inputs
+*/
+QrotorBacksteppingTrace
+qrotorBacksteppingTrace(const boost::filesystem::path &log_directory,
+                        double max_skew = 5e-3);
+}
@@ -8,6 +8,10 @@
 #include <aerial_autonomy/types/controller_groups.h>
 // Base Robot system
 #include <aerial_autonomy/robot_systems/base_robot_system.h>
+// Timer statistics
+#include <aerial_autonomy/common/timer_executor_pool.h>
+// Event latency statistics
+#include <aerial_autonomy/common/event_dispatcher.h>
 
 /**
  * @brief Responsible for publishing system status message
@@ -20,14 +24,17 @@ public:
    * @param nh NodeHandle to use for publishing system status
    * @param robot_system RobotSystem whose status will be published
    * @param logic_state_machine State machine whose status will be published
+   * @param timer_executors Executors whose timer statistics are published.
+   * Not published if null
    */
-  SystemStatusPublisher(ros::NodeHandle &nh,
-                        const BaseRobotSystem &robot_system,
-                        LogicStateMachineT &logic_state_machine)
+  SystemStatusPublisher(
+      ros::NodeHandle &nh, const BaseRobotSystem &robot_system,
+      LogicStateMachineT &logic_state_machine,
+      std::shared_ptr<TimerExecutorPool> timer_executors = nullptr)
       : nh_(nh),
         system_status_pub_(nh.advertise<std_msgs::String>("system_status", 1)),
-        robot_system_(robot_system), logic_state_machine_(logic_state_machine) {
-  }
+        robot_system_(robot_system), logic_state_machine_(logic_state_machine),
+        timer_executors_(timer_executors) {}
 
   /**
   * @brief Publish system status and state machine status
@@ -79,11 +86,76 @@ public:
     }
     // Add table to division
     division_writer.addText(logic_state_machine_table.getTableString());
+    if (timer_executors_) {
+      division_writer.addText(
+          timerStatisticsTable(timer_executors_->statistics()));
+    }
+    division_writer.addText(
+        eventLatencyTable(logic_state_machine_.eventLatencyStatistics()));
     std_msgs::String status;
     status.data = division_writer.getDivisionText();
     system_status_pub_.publish(status);
   }
 
+  /**
+  * @brief Create a table of timer statistics. Times are in milliseconds
+  * @param statistics Statistics of each timer
+  * @return Html table
+  */
+  static std::string timerStatisticsTable(
+      const std::vector<TimerStatistics::Summary> &statistics) {
+    HtmlTableWriter table(90);
+    table.beginRow();
+    table.addHeader("Timer Statistics (ms)", Colors::blue, 9);
+    table.beginRow();
+    for (std::string header : {"Timer", "Ticks", "Overruns", "Jitter p50",
+                               "Jitter p99", "Jitter max", "Exec p50",
+                               "Exec p99", "Exec max"}) {
+      table.addHeader(header);
+    }
+    for (const auto &timer : statistics) {
+      table.beginRow();
+      table.addCell(timer.name);
+      table.addCell(timer.ticks);
+      table.addCell(timer.overruns, "",
+                    timer.overruns > 0 ? Colors::yellow : Colors::white);
+      table.addCell(timer.jitter_p50 * 1e3);
+      table.addCell(timer.jitter_p99 * 1e3);
+      table.addCell(timer.jitter_max * 1e3);
+      table.addCell(timer.execution_p50 * 1e3);
+      table.addCell(timer.execution_p99 * 1e3);
+      table.addCell(timer.execution_max * 1e3);
+    }
+    return table.getTableString();
+  }
+
+  /**
+  * @brief Create a table of the latencies of posted state machine events.
+  * Times are in milliseconds
+  * @param statistics Statistics of each posted event type
+  * @return Html table
+  */
+  static std::string
+  eventLatencyTable(const std::vector<EventDispatcher::Summary> &statistics) {
+    HtmlTableWriter table(90);
+    table.beginRow();
+    table.addHeader("Event Latency (ms)", Colors::blue, 5);
+    table.beginRow();
+    for (std::string header :
+         {"Event", "Count", "Latency p50", "Latency p99", "Latency max"}) {
+      table.addHeader(header);
+    }
+    for (const auto &event : statistics) {
+      table.beginRow();
+      table.addCell(event.name);
+      table.addCell(event.count);
+      table.addCell(event.latency_p50 * 1e3);
+      table.addCell(event.latency_p99 * 1e3);
+      table.addCell(event.latency_max * 1e3);
+    }
+    return table.getTableString();
+  }
+
 private:
   ros::NodeHandle &nh_;              ///< NodeHandle used for publishing
   ros::Publisher system_status_pub_; ///< publishes status messages
@@ -91,4 +163,6 @@ private:
       &robot_system_; ///< system whose status we are publishing
   const LogicStateMachineT
       &logic_state_machine_; ///< state machine whose status we are publishing
+  std::shared_ptr<TimerExecutorPool>
+      timer_executors_; ///< executors whose timer statistics we are publishing
 };
@@ -1,11 +1,20 @@
 #pragma once
 
 #include <boost/msm/back/state_machine.hpp>
-#include <boost/thread/recursive_mutex.hpp>
 // Type index
 #include <typeindex>
 // Internal transition event
 #include <aerial_autonomy/types/internal_transition_event.h>
+// Abort event
+#include <aerial_autonomy/uav_basic_events.h>
+// Flight recorder
+#include <aerial_autonomy/log/log.h>
+// Trace spans
+#include <aerial_autonomy/log/trace.h>
+// Event queue
+#include <aerial_autonomy/common/event_dispatcher.h>
+// Profiled mutex
+#include <aerial_autonomy/common/profiled_mutex.h>
 
 /**
 * @brief Boost namespace
@@ -30,11 +39,20 @@ class thread_safe_state_machine : public state_machine<A0, A1, A2, A3, A4> {
   /**
    * @brief Mutex to synchronize process event functions
    */
-  mutable boost::recursive_mutex process_event_mutex_;
+  mutable ProfiledRecursiveMutex process_event_mutex_{"state_machine"};
   /**
    * @brief  Last event processed by the state machine
    */
   std::type_index last_processed_event_index;
+  /**
+   * @brief Log whose flight recorder is dumped when an Abort event is
+   * processed
+   */
+  Log *fault_log_ = &Log::current();
+  /**
+   * @brief Processes posted events on a single dispatch thread
+   */
+  EventDispatcher event_dispatcher_{"state_machine_dispatch"};
 
 public:
   thread_safe_state_machine<A0, A1, A2, A3, A4>()
@@ -124,21 +142,66 @@ public:
   * @return Enum specifying whether the event is handled, deferred etc.
   */
   template <class Event> execute_return process_event(Event const &evt) {
-    recursive_mutex::scoped_lock lock(process_event_mutex_);
+    // Includes the time spent waiting for other threads processing events
+    TRACE_SPAN("process_event");
+    std::lock_guard<ProfiledRecursiveMutex> lock(process_event_mutex_);
     // Store the event if it is not internal transition event
     std::type_index event_index = typeid(Event);
     if (event_index != typeid(InternalTransitionEvent))
       last_processed_event_index = event_index;
+    if (event_index == typeid(uav_basic_events::Abort))
+      fault_log_->requestRecorderDump("Abort event");
     return this->process_event_internal(evt, true);
   }
 
+  /**
+  * @brief Queue an event for the dispatch thread and return without waiting
+  * for it to be processed. Posting never blocks on a running event, so
+  * callbacks of ROS subscribers and timers stay short. Events are processed
+  * in the order they are posted
+  *
+  * @tparam Event The event type that is posted
+  * @param evt Instance of event type to process
+  */
+  template <class Event> void postEvent(Event const &evt) {
+    event_dispatcher_.post(typeid(Event).name(),
+                           [this, evt] { this->process_event(evt); });
+  }
+
+  /**
+  * @brief Queue a function for the dispatch thread, e.g. one triggering an
+  * event by name. The function runs between posted events
+  *
+  * @param name Name of the function in the event latency statistics
+  * @param function Function to run
+  */
+  void post(const std::string &name, std::function<void()> function) {
+    event_dispatcher_.post(name, function);
+  }
+
+  /**
+  * @brief Stop processing posted events. Must be called before destroying
+  * the objects used by posted functions
+  */
+  void stopDispatch() { event_dispatcher_.stop(); }
+
+  /**
+  * @brief Latency from posting to the end of processing for each posted
+  * event type
+  *
+  * @return Statistics of the posted events
+  */
+  std::vector<EventDispatcher::Summary> eventLatencyStatistics() const {
+    return event_dispatcher_.statistics();
+  }
+
   /**
    * @brief Returns the type index of last processed event after locking
    *
    * @return type index of last processed event
    */
   std::type_index lastProcessedEventIndex() const {
-    recursive_mutex::scoped_lock lock(process_event_mutex_);
+    std::lock_guard<ProfiledRecursiveMutex> lock(process_event_mutex_);
     return last_processed_event_index;
   }
 };
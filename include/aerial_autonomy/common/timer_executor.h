@@ -0,0 +1,261 @@
+#pragma once
+
+#include <aerial_autonomy/common/latency_histogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Priority of periodic work run by a TimerExecutor
+ */
+enum class TimerPriority {
+  Low,    ///< Status and visualization work
+  Normal, ///< Default
+  High    ///< Control loops
+};
+
+/**
+ * @brief Timing statistics of a periodic function
+ *
+ * Start jitter is the delay between the deadline and the start of a call.
+ * A call overruns when it ends after the deadline of the next call.
+ */
+class TimerStatistics {
+public:
+  /**
+  * @brief Percentiles of the statistics in seconds
+  */
+  struct Summary {
+    std::string name;     ///< Name of the timer
+    uint64_t ticks;       ///< Number of calls
+    uint64_t overruns;    ///< Calls that ended after the next deadline
+    double jitter_p50;    ///< Median start jitter
+    double jitter_p99;    ///< 99th percentile of the start jitter
+    double jitter_max;    ///< Largest start jitter
+    double execution_p50; ///< Median execution time
+    double execution_p99; ///< 99th percentile of the execution time
+    double execution_max; ///< Largest execution time
+  };
+
+  /**
+  * @brief Constructor
+  * @param name Name of the timer
+  */
+  explicit TimerStatistics(std::string name);
+
+  /**
+  * @brief Record a call. Lock-free
+  * @param jitter Start jitter in nanoseconds
+  * @param execution_time Execution time in nanoseconds
+  * @param overrun True if the call ended after the next deadline
+  */
+  void record(int64_t jitter, int64_t execution_time, bool overrun);
+
+  /**
+  * @brief Compute the percentiles of the recorded calls
+  * @return Statistics summary
+  */
+  Summary summary() const;
+
+private:
+  const std::string name_;          ///< Name of the timer
+  LatencyHistogram jitter_;         ///< Start jitter histogram
+  LatencyHistogram execution_time_; ///< Execution time histogram
+  std::atomic<uint64_t> overruns_;  ///< Number of overrun calls
+};
+
+/**
+ * @brief Runs periodic functions on a small pool of worker threads.
+ *
+ * Deadlines are kept in a hashed timer wheel. One idle worker sleeps until the
+ * next deadline while the others wait for work, so timers do not need a
+ * thread each. Due functions are dispatched by priority and then by deadline.
+ * Work cannot be preempted once started; instead, Low priority work never
+ * occupies the last free worker of a pool with several workers, so control
+ * loops find a worker even while status or visualization work is running.
+ * A function is never run concurrently with itself: its next deadline is one
+ * period after the previous one, or now if it overran.
+ */
+class TimerExecutor {
+public:
+  /**
+  * @brief Identifies a scheduled function
+  */
+  using TaskId = uint64_t;
+
+  /**
+  * @brief Constructor starts the workers
+  * @param worker_count Number of worker threads, at least one
+  * @param name Name of the worker threads in traces
+  * @param resolution Time span of a timer wheel slot
+  * @param thread_setup Function called by each worker thread before it runs
+  * any work, e.g. to set its scheduling policy
+  */
+  TimerExecutor(size_t worker_count, std::string name = "timer_executor",
+                std::chrono::duration<double> resolution =
+                    std::chrono::microseconds(100),
+                std::function<void()> thread_setup = nullptr);
+
+  /**
+  * @brief Destructor stops the workers after their current work
+  */
+  ~TimerExecutor();
+
+  TimerExecutor(const TimerExecutor &) = delete;
+  TimerExecutor &operator=(const TimerExecutor &) = delete;
+
+  /**
+  * @brief Run a function periodically, starting now
+  * @param function Function to call
+  * @param period Time between the starts of two calls
+  * @param priority Dispatch priority
+  * @param trace_name Name of the calls in traces. Must outlive the executor
+  * @param statistics Records the timing of the calls. A new one named after
+  * trace_name is created if null
+  * @return Id used to cancel the function
+  */
+  TaskId schedule(std::function<void()> function,
+                  std::chrono::duration<double> period,
+                  TimerPriority priority = TimerPriority::Normal,
+                  const char *trace_name = "timer_task",
+                  std::shared_ptr<TimerStatistics> statistics = nullptr);
+
+  /**
+  * @brief Stop calling a function. Waits for a running call to return unless
+  * called from that call. Unknown ids are ignored
+  * @param id Id returned by schedule
+  */
+  void cancel(TaskId id);
+
+  /**
+  * @brief Run a function early, e.g. when new input data arrives. Its next
+  * call is moved to now, but not earlier than a minimum interval after the
+  * start of its previous call. If the function is running, the call follows
+  * the running one. Later calls are one period after the triggered one, so
+  * the period acts as a timeout when triggers stop. Unknown ids are ignored
+  * @param id Id returned by schedule
+  * @param min_interval Minimum time between the starts of two calls
+  */
+  void trigger(TaskId id, std::chrono::duration<double> min_interval);
+
+  /**
+  * @brief Change the period of a function without stopping it. The next call
+  * is one new period after the start of the previous call, or now if that
+  * has passed. Does not wait for a running call, so it can be called from
+  * the function itself. Unknown ids are ignored
+  * @param id Id returned by schedule
+  * @param period New time between the starts of two calls
+  */
+  void setPeriod(TaskId id, std::chrono::duration<double> period);
+
+  /**
+  * @brief Get the timing statistics of the scheduled functions
+  * @return Statistics of each scheduled function in the order of scheduling
+  */
+  std::vector<TimerStatistics::Summary> statistics();
+
+  /**
+  * @brief Getter for the number of workers
+  * @return Number of worker threads
+  */
+  size_t workerCount() const;
+
+private:
+  /**
+  * @brief Clock used for deadlines
+  */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+  * @brief A scheduled function
+  */
+  struct Task {
+    TaskId id;                      ///< Id of the task
+    std::function<void()> function; ///< Function to call
+    Clock::duration period;         ///< Time between calls
+    TimerPriority priority;         ///< Dispatch priority
+    const char *trace_name;         ///< Name in traces
+    Clock::time_point deadline;     ///< Start time of the next call
+    uint64_t expiry_tick;           ///< Wheel tick of the deadline
+    Clock::time_point last_start;   ///< Start time of the previous call
+    bool running;           ///< True while a worker calls the function
+    bool cancelled;         ///< True once cancelled
+    bool trigger_pending;   ///< True if triggered while running
+    Clock::duration trigger_min_interval; ///< Of the pending trigger
+    std::thread::id worker; ///< Worker calling the function
+    std::shared_ptr<TimerStatistics> statistics; ///< Timing of the calls
+  };
+
+  /**
+  * @brief Number of slots of the timer wheel
+  */
+  static const size_t kWheelSlots = 256;
+
+  /**
+  * @brief Worker loop
+  * @param index Index of the worker
+  */
+  void workerLoop(size_t index);
+
+  /**
+  * @brief Put a task into the wheel or, if it is due, into the ready list
+  * @param task Task with an updated deadline
+  * @param now Current time
+  */
+  void insert(const std::shared_ptr<Task> &task, Clock::time_point now);
+
+  /**
+  * @brief Move the tasks due up to a time from the wheel to the ready list
+  * @param now Current time
+  */
+  void advance(Clock::time_point now);
+
+  /**
+  * @brief Take the ready task to run next
+  * @return Task or null if no ready task may run now
+  */
+  std::shared_ptr<Task> popReady();
+
+  /**
+  * @brief Find the earliest tick of the tasks in the wheel
+  * @param tick Output, earliest tick
+  * @return True if the wheel is not empty
+  */
+  bool nextExpiry(uint64_t &tick) const;
+
+  /**
+  * @brief Convert a time to a wheel tick, rounding up
+  */
+  uint64_t toTick(Clock::time_point time) const;
+
+  const size_t worker_count_;        ///< Number of workers
+  const std::string name_;           ///< Name of the workers
+  const Clock::duration resolution_; ///< Time span of a wheel slot
+  const Clock::time_point origin_;   ///< Time of tick zero
+  const std::function<void()> thread_setup_; ///< Called by each worker
+  uint64_t current_tick_;            ///< Last tick moved to the ready list
+  TaskId next_id_;                   ///< Id of the next scheduled task
+  /**
+  * @brief Scheduled tasks by id
+  */
+  std::unordered_map<TaskId, std::shared_ptr<Task>> tasks_;
+  std::vector<std::vector<std::shared_ptr<Task>>> wheel_; ///< Timer wheel
+  std::vector<std::shared_ptr<Task>> ready_; ///< Due tasks to dispatch
+  size_t busy_;          ///< Number of workers calling a function
+  bool timer_waiter_;    ///< True while a worker waits for the next deadline
+  uint64_t waiter_tick_; ///< Tick the waiting worker sleeps until
+  bool stopping_;        ///< True when the workers should exit
+  std::mutex mutex_;     ///< Guards the tasks, wheel and ready list
+  std::condition_variable work_cv_;  ///< Wakes workers
+  std::condition_variable done_cv_;  ///< Signals the end of a call
+  std::vector<std::thread> workers_; ///< Worker threads
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "realtime_config.pb.h"
+#include <aerial_autonomy/common/timer_executor.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Timer executors of a system handler.
+ *
+ * Timers share one executor, except the timers listed in the real-time
+ * config: each of them gets a dedicated single worker whose thread is
+ * configured with the SCHED_FIFO priority and CPU affinity of the timer.
+ * Memory locking and stack prefaulting are applied on construction.
+ * Settings that cannot be applied, e.g. due to missing privileges, are
+ * logged and the timers keep running without them.
+ */
+class TimerExecutorPool {
+public:
+  /**
+  * @brief Constructor starts the executors
+  * @param worker_count Number of workers of the shared executor
+  * @param config Real-time settings
+  */
+  TimerExecutorPool(size_t worker_count,
+                    const RealtimeConfig &config = RealtimeConfig());
+
+  /**
+  * @brief Get the executor that should run a timer
+  * @param timer_name Name of the timer
+  * @return Dedicated executor of the timer if it has real-time settings,
+  * otherwise the shared executor
+  */
+  std::shared_ptr<TimerExecutor> executor(const std::string &timer_name) const;
+
+  /**
+  * @brief Get the timing statistics of the timers of all executors
+  * @return Statistics of the shared executor followed by the dedicated ones
+  */
+  std::vector<TimerStatistics::Summary> statistics() const;
+
+  /**
+  * @brief Check whether the memory of the process is locked
+  * @return True if locking was configured and succeeded
+  */
+  bool memoryLocked() const;
+
+private:
+  bool memory_locked_; ///< True if the memory was locked
+  std::shared_ptr<TimerExecutor> shared_executor_; ///< Runs most timers
+  /**
+  * @brief Dedicated executors by timer name, in the order of the config
+  */
+  std::vector<std::pair<std::string, std::shared_ptr<TimerExecutor>>>
+      realtime_executors_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "aerial_autonomy/controller_connectors/base_controller_connector.h"
 #include "aerial_autonomy/controllers/arm_sine_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include <arm_parsers/arm_parser.h>
 
 #include <tf/tf.h>
@@ -64,4 +65,8 @@ private:
   * @brief private reference to arm sine controller
   */
   ArmSineController &private_ref_controller_;
+  /**
+  * @brief Data stream for joint state logs
+  */
+  StreamHandle log_stream_;
 };
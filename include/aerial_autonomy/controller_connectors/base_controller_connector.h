@@ -2,9 +2,13 @@
 #include <aerial_autonomy/common/atomic.h>
 #include <aerial_autonomy/common/controller_status.h>
 #include <aerial_autonomy/controllers/base_controller.h>
+#include <aerial_autonomy/log/log.h>
+#include <aerial_autonomy/log/trace.h>
 #include <aerial_autonomy/types/controller_groups.h>
 #include <glog/logging.h>
 
+#include <chrono>
+
 /**
 * @brief Base for ControllerConnector class
 */
@@ -59,6 +63,17 @@ public:
   */
   virtual ControllerGroup getControllerGroup() const = 0;
 
+  /**
+  * @brief Preferred time between two runs of the connector. The timer of the
+  * controller group switches to this period while the connector is active
+  *
+  * @return Period of the connector, or zero to use the period of the
+  * controller group timer
+  */
+  virtual std::chrono::duration<double> getExecutionPeriod() const {
+    return std::chrono::duration<double>(0);
+  }
+
   /**
   * @brief Destructor to get polymorphism
   */
@@ -93,7 +108,9 @@ public:
       Controller<SensorDataType, GoalType, ControlType> &controller,
       ControllerGroup controller_group)
       : AbstractControllerConnector(), controller_group_(controller_group),
-        controller_(controller), status_(ControllerStatus::NotEngaged) {}
+        controller_(controller),
+        status_(ControllerStatus::NotEngaged, LockName("controller_status")),
+        log_(Log::current()), execution_period_(0) {}
 
   /**
    * @brief Extracts sensor data, run controller and send data back to hardware
@@ -103,23 +120,41 @@ public:
     // run the controller
     // send the data back to hardware manager
     // Do not run the controller if connector is not engaged
-    if (status_ == ControllerStatus::NotEngaged) {
+    ControllerStatus previous_status = status_;
+    if (previous_status == ControllerStatus::NotEngaged) {
       return;
     }
+    TRACE_SPAN("connector_run");
     SensorDataType sensor_data;
     ControlType control;
-    if (!extractSensorData(sensor_data)) {
-      status_ = ControllerStatus(ControllerStatus::Critical,
-                                 "Cannot extract sensor data");
+    bool extracted;
+    {
+      TRACE_SPAN("extract_sensor_data");
+      extracted = extractSensorData(sensor_data);
+    }
+    if (!extracted) {
+      updateStatus(previous_status,
+                   ControllerStatus(ControllerStatus::Critical,
+                                    "Cannot extract sensor data"));
       return;
     }
-    if (!controller_.run(sensor_data, control)) {
-      status_ =
-          ControllerStatus(ControllerStatus::Critical, "Cannot run controller");
+    bool ran;
+    {
+      TRACE_SPAN("controller_run");
+      ran = controller_.run(sensor_data, control);
+    }
+    if (!ran) {
+      updateStatus(previous_status,
+                   ControllerStatus(ControllerStatus::Critical,
+                                    "Cannot run controller"));
       return;
     }
-    sendControllerCommands(control);
-    status_ = controller_.isConverged(sensor_data);
+    {
+      TRACE_SPAN("send_controller_commands");
+      sendControllerCommands(control);
+    }
+    TRACE_SPAN("controller_is_converged");
+    updateStatus(previous_status, controller_.isConverged(sensor_data));
   }
   /**
    * @brief Set the goal for controller
@@ -144,6 +179,27 @@ public:
   */
   ControllerGroup getControllerGroup() const { return controller_group_; }
 
+  /**
+  * @brief Preferred time between two runs of the connector
+  *
+  * @return Period of the connector, or zero to use the period of the
+  * controller group timer
+  */
+  std::chrono::duration<double> getExecutionPeriod() const {
+    return execution_period_;
+  }
+
+  /**
+  * @brief Set the preferred time between two runs of the connector. Takes
+  * effect when the connector is activated
+  *
+  * @param period Period of the connector, or zero to use the period of the
+  * controller group timer
+  */
+  void setExecutionPeriod(std::chrono::duration<double> period) {
+    execution_period_ = period;
+  }
+
   /**
   * @brief Provide the status of the controller
   *
@@ -185,6 +241,22 @@ protected:
   ControllerGroup controller_group_;
 
 private:
+  /**
+   * @brief Set the status after a run. Dumps the flight recorder of the log
+   * when the controller becomes critical
+   *
+   * @param previous_status Status before the run
+   * @param status New status
+   */
+  void updateStatus(const ControllerStatus &previous_status,
+                    ControllerStatus status) {
+    if (status == ControllerStatus::Critical &&
+        !(previous_status == ControllerStatus::Critical)) {
+      log_.requestRecorderDump("Controller critical");
+    }
+    status_ = status;
+  }
+
   /**
    * @brief  controller class used to perform step function
    */
@@ -192,5 +264,14 @@ private:
   /**
   * @brief Status of the controller
   */
-  Atomic<ControllerStatus> status_;
+  Atomic<ControllerStatus, atomic_policy::TripleBuffer> status_;
+  /**
+  * @brief Log whose flight recorder is dumped when the controller becomes
+  * critical
+  */
+  Log &log_;
+  /**
+  * @brief Preferred time between two runs, zero for the group timer period
+  */
+  std::chrono::duration<double> execution_period_;
 };
@@ -103,6 +103,7 @@ protected:
     private_controller.resetControls();
     clearCommandBuffers();
     rpydot_filter_.reset();
+    odom_sequence_ = 0;
     int iters = private_controller.getMaxIters();
     private_controller.setMaxIters(100);
     run();
@@ -125,4 +126,11 @@ protected:
   boost::mutex
       copy_mutex_; ///< Mutex for copying states and reference trajectories
   MPCConnectorConfig config_; ///< Config for mpc connector
+  /**
+  * @brief Sequence number of the odometry sample the cached state is from
+  */
+  uint64_t odom_sequence_;
+  Eigen::Vector3d odom_position_; ///< Position from the odometry sample
+  Eigen::Vector3d odom_rpy_;      ///< Euler angles from the odometry sample
+  Eigen::Vector3d odom_velocity_; ///< Velocity from the odometry sample
 };
@@ -20,16 +20,20 @@ public:
    * @param camera_transform Camera transform in UAV frame
    * @param tracking_offset_transform Additional transform to apply to tracked
    * object before it is roll/pitch compensated
+   * @param tracker_stream_id ID of the data stream to log tracker info to
    */
   BaseRelativePoseVisualServoingConnector(
       BaseTracker &tracker, parsernode::Parser &drone_hardware,
-      tf::Transform camera_transform, tf::Transform tracking_offset_transform)
+      tf::Transform camera_transform, tf::Transform tracking_offset_transform,
+      std::string tracker_stream_id)
       : drone_hardware_(drone_hardware), tracker_(tracker),
         camera_transform_(camera_transform),
         // \todo Matt This will become unwieldy when we are tracking multiple
         // objects, each with different offsets.  This assumes the offset is the
         // same for all tracked objects
-        tracking_offset_transform_(tracking_offset_transform) {}
+        tracking_offset_transform_(tracking_offset_transform),
+        tracker_log_stream_(
+            Log::current().registerStream(tracker_stream_id)) {}
   /**
    * @brief Destructor
    */
@@ -65,12 +69,11 @@ protected:
    * @brief logTrackerData
    *
    * Log tracker info to stream
-   * @param stream_name name of logging stream
    * @param tracking_pose Tracker pose
    * @param object_pose_cam Object pose in camera frame
    * @param quad_data Quadrotor sensor data
    */
-  void logTrackerData(std::string stream_name, tf::Transform tracking_pose,
+  void logTrackerData(tf::Transform tracking_pose,
                       tf::Transform object_pose_cam,
                       parsernode::common::quaddata &quad_data);
 
@@ -78,9 +81,8 @@ protected:
    * @brief logTrackerHeader
    *
    * Log tracker header to stream
-   * @param stream_name name of logging stream
    */
-  void logTrackerHeader(std::string stream_name);
+  void logTrackerHeader();
 
   /**
   * @brief Quad hardware to send commands
@@ -99,4 +101,8 @@ protected:
   * roll/pitch compensation
   */
   tf::Transform tracking_offset_transform_;
+  /**
+  * @brief Data stream for tracker info
+  */
+  StreamHandle tracker_log_stream_;
 };
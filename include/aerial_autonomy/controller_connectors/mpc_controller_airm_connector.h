@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controller_connectors/base_mpc_controller_quad_connector.h"
+#include "aerial_autonomy/log/log.h"
 #include <Eigen/Dense>
 #include <arm_parsers/arm_parser.h>
 #include <tf/tf.h>
@@ -79,4 +80,5 @@ private:
   static constexpr int state_size_ = 21;
   std::chrono::time_point<std::chrono::high_resolution_clock>
       previous_measurement_time_; ///< For finding time diff
+  StreamHandle log_stream_;       ///< Data stream for state estimates
 };
@@ -1,4 +1,5 @@
 #pragma once
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/controller_connectors/abstract_constraint_generator.h"
 #include "aerial_autonomy/controller_connectors/base_controller_connector.h"
 #include "aerial_autonomy/controllers/mpc_controller.h"
@@ -43,7 +44,7 @@ public:
       AbstractConstraintGeneratorPtr constraint_generator = nullptr)
       : BaseConnector(controller, group),
         constraint_generator_(constraint_generator),
-        t_init_(std::chrono::high_resolution_clock::now()),
+        t_init_(Clock::instance().now()),
         mpc_controller_(controller) {}
 
   /**
@@ -68,8 +69,7 @@ public:
     bool estimation_status = estimateStateAndParameters(
         mpc_inputs.initial_state, mpc_inputs.parameters);
     mpc_inputs.time_since_goal =
-        std::chrono::duration<double>(
-            std::chrono::high_resolution_clock::now() - t_init_)
+        std::chrono::duration<double>(Clock::instance().now() - t_init_)
             .count();
     bool return_status = estimation_status;
     if (constraint_generator_) {
@@ -82,7 +82,7 @@ public:
   /**
    * @brief Save current time
    */
-  void initialize() { t_init_ = std::chrono::high_resolution_clock::now(); }
+  void initialize() { t_init_ = Clock::instance().now(); }
 
   /**
   * @brief Get the MPC planned trajectory
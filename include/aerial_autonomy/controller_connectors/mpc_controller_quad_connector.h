@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controller_connectors/base_mpc_controller_quad_connector.h"
+#include "aerial_autonomy/log/log.h"
 #include <Eigen/Dense>
 #include <tf/tf.h>
 
@@ -45,4 +46,5 @@ public:
 
 private:
   static constexpr int state_size_ = 15; ///< State size
+  StreamHandle log_stream_;              ///< Data stream for state estimates
 };
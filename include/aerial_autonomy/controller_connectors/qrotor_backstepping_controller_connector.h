@@ -1,10 +1,12 @@
 #pragma once
 
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/common/conversions.h"
 #include "aerial_autonomy/common/math.h"
 #include "aerial_autonomy/controller_connectors/base_controller_connector.h"
 #include "aerial_autonomy/controllers/qrotor_backstepping_controller.h"
 #include "aerial_autonomy/estimators/thrust_gain_estimator.h"
+#include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/sensors/base_sensor.h"
 #include "aerial_autonomy/types/roll_pitch_yawrate_thrust.h"
 #include "qrotor_backstepping_controller_config.pb.h"
@@ -41,8 +43,10 @@ public:
       : ControllerConnector(controller, ControllerGroup::UAV),
         drone_hardware_(drone_hardware),
         thrust_gain_estimator_(thrust_gain_estimator), config_(config),
-        t_0_(std::chrono::high_resolution_clock::now()), m_(config_.mass()),
-        g_(config_.acc_gravity()), pose_sensor_(pose_sensor) {
+        t_0_(Clock::instance().now()), m_(config_.mass()),
+        g_(config_.acc_gravity()), pose_sensor_(pose_sensor),
+        log_stream_(Log::current().registerStream(
+            "qrotor_backstepping_controller_connector")) {
     DATA_HEADER("qrotor_backstepping_controller_connector") << "roll"
                                                             << "pitch"
                                                             << "yaw"
@@ -160,4 +164,8 @@ private:
   * @brief Variable to store upper bound on control
   */
   Eigen::Vector4d ub_;
+  /**
+  * @brief Data stream for connector logs
+  */
+  StreamHandle log_stream_;
 };
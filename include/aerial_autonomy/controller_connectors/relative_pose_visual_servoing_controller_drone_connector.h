@@ -34,9 +34,10 @@ public:
       tf::Transform camera_transform,
       tf::Transform tracking_offset_transform = tf::Transform::getIdentity())
       : ControllerConnector(controller, ControllerGroup::UAV),
-        BaseRelativePoseVisualServoingConnector(tracker, drone_hardware,
-                                                camera_transform,
-                                                tracking_offset_transform) {}
+        BaseRelativePoseVisualServoingConnector(
+            tracker, drone_hardware, camera_transform,
+            tracking_offset_transform,
+            "relative_pose_visual_servoing_controller_drone_connector") {}
   /**
    * @brief Destructor
    */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/controller_connectors/base_controller_connector.h"
 #include "aerial_autonomy/controllers/rpyt_based_reference_controller.h"
 #include "aerial_autonomy/estimators/thrust_gain_estimator.h"
@@ -48,9 +49,12 @@ public:
       : BaseClass(controller, ControllerGroup::UAV),
         drone_hardware_(drone_hardware), odom_sensor_(odom_sensor),
         thrust_gain_estimator_(thrust_gain_estimator),
-        t_init_(std::chrono::high_resolution_clock::now()), time_since_init_(0),
+        t_init_(Clock::instance().now()), time_since_init_(0),
         use_perfect_time_diff_(config.use_perfect_time_diff()),
-        perfect_time_diff_(config.perfect_time_diff()) {
+        perfect_time_diff_(config.perfect_time_diff()), odom_sequence_(0),
+        odom_sensor_r_(0), odom_sensor_p_(0), odom_sensor_y_(0),
+        log_stream_(
+            Log::current().registerStream("rpyt_reference_connector")) {
     DATA_HEADER("rpyt_reference_connector") << "Thrust_gain"
                                             << "x"
                                             << "y"
@@ -123,6 +127,26 @@ private:
    * @brief Perfect time diff to use for finite diff
    */
   const double perfect_time_diff_;
+  /**
+   * @brief Sequence number of the odometry sample the cached state is from
+   */
+  uint64_t odom_sequence_;
+  /**
+   * @brief Position and yaw from the odometry sample
+   */
+  PositionYaw odom_position_yaw_;
+  /**
+   * @brief Velocity from the odometry sample
+   */
+  Velocity odom_velocity_;
+  /**
+   * @brief Euler angles from the odometry sample
+   */
+  double odom_sensor_r_, odom_sensor_p_, odom_sensor_y_;
+  /**
+   * @brief Data stream for connector logs
+   */
+  StreamHandle log_stream_;
 };
 
 template <class StateT, class ControlT>
@@ -138,14 +162,23 @@ bool RPYTBasedReferenceConnector<StateT, ControlT>::extractSensorData(
       LOG(WARNING) << "Sensor invalid";
       return false;
     }
-    auto quad_pose_velocity_pair = odom_sensor_->getSensorData();
-    conversions::tfToPositionYaw(position_yaw, quad_pose_velocity_pair.first);
-    quad_pose_velocity_pair.first.getBasis().getRPY(sensor_r, sensor_p,
-                                                    sensor_y);
-    // Get Velocity
-    tf::Vector3 &sensor_velocity = quad_pose_velocity_pair.second;
-    velocity =
-        Velocity(sensor_velocity.x(), sensor_velocity.y(), sensor_velocity.z());
+    auto sample = odom_sensor_->getSample();
+    // Convert the pose only once per sample
+    if (sample.sequence == 0 || sample.sequence != odom_sequence_) {
+      odom_sequence_ = sample.sequence;
+      conversions::tfToPositionYaw(odom_position_yaw_, sample.data.first);
+      sample.data.first.getBasis().getRPY(odom_sensor_r_, odom_sensor_p_,
+                                          odom_sensor_y_);
+      // Get Velocity
+      tf::Vector3 &sensor_velocity = sample.data.second;
+      odom_velocity_ = Velocity(sensor_velocity.x(), sensor_velocity.y(),
+                                sensor_velocity.z());
+    }
+    position_yaw = odom_position_yaw_;
+    velocity = odom_velocity_;
+    sensor_r = odom_sensor_r_;
+    sensor_p = odom_sensor_p_;
+    sensor_y = odom_sensor_y_;
   } else {
     position_yaw = PositionYaw(data.localpos.x, data.localpos.y,
                                data.localpos.z, data.rpydata.z);
@@ -154,9 +187,9 @@ bool RPYTBasedReferenceConnector<StateT, ControlT>::extractSensorData(
   if (use_perfect_time_diff_) {
     time_since_init_ += perfect_time_diff_;
   } else {
-    time_since_init_ = std::chrono::duration<double>(
-                           std::chrono::high_resolution_clock::now() - t_init_)
-                           .count();
+    time_since_init_ =
+        std::chrono::duration<double>(Clock::instance().now() - t_init_)
+            .count();
   }
   sensor_data =
       std::make_tuple(time_since_init_, thrust_gain_estimator_.getThrustGain(),
@@ -165,7 +198,7 @@ bool RPYTBasedReferenceConnector<StateT, ControlT>::extractSensorData(
   thrust_gain_estimator_.addSensorData(data.rpydata.x, data.rpydata.y,
                                        body_acc);
   Eigen::Vector2d roll_pitch_bias = thrust_gain_estimator_.getRollPitchBias();
-  DATA_LOG("rpyt_reference_connector")
+  DATA_LOG(log_stream_)
       << std::get<1>(sensor_data) << position_yaw.x << position_yaw.y
       << position_yaw.z << data.rpydata.x << data.rpydata.y << position_yaw.yaw
       << velocity.x << velocity.y << velocity.z << roll_pitch_bias << sensor_r
@@ -190,8 +223,9 @@ void RPYTBasedReferenceConnector<StateT, ControlT>::sendControllerCommands(
 
 template <class StateT, class ControlT>
 void RPYTBasedReferenceConnector<StateT, ControlT>::initialize() {
-  t_init_ = std::chrono::high_resolution_clock::now();
+  t_init_ = Clock::instance().now();
   time_since_init_ = 0.0;
+  odom_sequence_ = 0;
   VLOG(1) << "Clearing thrust estimator buffer";
   thrust_gain_estimator_.clearBuffer();
 }
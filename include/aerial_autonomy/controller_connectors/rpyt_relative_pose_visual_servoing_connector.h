@@ -41,13 +41,16 @@ public:
       tf::Transform camera_transform,
       tf::Transform tracking_offset_transform = tf::Transform::getIdentity())
       : ControllerConnector(controller, ControllerGroup::UAV),
-        BaseRelativePoseVisualServoingConnector(tracker, drone_hardware,
-                                                camera_transform,
-                                                tracking_offset_transform),
+        BaseRelativePoseVisualServoingConnector(
+            tracker, drone_hardware, camera_transform,
+            tracking_offset_transform,
+            "rpyt_relative_pose_visual_servoing_connector"),
         thrust_gain_estimator_(thrust_gain_estimator),
         acceleration_bias_estimator_(acceleration_bias_estimator),
-        private_reference_controller_(controller) {
-    logTrackerHeader("rpyt_relative_pose_visual_servoing_connector");
+        private_reference_controller_(controller),
+        acceleration_bias_log_stream_(
+            Log::current().registerStream("acceleration_bias_estimator")) {
+    logTrackerHeader();
     DATA_HEADER("acceleration_bias_estimator") << "acc_bias_x"
                                                << "acc_bias_y"
                                                << "acc_bias_z"
@@ -110,4 +113,8 @@ private:
    * @brief Internal reference to controller that is connected by this class
    */
   RPYTBasedRelativePoseController &private_reference_controller_;
+  /**
+   * @brief Data stream for acceleration bias estimates
+   */
+  StreamHandle acceleration_bias_log_stream_;
 };
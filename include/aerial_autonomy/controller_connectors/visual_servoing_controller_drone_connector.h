@@ -1,6 +1,7 @@
 #pragma once
 #include "aerial_autonomy/controller_connectors/base_controller_connector.h"
 #include "aerial_autonomy/controllers/constant_heading_depth_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/trackers/base_tracker.h"
 #include "aerial_autonomy/types/position_yaw.h"
 #include "aerial_autonomy/types/velocity_yaw.h"
@@ -25,7 +26,9 @@ public:
       tf::Transform camera_transform)
       : ControllerConnector(controller, ControllerGroup::UAV),
         drone_hardware_(drone_hardware), tracker_(tracker),
-        camera_transform_(camera_transform) {}
+        camera_transform_(camera_transform),
+        log_stream_(Log::current().registerStream(
+            "visual_servoing_controller_drone_connector")) {}
   /**
    * @brief Destructor
    */
@@ -75,4 +78,8 @@ private:
   * @brief camera transform with respect to body
   */
   tf::Transform camera_transform_;
+  /**
+  * @brief Data stream for UAV state logs
+  */
+  StreamHandle log_stream_;
 };
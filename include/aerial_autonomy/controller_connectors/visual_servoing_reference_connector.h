@@ -52,13 +52,13 @@ public:
       SensorPtr<std::pair<tf::StampedTransform, tf::Vector3>> odom_sensor =
           nullptr)
       : BaseClass(controller, ControllerGroup::HighLevel),
-        BaseRelativePoseVisualServoingConnector(tracker, drone_hardware,
-                                                camera_transform,
-                                                tracking_offset_transform),
+        BaseRelativePoseVisualServoingConnector(
+            tracker, drone_hardware, camera_transform,
+            tracking_offset_transform, "visual_servoing_reference_connector"),
         dependent_connector_(dependent_connector),
         start_position_yaw_(0, 0, 0, 0), odom_sensor_(odom_sensor),
         tracking_pose_filter_(filter_gain_tracking_pose) {
-    logTrackerHeader("visual_servoing_reference_connector");
+    logTrackerHeader();
   }
 
   void initialize() {
@@ -142,8 +142,7 @@ protected:
     // filter remove rp
     tracking_pose = filter(tracking_pose);
     // Filter tracking pose
-    logTrackerData("visual_servoing_reference_connector", tracking_pose,
-                   object_pose_cam, quad_data);
+    logTrackerData(tracking_pose, object_pose_cam, quad_data);
     sensor_data = std::make_pair(start_position_yaw_, tracking_pose);
     return true;
   }
@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/base_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/types/empty_goal.h"
 #include "aerial_autonomy/types/empty_sensor.h"
 #include "aerial_autonomy/types/joystick.h"
@@ -46,12 +47,14 @@ protected:
    * @param control joint angles to send to hardware
    * return True if successfully converted sensor data to control
    */
-  virtual bool runImplementation(EmptySensor, EmptyGoal, JointAngles &control);
+  virtual bool runImplementation(EmptySensor, const EmptyGoal &,
+                                 JointAngles &control);
   /**
   * @brief Default implementation since there is no concept of convergence
   * @return controller status that contains an enum and debug information.
   */
-  virtual ControllerStatus isConvergedImplementation(EmptySensor, EmptyGoal) {
+  virtual ControllerStatus isConvergedImplementation(EmptySensor,
+                                                     const EmptyGoal &) {
     return ControllerStatus(ControllerStatus::Completed);
   }
 
@@ -64,4 +67,8 @@ protected:
   * @brief Sine properties for each joint
   */
   ArmSineControllerConfig config_;
+  /**
+  * @brief Data stream for controller logs
+  */
+  StreamHandle log_stream_;
 };
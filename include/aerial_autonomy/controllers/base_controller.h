@@ -3,6 +3,8 @@
 #include "aerial_autonomy/common/atomic.h"
 #include "aerial_autonomy/common/controller_status.h"
 
+#include <memory>
+
 /**
 * @brief Base Controller class
 *
@@ -10,6 +12,10 @@
 * takes as input the sensor data and the desired goal and returns
 * a control value.
 *
+* The goal is kept as an immutable snapshot. Setting a goal publishes a new
+* snapshot; the control loop takes a reference to the current one without
+* locking, so it never waits for a thread setting a goal.
+*
 * @tparam SensorDataType The type of sensor the controller takes in
 * @tparam GoalType  The type of goal the controller takes in
 * @tparam ControlType The type of control the controller returns
@@ -17,6 +23,18 @@
 template <class SensorDataType, class GoalType, class ControlType>
 class Controller {
 public:
+  /**
+  * @brief Immutable goal shared between the threads setting and using it
+  */
+  using GoalSnapshot = std::shared_ptr<const GoalType>;
+
+  /**
+  * @brief Constructor with a default constructed goal
+  */
+  Controller()
+      : goal_(GoalSnapshot(std::make_shared<const GoalType>()),
+              LockName("controller_goal")) {}
+
   /**
    * @brief Run the control loop and return control arguments
    * @param sensor_data Data required for control loop. Can also be
@@ -25,7 +43,8 @@ public:
    * @return True if the control run is successful
    */
   virtual bool run(SensorDataType sensor_data, ControlType &control) {
-    return runImplementation(sensor_data, goal_, control);
+    GoalSnapshot goal = goal_.get();
+    return runImplementation(sensor_data, *goal, control);
   }
 
   /**
@@ -37,19 +56,27 @@ public:
   * @return controller status that contains an enum and debug information.
   */
   ControllerStatus isConverged(SensorDataType sensor_data) {
-    return isConvergedImplementation(sensor_data, goal_);
+    GoalSnapshot goal = goal_.get();
+    return isConvergedImplementation(sensor_data, *goal);
   }
   /**
-   * @brief set the goal condition for the controller. Should use
-   * internal locking as the run function can be called from a separate thread
+   * @brief set the goal condition for the controller. Publishes a new goal
+   * snapshot, as the run function can be called from a separate thread
    * @param goal The goal for control loop
    */
-  virtual void setGoal(GoalType goal) { goal_ = goal; }
+  virtual void setGoal(GoalType goal) {
+    goal_ = GoalSnapshot(std::make_shared<const GoalType>(std::move(goal)));
+  }
+  /**
+   * @brief get the goal condition for the controller. Copies the current
+   * goal snapshot, as the run function can be called from a separate thread
+   */
+  virtual GoalType getGoal() const { return *goal_.get(); }
   /**
-   * @brief get the goal condition for the controller. Should use
-   * internal locking as the run function can be called from a separate thread
+   * @brief get the current goal snapshot without copying the goal
+   * @return Snapshot that stays valid while held, even if a new goal is set
    */
-  virtual GoalType getGoal() const { return goal_; }
+  GoalSnapshot getGoalSnapshot() const { return goal_.get(); }
   /**
    * @brief Reset controller state called by connector initialize at the
    * beginning
@@ -69,7 +96,8 @@ protected:
    * @param control Output Control values to send to hardware
    * @return True if the run is successful
    */
-  virtual bool runImplementation(SensorDataType sensor_data, GoalType goal,
+  virtual bool runImplementation(SensorDataType sensor_data,
+                                 const GoalType &goal,
                                  ControlType &control) = 0;
   /**
   * @brief Implementation for checking convergence to be implemented by
@@ -83,11 +111,11 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(SensorDataType sensor_data,
-                                                     GoalType goal) = 0;
+                                                     const GoalType &goal) = 0;
 
 private:
   /**
   * @brief store goal internally for usage with Controller::runImplementation
   */
-  Atomic<GoalType> goal_;
+  Atomic<GoalSnapshot, atomic_policy::TripleBuffer> goal_;
 };
@@ -27,7 +27,8 @@ protected:
    * @param control Goal to send to hardware
    * @return Always true
    */
-  virtual bool runImplementation(GoalType, GoalType goal, GoalType &control) {
+  virtual bool runImplementation(GoalType, const GoalType &goal,
+                                 GoalType &control) {
     control = goal;
     return true;
   }
@@ -44,7 +45,8 @@ public:
   * @param config specifies position and yaw tolerance
   */
   BuiltInPositionController(PositionControllerConfig config)
-      : config_(config) {}
+      : config_(config), log_stream_(Log::current().registerStream(
+                             "builtin_position_controller")) {}
 
   /**
   * @brief Constructor that uses default constructor
@@ -64,12 +66,12 @@ protected:
   */
   virtual ControllerStatus
   isConvergedImplementation(PositionYaw current_position_yaw,
-                            PositionYaw goal) {
+                            const PositionYaw &goal) {
     PositionYaw position_yaw_diff = current_position_yaw - goal;
     ControllerStatus status(ControllerStatus::Active);
     status << "PositionYawDiff: " << position_yaw_diff.x << position_yaw_diff.y
            << position_yaw_diff.z << position_yaw_diff.yaw;
-    DATA_LOG("builtin_position_controller")
+    DATA_LOG(log_stream_)
         << position_yaw_diff.x << position_yaw_diff.y << position_yaw_diff.z
         << position_yaw_diff.yaw << DataStream::endl;
     const config::Position &tolerance_pos = config_.goal_position_tolerance();
@@ -90,6 +92,10 @@ private:
   * @brief Config specifies position and yaw tolerance
   */
   PositionControllerConfig config_;
+  /**
+  * @brief Data stream for controller logs
+  */
+  StreamHandle log_stream_;
 };
 
 /**
@@ -123,7 +129,7 @@ protected:
   */
   virtual ControllerStatus
   isConvergedImplementation(VelocityYaw current_velocity_yaw,
-                            VelocityYaw goal) {
+                            const VelocityYaw &goal) {
     VelocityYaw velocity_yaw_diff = current_velocity_yaw - goal;
     // Add optional description:
     ControllerStatus status(ControllerStatus::Active);
@@ -176,8 +182,9 @@ protected:
   *
   * @return status that contains different states the controller and debug info.
   */
-  virtual ControllerStatus isConvergedImplementation(tf::Transform current_pose,
-                                                     tf::Transform goal) {
+  virtual ControllerStatus
+  isConvergedImplementation(tf::Transform current_pose,
+                            const tf::Transform &goal) {
     tf::Vector3 current_position = current_pose.getOrigin();
     tf::Vector3 goal_position = goal.getOrigin();
     tf::Quaternion current_quat = current_pose.getRotation();
@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/base_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/types/position_yaw.h"
 #include "aerial_autonomy/types/velocity_yaw_rate.h"
 #include "constant_heading_depth_controller_config.pb.h"
@@ -22,7 +23,8 @@ public:
   * @brief Constructor which takes a configuration
   */
   ConstantHeadingDepthController(ConstantHeadingDepthControllerConfig config)
-      : config_(config) {}
+      : config_(config), log_stream_(Log::current().registerStream(
+                             "constant_heading_depth_controller")) {}
   /**
    * @brief Destructor
    */
@@ -37,7 +39,7 @@ protected:
    * @param control Velocity command to send to hardware
    * @return True if Controller is successful in running
    */
-  virtual bool runImplementation(PositionYaw sensor_data, Position goal,
+  virtual bool runImplementation(PositionYaw sensor_data, const Position &goal,
                                  VelocityYawRate &control);
   /**
   * @brief Check if controller converged
@@ -48,6 +50,7 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(PositionYaw sensor_data,
-                                                     Position goal);
+                                                     const Position &goal);
   ConstantHeadingDepthControllerConfig config_; ///< Controller configuration
+  StreamHandle log_stream_; ///< Data stream for controller logs
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/ddp_casadi_mpc_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "airm_mpc_controller_config.pb.h"
 
 /**
@@ -58,7 +59,7 @@ protected:
   * @return Controller status
   */
   ControllerStatus isConvergedImplementation(MPCInputs<StateType> sensor_data,
-                                             GoalType goal);
+                                             const GoalType &goal);
   virtual ControlType stationaryControl();
 
   virtual void outputControl(ControlType &control);
@@ -67,6 +68,7 @@ protected:
 
 private:
   AirmMPCControllerConfig config_;        ///< MPC controller config
+  StreamHandle log_stream_;               ///< Data stream for controller logs
   static constexpr int state_size_ = 21;  ///< state size
   static constexpr int control_size_ = 6; ///< state size
 };
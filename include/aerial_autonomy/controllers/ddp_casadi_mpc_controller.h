@@ -1,4 +1,5 @@
 #pragma once
+#include "aerial_autonomy/common/profiled_mutex.h"
 #include "aerial_autonomy/controllers/mpc_controller.h"
 #include "ddp_mpc_controller_config.pb.h"
 
@@ -135,8 +136,8 @@ protected:
   *
   * @return
   */
-  bool runImplementation(MPCInputs<StateType> sensor_data, GoalType goal,
-                         ControlType &control);
+  bool runImplementation(MPCInputs<StateType> sensor_data,
+                         const GoalType &goal, ControlType &control);
 
 protected:
   DDPMPCControllerConfig ddp_config_;                   ///< DDP Config
@@ -164,7 +165,9 @@ protected:
       control_timer_shift_; ///< How many steps should the control shift by for
                             /// hot starting
   unsigned int max_iters_;  ///< Maximum number of iterations
-  mutable boost::mutex
-      copy_mutex_;                ///< Synchronize access to states and controls
+  /**
+  * @brief Synchronize access to states and controls
+  */
+  mutable ProfiledMutex copy_mutex_{"ddp_mpc_copy"};
   bool controller_config_status_; ///< If config provided is ok
 };
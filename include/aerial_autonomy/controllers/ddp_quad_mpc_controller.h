@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/ddp_casadi_mpc_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "quad_mpc_controller_config.pb.h"
 
 /**
@@ -53,7 +54,7 @@ protected:
   * @return Controller status
   */
   ControllerStatus isConvergedImplementation(MPCInputs<StateType> sensor_data,
-                                             GoalType goal);
+                                             const GoalType &goal);
   virtual ControlType stationaryControl();
 
   virtual void outputControl(ControlType &control);
@@ -62,6 +63,7 @@ protected:
 
 private:
   QuadMPCControllerConfig config_;        ///< MPC controller config
+  StreamHandle log_stream_;               ///< Data stream for controller logs
   static constexpr int state_size_ = 15;  ///< Size of state dimension
   static constexpr int control_size_ = 4; ///< Size of state dimension
 };
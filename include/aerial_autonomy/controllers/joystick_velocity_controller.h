@@ -66,7 +66,7 @@ protected:
    */
   virtual bool
   runImplementation(std::tuple<Joystick, VelocityYawRate, double> sensor_data,
-                    EmptyGoal goal, RollPitchYawRateThrust &control);
+                    const EmptyGoal &goal, RollPitchYawRateThrust &control);
   /**
   * @brief Converges when the internal controller converges
   *
@@ -74,7 +74,7 @@ protected:
   */
   virtual ControllerStatus isConvergedImplementation(
       std::tuple<Joystick, VelocityYawRate, double> sensor_data,
-      EmptyGoal goal);
+      const EmptyGoal &goal);
 
 private:
   /**
@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/base_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/types/empty_goal.h"
 #include "aerial_autonomy/types/joystick.h"
 #include "aerial_autonomy/types/roll_pitch_yawrate_thrust.h"
@@ -28,14 +29,21 @@ protected:
    * @param control RPYT to send to hardware
    * return True if successfully converted sensor data to control
    */
-  virtual bool runImplementation(Joystick sensor_data, EmptyGoal goal,
+  virtual bool runImplementation(Joystick sensor_data, const EmptyGoal &goal,
                                  RollPitchYawRateThrust &control);
   /**
   * @brief Default implementation since there is no concept of convergence
   * for manual rpyt controller
   * @return controller status that contains an enum and debug information.
   */
-  virtual ControllerStatus isConvergedImplementation(Joystick, EmptyGoal) {
+  virtual ControllerStatus isConvergedImplementation(Joystick,
+                                                     const EmptyGoal &) {
     return ControllerStatus(ControllerStatus::Completed);
   }
+
+private:
+  /**
+  * @brief Data stream for controller logs
+  */
+  StreamHandle log_stream_;
 };
@@ -49,7 +49,9 @@ public:
   */
   QrotorBacksteppingController(QrotorBacksteppingControllerConfig config)
       : config_(config), m_(config_.mass()), e_(0, 0, 1),
-        ag_(0, 0, -config_.acc_gravity()) {
+        ag_(0, 0, -config_.acc_gravity()),
+        log_stream_(Log::current().registerStream(
+            "qrotor_backstepping_controller")) {
     // Compute P from Q, K
     Eigen::Vector3d kp(config_.kp_xy(), config_.kp_xy(), config_.kp_z());
     Eigen::Vector3d kd(config_.kd_xy(), config_.kd_xy(), config_.kd_z());
@@ -98,7 +100,7 @@ protected:
    */
   bool runImplementation(
       std::pair<double, QrotorBacksteppingState> sensor_data,
-      std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> goal,
+      const std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> &goal,
       QrotorBacksteppingControl &control);
   /**
   * @brief Check if controller has converged (reached the end of the reference)
@@ -111,7 +113,7 @@ protected:
   */
   ControllerStatus isConvergedImplementation(
       std::pair<double, QrotorBacksteppingState> sensor_data,
-      std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> goal);
+      const std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> &goal);
   /**
   * @brief Gets current goal and derivatives from the reference
   * @param ref Reference trajectory
@@ -162,4 +164,8 @@ private:
   * @brief Weight matrix for Lyapunov function time derivative
   */
   Matrix6d Q_;
+  /**
+  * @brief Data stream for controller logs
+  */
+  StreamHandle log_stream_;
 };
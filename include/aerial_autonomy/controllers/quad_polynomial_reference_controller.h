@@ -47,7 +47,8 @@ protected:
    * @return true if able to generate the trajectory
    */
   virtual bool runImplementation(
-      std::pair<PositionYaw, tf::Transform> sensor_data, PositionYaw goal,
+      std::pair<PositionYaw, tf::Transform> sensor_data,
+      const PositionYaw &goal,
       ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd> &control);
 
   /**
@@ -62,7 +63,7 @@ protected:
    */
   virtual ControllerStatus
       isConvergedImplementation(std::pair<PositionYaw, tf::Transform>,
-                                PositionYaw) {
+                                const PositionYaw &) {
     return ControllerStatus(ControllerStatus::Status::Active);
   }
 
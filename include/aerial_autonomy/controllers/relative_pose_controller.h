@@ -1,5 +1,6 @@
 #pragma once
 #include "aerial_autonomy/controllers/base_controller.h"
+#include "aerial_autonomy/log/log.h"
 #include "pose_controller_config.pb.h"
 
 #include <tuple>
@@ -17,7 +18,9 @@ public:
   /**
   * @brief Constructor
   */
-  RelativePoseController(PoseControllerConfig config) : config_(config) {}
+  RelativePoseController(PoseControllerConfig config)
+      : config_(config), log_stream_(Log::current().registerStream(
+                             "relative_pose_controller")) {}
   /**
    * @brief Destructor
    */
@@ -35,7 +38,7 @@ protected:
    */
   virtual bool
   runImplementation(std::tuple<tf::Transform, tf::Transform> sensor_data,
-                    tf::Transform goal, tf::Transform &control);
+                    const tf::Transform &goal, tf::Transform &control);
   /**
   * @brief Check if controller converged
   *
@@ -45,11 +48,16 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(
-      std::tuple<tf::Transform, tf::Transform> sensor_data, tf::Transform goal);
+      std::tuple<tf::Transform, tf::Transform> sensor_data,
+      const tf::Transform &goal);
 
 private:
   /**
   * @brief Config specifies position tolerance
   */
   PoseControllerConfig config_;
+  /**
+  * @brief Data stream for controller logs
+  */
+  StreamHandle log_stream_;
 };
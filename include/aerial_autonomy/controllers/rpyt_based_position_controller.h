@@ -60,7 +60,7 @@ protected:
    */
   virtual bool
   runImplementation(std::tuple<VelocityYawRate, PositionYaw> sensor_data,
-                    PositionYaw goal, RollPitchYawRateThrust &control);
+                    const PositionYaw &goal, RollPitchYawRateThrust &control);
   /**
   * @brief Check if rpyt based position controller converged
   *
@@ -70,7 +70,8 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(
-      std::tuple<VelocityYawRate, PositionYaw> sensor_data, PositionYaw goal);
+      std::tuple<VelocityYawRate, PositionYaw> sensor_data,
+      const PositionYaw &goal);
 
 private:
   /**
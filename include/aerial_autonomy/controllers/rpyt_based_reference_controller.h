@@ -28,7 +28,9 @@ public:
    * @param config Controller config
    */
   AbstractRPYTBasedReferenceController(RPYTBasedPositionControllerConfig config)
-      : config_(config) {
+      : config_(config),
+        log_stream_(
+            Log::current().registerStream("rpyt_reference_controller")) {
     resetPositionTolerance();
     // clang-format off
     DATA_HEADER("rpyt_reference_controller") << "Errorx"
@@ -90,7 +92,7 @@ protected:
    */
   bool runImplementation(
       std::tuple<double, double, Velocity, PositionYaw> sensor_data,
-      ReferenceTrajectoryPtr<StateT, ControlT> goal,
+      const ReferenceTrajectoryPtr<StateT, ControlT> &goal,
       RollPitchYawRateThrust &control) {
     auto state_control_pair = goal->atTime(std::get<0>(sensor_data));
     auto simplified_goal = getReference(state_control_pair.first);
@@ -140,7 +142,7 @@ protected:
     control.t = desired_acceleration.norm() / kt;
     control.t = math::clamp(control.t, velocity_config.min_thrust(),
                             velocity_config.max_thrust());
-    DATA_LOG("rpyt_reference_controller")
+    DATA_LOG(log_stream_)
         << error_position_yaw.x << error_position_yaw.y << error_position_yaw.z
         << error_position_yaw.yaw << error_velocity.x << error_velocity.y
         << error_velocity.z << control.r << control.p << control.y << control.t << DataStream::endl;
@@ -156,7 +158,7 @@ protected:
   */
   virtual ControllerStatus isConvergedImplementation(
       std::tuple<double, double, Velocity, PositionYaw> sensor_data,
-      ReferenceTrajectoryPtr<StateT, ControlT> goal) {
+      const ReferenceTrajectoryPtr<StateT, ControlT> &goal) {
     ControllerStatus status = ControllerStatus::Status::Active;
     auto simplified_goal = getReference(goal->goal(std::get<0>(sensor_data)));
     Velocity current_velocity = std::get<2>(sensor_data);
@@ -196,6 +198,7 @@ protected:
 private:
   RPYTBasedPositionControllerConfig config_; ///< Gains for reference tracking
   Atomic<PositionControllerConfig> position_controller_config_;/// position controller config
+  StreamHandle log_stream_; ///< Data stream for controller logs
 };
 
 class RPYTBasedReferenceControllerEigen
@@ -77,7 +77,7 @@ protected:
    */
   virtual bool runImplementation(
       std::tuple<tf::Transform, tf::Transform, VelocityYawRate> sensor_data,
-      PositionYaw goal, RollPitchYawRateThrust &control);
+      const PositionYaw &goal, RollPitchYawRateThrust &control);
   /**
   * @brief Check if controller converged
   *
@@ -91,7 +91,7 @@ protected:
   */
   virtual ControllerStatus isConvergedImplementation(
       std::tuple<tf::Transform, tf::Transform, VelocityYawRate> sensor_data,
-      PositionYaw goal);
+      const PositionYaw &goal);
 
 private:
   /**
@@ -26,7 +26,9 @@ public:
   RPYTBasedVelocityController(
       RPYTBasedVelocityControllerConfig config,
       std::chrono::duration<double> controller_timer_duration)
-      : config_(config), controller_timer_duration_(controller_timer_duration) {
+      : config_(config), controller_timer_duration_(controller_timer_duration),
+        log_stream_(Log::current().registerStream(
+            "rpyt_based_velocity_controller")) {
     RPYTBasedVelocityControllerConfig check_config = config_;
     CHECK_GE(check_config.kp_xy(), 0) << "negative kp_xy ! exiting";
     CHECK_GE(check_config.kp_z(), 0) << "negative kp_z ! exiting";
@@ -89,7 +91,8 @@ protected:
    */
   virtual bool
   runImplementation(std::tuple<VelocityYawRate, double> sensor_data,
-                    VelocityYawRate goal, RollPitchYawRateThrust &control);
+                    const VelocityYawRate &goal,
+                    RollPitchYawRateThrust &control);
   /**
   * @brief Check if RPYT based velocity controller converged
   *
@@ -100,7 +103,7 @@ protected:
   */
   virtual ControllerStatus
   isConvergedImplementation(std::tuple<VelocityYawRate, double> sensor_data,
-                            VelocityYawRate goal);
+                            const VelocityYawRate &goal);
   Atomic<RPYTBasedVelocityControllerConfig>
       config_; ///< Controller configuration
                /**
@@ -111,4 +114,8 @@ protected:
    * @brief The timestep used for integrating cumulative error
    */
   const std::chrono::duration<double> controller_timer_duration_;
+  /**
+   * @brief Data stream for controller logs
+   */
+  StreamHandle log_stream_;
 };
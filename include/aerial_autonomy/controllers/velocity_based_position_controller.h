@@ -30,7 +30,9 @@ public:
   VelocityBasedPositionController(
       VelocityBasedPositionControllerConfig config,
       std::chrono::duration<double> dt = std::chrono::milliseconds(20))
-      : config_(config), cumulative_error_(0, 0, 0, 0), dt_(dt) {
+      : config_(config), cumulative_error_(0, 0, 0, 0), dt_(dt),
+        log_stream_(Log::current().registerStream(
+            "velocity_based_position_controller")) {
 
     CHECK(config_.position_gain() > 0) << "Gain should be non-negative";
     CHECK(config_.z_gain() > 0) << "Gain should be non-negative";
@@ -135,7 +137,8 @@ protected:
    * @param control Velocity command to send to hardware
    * @return true if velocity command to reach goal is found
    */
-  virtual bool runImplementation(PositionYaw sensor_data, PositionYaw goal,
+  virtual bool runImplementation(PositionYaw sensor_data,
+                                 const PositionYaw &goal,
                                  VelocityYawRate &control);
   /**
   * @brief Check if velocity based position controller converged
@@ -146,9 +149,10 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(PositionYaw sensor_data,
-                                                     PositionYaw goal);
+                                                     const PositionYaw &goal);
   VelocityBasedPositionControllerConfig config_; ///< Controller configuration
   PositionYaw cumulative_error_; ///< Error integrated over multiple runs
   const std::chrono::duration<double>
       dt_; ///< Time diff between different successive runImplementation calls
+  StreamHandle log_stream_; ///< Data stream for controller logs
 };
@@ -28,7 +28,9 @@ public:
       std::chrono::duration<double> dt = std::chrono::milliseconds(20))
       : config_(config),
         position_controller_(config.velocity_based_position_controller_config(),
-                             dt) {}
+                             dt),
+        log_stream_(Log::current().registerStream(
+            "velocity_based_relative_pose_controller")) {}
   /**
    * @brief Destructor
    */
@@ -70,7 +72,7 @@ protected:
    */
   virtual bool
   runImplementation(std::tuple<tf::Transform, tf::Transform> sensor_data,
-                    PositionYaw goal, VelocityYawRate &control);
+                    const PositionYaw &goal, VelocityYawRate &control);
   /**
   * @brief Check if controller converged
   *
@@ -82,7 +84,8 @@ protected:
   * @return controller status that contains an enum and debug information.
   */
   virtual ControllerStatus isConvergedImplementation(
-      std::tuple<tf::Transform, tf::Transform> sensor_data, PositionYaw goal);
+      std::tuple<tf::Transform, tf::Transform> sensor_data,
+      const PositionYaw &goal);
 
 private:
   /**
@@ -94,4 +97,8 @@ private:
    * pose
    */
   VelocityBasedPositionController position_controller_;
+  /**
+   * @brief Data stream for controller logs
+   */
+  StreamHandle log_stream_;
 };
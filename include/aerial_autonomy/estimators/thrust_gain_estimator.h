@@ -1,4 +1,5 @@
 #pragma once
+#include "aerial_autonomy/log/log.h"
 #include "thrust_gain_estimator_config.pb.h"
 #include <Eigen/Dense>
 #include <queue>
@@ -213,4 +214,8 @@ private:
    * @brief Initial pitch bias
    */
   const double init_pitch_bias_;
+  /**
+   * @brief Data stream for estimator logs
+   */
+  StreamHandle log_stream_;
 };
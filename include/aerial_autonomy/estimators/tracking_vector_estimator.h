@@ -1,4 +1,5 @@
 #pragma once
+#include "aerial_autonomy/log/log.h"
 #include "tracking_vector_estimator_config.pb.h"
 #include <chrono>
 #include <glog/logging.h>
@@ -48,6 +49,10 @@ private:
    * marker measurements are not removed after consuming them once.
    */
   tf::Vector3 marker_dilation_stdev_;
+  /**
+   * @brief Data stream for filter logs
+   */
+  StreamHandle log_stream_;
   /**
    * @brief Create a opencv matrix given a diagonal vector
    *
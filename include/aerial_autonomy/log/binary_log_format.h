@@ -0,0 +1,211 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Namespace for encoding and decoding binary DataStream files
+ *
+ * A binary stream file starts with a file header (magic, version, delimiter)
+ * and a schema (header names and column types). Both are written together
+ * with the first data point, so a stream that never logged data is empty.
+ * The schema is followed by fixed-width records, one per data point, whose
+ * columns are stored in native byte order, or by compressed blocks of records
+ * (see BlockEncoder).
+ */
+namespace binary_log {
+
+class BlockDecoder;
+
+/**
+ * @brief Type of a column in a binary record
+ */
+enum class ColumnType : uint8_t {
+  Int64 = 0, ///< Signed 64 bit integer (used for integral and bool data)
+  Double = 1 ///< 64 bit floating point
+};
+
+/**
+ * @brief Encoding of the records following the schema
+ */
+enum class Encoding : uint8_t {
+  Fixed = 0,     ///< Fixed-width records
+  Compressed = 1 ///< Compressed blocks of records
+};
+
+/**
+ * @brief Version of the binary format written by DataStream. Version 1 files
+ * have no encoding and always contain fixed-width records
+ */
+const uint32_t kFormatVersion = 2;
+
+/**
+ * @brief Width of a column in bytes
+ * @param type Type of the column
+ * @return Number of bytes used by the column in a record
+ */
+size_t columnWidth(ColumnType type);
+
+/**
+ * @brief Describes the layout of records in a binary stream file
+ */
+struct Schema {
+  std::string delimiter;               ///< Delimiter used when formatting text
+  std::vector<std::string> names;      ///< Header names (may be empty)
+  std::vector<ColumnType> types;       ///< Type of each record column
+  Encoding encoding = Encoding::Fixed; ///< Encoding of the records
+
+  /**
+   * @brief Size of a single record in bytes
+   * @return Sum of all column widths
+   */
+  size_t recordSize() const;
+};
+
+/**
+ * @brief Serialize file header and schema
+ * @param schema Schema to serialize
+ * @return Bytes to write at the start of a binary stream file
+ */
+std::string encodeSchema(const Schema &schema);
+
+/**
+ * @brief Read a file header and schema written by encodeSchema
+ *
+ * Throws std::runtime_error if the data is not a binary stream or the schema
+ * is corrupt
+ *
+ * @param in Stream positioned at the start of the file header
+ * @param schema Schema to fill
+ * @return False if the stream is empty
+ */
+bool readSchema(std::istream &in, Schema &schema);
+
+/**
+ * @brief Deserialize file header and schema
+ *
+ * Throws std::runtime_error if the bytes are not a valid schema
+ *
+ * @param bytes Bytes written by encodeSchema
+ * @param schema Schema to fill
+ * @return False if bytes is empty
+ */
+bool decodeSchema(const std::string &bytes, Schema &schema);
+
+/**
+ * @brief Check if a file is a binary stream file
+ * @param path Path of the file
+ * @return True if the file starts with the binary stream magic
+ */
+bool isBinaryLog(const boost::filesystem::path &path);
+
+/**
+ * @brief Sequentially reads records from a binary stream file
+ */
+class BinaryLogReader {
+public:
+  /**
+   * @brief Constructor
+   *
+   * Throws std::runtime_error if the file cannot be opened or is not a
+   * binary stream file
+   *
+   * @param path Path of the binary stream file
+   */
+  BinaryLogReader(boost::filesystem::path path);
+
+  /**
+   * @brief Destructor
+   */
+  ~BinaryLogReader();
+
+  /**
+   * @brief Check if the file contains a schema.
+   *
+   * A stream that never received a data point is empty
+   * @return True if a schema is present
+   */
+  bool hasSchema() const;
+
+  /**
+   * @brief Getter for schema
+   * @return Schema of the file
+   */
+  const Schema &schema() const;
+
+  /**
+   * @brief Read the next record
+   * @return False if there are no complete records left
+   */
+  bool next();
+
+  /**
+   * @brief Continue reading at a record (or compressed block) boundary, such
+   * as an offset from the time index
+   * @param offset Byte offset from the start of the file
+   */
+  void seek(uint64_t offset);
+
+  /**
+   * @brief Get an integer column of the current record
+   * @param column Index of the column
+   * @return Column value
+   */
+  int64_t getInt64(size_t column) const;
+
+  /**
+   * @brief Get a floating point column of the current record
+   * @param column Index of the column
+   * @return Column value
+   */
+  double getDouble(size_t column) const;
+
+  /**
+   * @brief Format the header names the same way a text DataStream does
+   * @return Delimiter separated header names
+   */
+  std::string formatHeader() const;
+
+  /**
+   * @brief Format the current record the same way a text DataStream does
+   * @return Delimiter separated record
+   */
+  std::string formatRecord() const;
+
+  /**
+   * @brief Format a column of the current record the same way a text
+   * DataStream does
+   * @param column Index of the column
+   * @return Formatted column value
+   */
+  std::string formatColumn(size_t column) const;
+
+private:
+  /**
+   * @brief Read raw bytes from file
+   * @param data Buffer to fill
+   * @param size Number of bytes to read
+   * @return True if all bytes were read
+   */
+  bool read(char *data, size_t size);
+
+  /**
+   * @brief Read the next compressed block
+   * @return False if there are no complete blocks left
+   */
+  bool readBlock();
+
+  std::ifstream fs_;                      ///< Input file
+  bool has_schema_;                       ///< Whether a schema was read
+  Schema schema_;                         ///< Schema of the file
+  std::vector<size_t> offsets_;           ///< Byte offset of each column
+  std::vector<char> record_;              ///< Current record
+  std::unique_ptr<BlockDecoder> decoder_; ///< Decoder of compressed blocks
+  std::string block_;                     ///< Current compressed block
+};
+}
@@ -1,28 +1,68 @@
 #pragma once
 
+#include "aerial_autonomy/log/binary_log_format.h"
+#include "aerial_autonomy/log/flight_recorder.h"
+#include "aerial_autonomy/log/gorilla_codec.h"
+#include "aerial_autonomy/log/record_ring_buffer.h"
+#include "aerial_autonomy/log/segmented_file_writer.h"
+#include "aerial_autonomy/log/telemetry_tap.h"
+#include "aerial_autonomy/log/time_index.h"
 #include "data_stream_config.pb.h"
 
 #include <Eigen/Dense>
+#include <atomic>
 #include <boost/filesystem.hpp>
-#include <boost/thread/mutex.hpp>
 #include <chrono>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <type_traits>
 
 /**
  * @brief DataStream is a rate-limited output stream for data logging.
- * Users need to call its write() function to write its internal buffer to a
+ * Completed data points are pushed into a bounded lock-free ring buffer.
+ * Users need to call its write() function to drain the ring buffer into a
  * file.
  * This call will typically be done in a separate thread to ensure that logging
- * does not interfere with other tasks.
+ * does not interfere with other tasks. Data points are dropped (and counted)
+ * if the ring buffer is full.
+ *
+ * A DataStream supports one producer thread (the thread streaming data points)
+ * and one consumer thread (the thread calling write) at a time.
+ *
+ * The file is either written through a file stream or, if a segment size is
+ * given, as a sequence of memory-mapped segment files (see
+ * SegmentedFileWriter). Each segment starts with the most recent header. A
+ * file stream is accompanied by a sparse time index (see TimeIndexWriter) if
+ * the configured index interval is positive. Data points can additionally be
+ * mirrored into a shared memory ring for live observation (see TelemetryTap).
+ *
+ * If the flight recorder is enabled, every data point is also copied into an
+ * in-memory FlightRecorder, including the data points that log_rate keeps
+ * out of the file. dumpRecorder writes this history to a separate file in the
+ * text or (uncompressed) binary format of the stream.
+ *
+ * In binary format, numeric data is stored as fixed-width typed columns
+ * instead of delimiter separated text. The column names are taken from the
+ * header (starth) and the column types from the first data point. Data points
+ * that do not match this schema are dropped. In compressed format, the records
+ * popped by write() are compressed into blocks (see binary_log::BlockEncoder)
+ * so that the compression runs in the writer thread.
  */
 class DataStream {
 public:
   /**
   * @brief Constructor
-  * @param path File path to write to
+  * @param path File path to write to. Base path of the segment files if
+  * segment_size is positive
   * @param config Data stream configuration
+  * @param segment_size Size of memory-mapped segment files in bytes. Zero
+  * writes a single file through a file stream
+  * @param disk_budget Disk budget shared by segment files. Can be null
   */
-  DataStream(boost::filesystem::path path, DataStreamConfig config);
+  DataStream(boost::filesystem::path path, DataStreamConfig config,
+             uint64_t segment_size = 0,
+             std::shared_ptr<DiskBudget> disk_budget = nullptr);
 
   /**
   * @brief Move operator
@@ -35,6 +75,13 @@ public:
   */
   void write();
 
+  /**
+  * @brief Close the file and the telemetry tap. Data points streamed
+  * afterwards are buffered but never written. Must not be called while the
+  * stream is written
+  */
+  void close();
+
   /**
   * @brief Getter for config
   * @return Configuration
@@ -47,6 +94,36 @@ public:
   */
   boost::filesystem::path path();
 
+  /**
+  * @brief Number of data points dropped because they did not match the binary
+  * schema
+  * @return Number of dropped data points
+  */
+  uint64_t droppedDataPoints() const;
+
+  /**
+  * @brief Number of data points dropped because the ring buffer was full
+  * @return Number of dropped data points
+  */
+  uint64_t overflowDataPoints() const;
+
+  /**
+  * @brief Number of data point starts (startl, starth) and ends (endl) of
+  * the producer. Odd while a data point is streamed. Can be called from any
+  * thread
+  * @return Writer epoch
+  */
+  uint64_t writerEpoch() const;
+
+  /**
+  * @brief Write the data points held by the flight recorder to a file. Can be
+  * called from any thread
+  * @param path File to write
+  * @return Number of data points written. Zero if the recorder is disabled or
+  * empty, in which case no file is written
+  */
+  size_t dumpRecorder(boost::filesystem::path path);
+
   /**
   * @brief Stream operator for stream modifiers
   * @param func Function pointer for modifying the stream
@@ -62,7 +139,14 @@ public:
   */
   template <class T> DataStream &operator<<(const T &t) {
     if (config_.log_data() && streaming_) {
-      data_point_ << config_.delimiter() << t;
+      if (!binary_) {
+        data_point_.append(config_.delimiter());
+        addTextColumn(t, IsTextNumber<T>());
+      } else if (streaming_header_) {
+        addHeaderColumn(t);
+      } else {
+        addBinaryColumn(t, std::is_arithmetic<T>());
+      }
     }
     return *this;
   }
@@ -76,7 +160,7 @@ public:
   DataStream &operator<<(const Eigen::Matrix<double, row, col> &t) {
     if (config_.log_data() && streaming_) {
       for (int i = 0; i < t.size(); ++i) {
-        data_point_ << config_.delimiter() << t(i);
+        *this << t(i);
       }
     }
     return *this;
@@ -103,21 +187,205 @@ public:
 
 private:
   /**
-  * @brief Reset a string stream
-  * @param ss String stream to reset
+  * @brief True for the arithmetic types that std::ostream writes as numbers.
+  * Character types are written as characters
+  */
+  template <class T>
+  struct IsTextNumber
+      : std::integral_constant<bool,
+                               std::is_arithmetic<T>::value &&
+                                   !std::is_same<T, char>::value &&
+                                   !std::is_same<T, signed char>::value &&
+                                   !std::is_same<T, unsigned char>::value> {};
+
+  /**
+  * @brief Add a numeric column to the text data point without going through
+  * a stringstream. Uses the same formatting as the default std::ostream.
+  * @tparam T Arithmetic type of the data
+  * @param t Data to add
+  */
+  template <class T> void addTextColumn(const T &t, std::true_type) {
+    if (std::is_floating_point<T>::value) {
+      appendDouble(t);
+    } else if (std::is_signed<T>::value) {
+      appendInteger(t);
+    } else {
+      appendUnsigned(t);
+    }
+  }
+
+  /**
+  * @brief Add a non-numeric column to the text data point
+  * @tparam T Type of the data. Must support streaming to std::ostream
+  * @param t Data to add
+  */
+  template <class T> void addTextColumn(const T &t, std::false_type) {
+    std::ostringstream ss;
+    ss << t;
+    data_point_.append(ss.str());
+  }
+
+  /**
+  * @brief Format a floating point number into the text data point
+  * @param value Number to format
+  */
+  void appendDouble(double value);
+
+  /**
+  * @brief Format a signed integer into the text data point
+  * @param value Number to format
+  */
+  void appendInteger(long long value);
+
+  /**
+  * @brief Format an unsigned integer into the text data point
+  * @param value Number to format
+  */
+  void appendUnsigned(unsigned long long value);
+
+  /**
+  * @brief Add a header name to the binary schema
+  * @tparam T Type of the header name
+  * @param t Header name
+  */
+  template <class T> void addHeaderColumn(const T &t) {
+    std::stringstream ss;
+    ss << t;
+    header_names_.push_back(ss.str());
+  }
+
+  /**
+  * @brief Add a numeric column to the binary data point
+  * @tparam T Arithmetic type of the data
+  * @param t Data to add
+  */
+  template <class T> void addBinaryColumn(const T &t, std::true_type) {
+    if (std::is_floating_point<T>::value) {
+      appendBinary(binary_log::ColumnType::Double, double(t));
+    } else {
+      appendBinary(binary_log::ColumnType::Int64, int64_t(t));
+    }
+  }
+
+  /**
+  * @brief Non-numeric data cannot be stored in a binary data point. Marks the
+  * data point as invalid
+  * @tparam T Type of the data
+  */
+  template <class T> void addBinaryColumn(const T &, std::false_type) {
+    binary_data_point_valid_ = false;
+  }
+
+  /**
+  * @brief Append a column to the binary data point
+  * @tparam T Type of the column value
+  * @param type Column type
+  * @param value Column value
+  */
+  template <class T>
+  void appendBinary(binary_log::ColumnType type, const T &value) {
+    data_point_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    binary_data_point_types_.push_back(type);
+  }
+
+  /**
+  * @brief Move the current binary data point into the ring buffer and the
+  * flight recorder. Writes the schema before the first data point.
+  */
+  void bufferBinaryDataPoint();
+
+  /**
+  * @brief Copy the current data point into the flight recorder if it is
+  * enabled
+  */
+  void recordDataPoint();
+
+  /**
+  * @brief Update the header of flight recorder dumps from the binary schema
+  */
+  void updateRecorderHeader();
+
+  /**
+  * @brief Write a record popped from the ring buffer to file
+  * @param header Whether the record is a header
+  * @param data Record bytes
+  * @param size Number of bytes
+  * @return True if the record was written to the file stream and needs to be
+  * flushed
+  */
+  bool writeRecord(bool header, const char *data, size_t size);
+
+  /**
+  * @brief Write the current compressed block to file
+  * @return True if the block was written to the file stream and needs to be
+  * flushed
+  */
+  bool writeBlock();
+
+  /**
+  * @brief Open the time index of the stream file if it is enabled
+  */
+  void openIndex();
+
+  /**
+  * @brief Register the next record written to the file stream with the time
+  * index
+  * @param time Timestamp of the first data point in the record
+  * @param data_points Number of data points in the record
+  */
+  void indexRecord(int64_t time, uint32_t data_points);
+
+  /**
+  * @brief Get the timestamp of a data point popped from the ring buffer
+  * @param record Data point record including its tag
+  * @return Timestamp written by startl
+  */
+  int64_t recordTime(const std::string &record) const;
+
+  /**
+  * @brief Push a record into the ring buffer and count it if it is dropped
+  * @param record Bytes to push
+  * @return True if the record was pushed
   */
-  static void resetStringstream(std::stringstream &ss);
+  bool pushRecord(const std::string &record);
 
   DataStreamConfig config_;      ///< Configuration
   boost::filesystem::path path_; ///< Data filepath
   std::chrono::time_point<std::chrono::high_resolution_clock>
-      last_write_time_; ///< Last time the buffer has been written to
+      last_write_time_; ///< Last time a data point has been completed
   std::fstream fs_;     ///< File stream that is written to
-  bool streaming_;      ///< Whether data is currently being recorded or not
-  std::stringstream buffer_;     ///< Stores several data points until they are
-                                 /// written to file stream
-  std::stringstream data_point_; ///< Stores the current data point while it is
-                                 /// written to the DataStream (i.e. while
-                                 /// streaming_ == true)
-  mutable boost::mutex buffer_mutex_; ///< Synchronize access to the buffer
+  std::unique_ptr<SegmentedFileWriter>
+      segment_writer_;      ///< Writes segment files instead of fs_ if not null
+  bool streaming_;          ///< Whether data is currently being recorded or not
+  bool file_data_point_;    ///< Whether the data point goes to the file
+  int64_t data_point_time_; ///< Timestamp of the current data point
+  std::unique_ptr<RecordRingBuffer>
+      ring_; ///< Stores completed data points until they are written to file
+  std::string data_point_; ///< Stores the current data point while it is
+                           /// written to the DataStream (i.e. while
+                           /// streaming_ == true)
+  std::string write_buffer_; ///< Record popped by the consumer
+  std::unique_ptr<binary_log::BlockEncoder>
+      block_encoder_; ///< Compresses records popped by the consumer
+  bool binary_;              ///< Whether the binary format is used
+  bool streaming_header_;    ///< Whether the current data point is a header
+  std::vector<std::string> header_names_; ///< Names of binary header columns
+  std::vector<binary_log::ColumnType>
+      binary_data_point_types_;  ///< Column types of current binary data point
+  bool binary_data_point_valid_; ///< False if non-numeric data was streamed
+  bool schema_written_;          ///< Whether the binary schema is written
+  binary_log::Schema schema_;    ///< Schema of the binary records
+  std::unique_ptr<TimeIndexWriter>
+      index_writer_;     ///< Time index of the file stream if enabled
+  uint64_t file_offset_; ///< Bytes written to the file stream
+  int64_t block_time_;   ///< Time of the first data point in current block
+  std::unique_ptr<TelemetryTap>
+      telemetry_tap_; ///< Mirrors popped records to shared memory if enabled
+  std::unique_ptr<FlightRecorder>
+      recorder_; ///< Full rate history of the stream if enabled
+  std::atomic<uint64_t>
+      dropped_data_points_; ///< Data points not matching the schema
+  std::atomic<uint64_t>
+      overflow_data_points_; ///< Data points dropped on a full ring buffer
+  std::atomic<uint64_t> writer_epoch_; ///< Odd while a data point is streamed
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Preallocated ring holding the most recent data points of a stream
+ * at full rate.
+ *
+ * Unlike RecordRingBuffer, recording never fails: the oldest data points are
+ * overwritten to make room for new ones. A snapshot of the data points
+ * recorded within the last duration seconds can be taken at any time, e.g.
+ * to dump the history around a fault. Recording costs a copy of the data
+ * point under an (uncontended) lock; the lock is held by snapshot only while
+ * the ring is copied.
+ */
+class FlightRecorder {
+public:
+  /**
+  * @brief Constructor
+  * @param capacity Size of the ring in bytes
+  * @param duration Time span of data points kept in snapshots in seconds
+  */
+  FlightRecorder(size_t capacity, double duration);
+
+  /**
+  * @brief Set the header written before the data points of a snapshot
+  * @param data Header bytes
+  * @param size Number of bytes
+  */
+  void setHeader(const char *data, size_t size);
+
+  /**
+  * @brief Copy a data point into the ring, overwriting the oldest data points
+  * if needed. Data points larger than the ring are dropped
+  * @param time Timestamp of the data point in high resolution clock ticks
+  * @param data Data point bytes
+  * @param size Number of bytes
+  */
+  void record(int64_t time, const char *data, size_t size);
+
+  /**
+  * @brief Copy the header and the data points recorded within duration of
+  * the newest data point
+  * @param header Replaced by the header
+  * @param data Replaced by the concatenated data points, oldest first
+  * @return Number of data points in the snapshot
+  */
+  size_t snapshot(std::string &header, std::string &data) const;
+
+  /**
+  * @brief Getter for capacity
+  * @return Size of the ring in bytes
+  */
+  size_t capacity() const;
+
+private:
+  /**
+  * @brief Bytes stored in front of each data point: time and size
+  */
+  static const size_t kEntryHeaderSize = sizeof(int64_t) + sizeof(uint32_t);
+
+  /**
+  * @brief Copy bytes into the ring starting at a position, wrapping around
+  * the end
+  * @param position Unwrapped write position
+  * @param data Bytes to copy
+  * @param size Number of bytes
+  */
+  void copyIn(uint64_t position, const char *data, size_t size);
+
+  /**
+  * @brief Copy bytes out of the ring starting at a position, wrapping around
+  * the end
+  * @param position Unwrapped read position
+  * @param data Buffer to fill
+  * @param size Number of bytes
+  */
+  void copyOut(uint64_t position, char *data, size_t size) const;
+
+  const size_t capacity_;        ///< Size of the ring in bytes
+  const int64_t duration_;       ///< Snapshot span in clock ticks
+  std::unique_ptr<char[]> ring_; ///< Ring storage
+  uint64_t head_;                ///< Total bytes recorded
+  uint64_t tail_;                ///< Start of the oldest data point kept
+  int64_t newest_time_;          ///< Timestamp of the newest data point
+  std::string header_;           ///< Header of the snapshots
+  mutable std::mutex mutex_;     ///< Guards the ring and the header
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "aerial_autonomy/log/binary_log_format.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace binary_log {
+
+/**
+ * @brief Appends values of arbitrary bit width to a byte string, most
+ * significant bit first
+ */
+class BitWriter {
+public:
+  /**
+  * @brief Constructor
+  */
+  BitWriter();
+
+  /**
+  * @brief Append the lowest bits of a value
+  * @param value Bits to append
+  * @param count Number of bits to append (at most 64)
+  */
+  void write(uint64_t value, unsigned count);
+
+  /**
+  * @brief Getter for written bytes. The last byte is padded with zeros
+  * @return Written bytes
+  */
+  const std::string &bytes() const;
+
+  /**
+  * @brief Remove all written bits
+  */
+  void clear();
+
+private:
+  std::string bytes_;  ///< Written bytes
+  unsigned free_bits_; ///< Number of unused bits in the last byte
+};
+
+/**
+ * @brief Reads values of arbitrary bit width written by BitWriter
+ */
+class BitReader {
+public:
+  /**
+  * @brief Constructor
+  * @param data Bytes to read. Must outlive the reader
+  * @param size Number of bytes
+  */
+  BitReader(const char *data, size_t size);
+
+  /**
+  * @brief Read the next bits
+  * @param count Number of bits to read (at most 64)
+  * @param value Bits read
+  * @return False if there are not enough bits left
+  */
+  bool read(unsigned count, uint64_t &value);
+
+private:
+  const uint8_t *data_; ///< Bytes to read
+  size_t size_;         ///< Number of bytes
+  size_t position_;     ///< Index of the next bit
+};
+
+/**
+ * @brief Compression state of a column, kept identically by BlockEncoder and
+ * BlockDecoder
+ */
+struct ColumnState {
+  /**
+   * @brief Constructor. Initial state at the start of a block
+   */
+  ColumnState();
+
+  uint64_t previous;       ///< Bits of the previous value
+  uint64_t previous_delta; ///< Previous delta of the timestamp column
+  unsigned leading;        ///< Leading zeros of the XOR window
+  unsigned trailing;       ///< Trailing zeros of the XOR window
+};
+
+/**
+ * @brief Compresses fixed-width binary records into independent blocks.
+ *
+ * Columns are compressed against their value in the previous record of the
+ * block, following the Gorilla time series encoding: the first column (the
+ * timestamp written by DataStream::startl) stores its delta-of-delta, other
+ * integer columns store zigzag varint deltas and floating point columns store
+ * the XOR with the previous value using a leading/trailing zero window.
+ * Slowly changing signals take a few bits per column.
+ *
+ * A block is the record count and the byte size (both uint32) followed by
+ * the compressed bits. Each block starts from a zero state, so blocks can be
+ * decoded without the rest of the file.
+ */
+class BlockEncoder {
+public:
+  /**
+  * @brief Constructor
+  * @param types Column types of the records
+  */
+  BlockEncoder(std::vector<ColumnType> types);
+
+  /**
+  * @brief Add a record to the current block
+  * @param record Fixed-width record with the column types of the encoder
+  */
+  void add(const char *record);
+
+  /**
+  * @brief Number of records in the current block
+  * @return Number of records
+  */
+  uint32_t recordCount() const;
+
+  /**
+  * @brief Finish the current block and start a new one
+  * @return Encoded block. Empty if the block has no records
+  */
+  std::string finish();
+
+private:
+  /**
+  * @brief Write the delta-of-delta of the timestamp column
+  * @param column Column state
+  * @param value Column value
+  */
+  void writeTimestamp(ColumnState &column, uint64_t value);
+
+  /**
+  * @brief Write the zigzag varint delta of an integer column
+  * @param column Column state
+  * @param value Column value
+  */
+  void writeInteger(ColumnState &column, uint64_t value);
+
+  /**
+  * @brief Write the XOR of a floating point column with its previous value
+  * @param column Column state
+  * @param value Bits of the column value
+  */
+  void writeDouble(ColumnState &column, uint64_t value);
+
+  std::vector<ColumnType> types_;    ///< Column types
+  std::vector<ColumnState> columns_; ///< Column states
+  BitWriter writer_;                 ///< Bits of the current block
+  uint32_t record_count_;            ///< Records in the current block
+};
+
+/**
+ * @brief Decompresses blocks written by BlockEncoder into fixed-width records
+ */
+class BlockDecoder {
+public:
+  /**
+  * @brief Constructor
+  * @param types Column types of the records
+  */
+  BlockDecoder(std::vector<ColumnType> types);
+
+  /**
+  * @brief Start decoding a block
+  * @param data Compressed bits of the block (without the block header). Must
+  * stay valid until the block is decoded
+  * @param size Number of bytes
+  * @param record_count Number of records in the block
+  */
+  void reset(const char *data, size_t size, uint32_t record_count);
+
+  /**
+  * @brief Decode the next record of the block
+  *
+  * Throws std::runtime_error if the block is corrupt
+  *
+  * @param record Buffer of Schema::recordSize bytes to fill
+  * @return False if all records of the block are decoded
+  */
+  bool next(char *record);
+
+private:
+  /**
+  * @brief Read bits from the block and throw if the block is corrupt
+  * @param count Number of bits
+  * @return Bits read
+  */
+  uint64_t read(unsigned count);
+
+  /**
+  * @brief Read the timestamp column
+  * @param column Column state
+  * @return Column value
+  */
+  uint64_t readTimestamp(ColumnState &column);
+
+  /**
+  * @brief Read an integer column
+  * @param column Column state
+  * @return Column value
+  */
+  uint64_t readInteger(ColumnState &column);
+
+  /**
+  * @brief Read a floating point column
+  * @param column Column state
+  * @return Bits of the column value
+  */
+  uint64_t readDouble(ColumnState &column);
+
+  std::vector<ColumnType> types_;    ///< Column types
+  std::vector<ColumnState> columns_; ///< Column states
+  BitReader reader_;                 ///< Bits of the current block
+  uint32_t record_count_;            ///< Records in the current block
+  uint32_t record_index_;            ///< Index of the next record
+};
+}
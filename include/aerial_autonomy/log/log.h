@@ -1,50 +1,88 @@
 #pragma once
 
-#include "aerial_autonomy/common/async_timer.h"
+#include "aerial_autonomy/common/profiled_mutex.h"
 #include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/log/stream_handle.h"
 
 #include "log_config.pb.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
-#include <boost/thread/recursive_mutex.hpp>
-
 /**
- * @brief Helper function to access a log stream and push a new start line
+ * @brief Helper function to access a log stream of the current Log and push
+ * a new start line. The stream can be given as a string id or as a
+ * StreamHandle
  */
-#define DATA_LOG(stream) (Log::instance()[stream] << DataStream::startl)
+#define DATA_LOG(stream) (Log::current()[stream] << DataStream::startl)
 /**
- * @brief Helper function to access a log stream and push a new start header
+ * @brief Helper function to access a log stream of the current Log and push
+ * a new start header. The stream can be given as a string id or as a
+ * StreamHandle
  */
-#define DATA_HEADER(stream) (Log::instance()[stream] << DataStream::starth)
+#define DATA_HEADER(stream) (Log::current()[stream] << DataStream::starth)
 
 /**
- * @brief Manages data log streams and a timer for periodically writing streams
- * to file
+ * @brief Manages data log streams and a writer thread for periodically
+ * draining stream buffers to file.
+ *
+ * Besides the process wide default instance, independent logs can be
+ * constructed explicitly, e.g. one per simulated vehicle. Each has its own
+ * directory, streams and writer thread, so the same stream ids can be used by
+ * several logs. A log is made current for a thread with LogContext; objects
+ * constructed in that context register their streams with it.
  */
 class Log {
 
 public:
   /**
-  * @brief Returns the only Log instance
-  * @return the Singleton instance
+  * @brief Returns the default Log instance
+  * @return the process wide instance
   */
   static Log &instance() {
-    // The only instance
     // Guaranteed to be lazy initialized
     // Guaranteed that it will be destroyed correctly
     static Log instance;
     return instance;
   }
 
+  /**
+  * @brief Returns the Log bound to the calling thread by a LogContext, or the
+  * default instance if there is none
+  * @return the current Log
+  */
+  static Log &current() {
+    return current_log_ ? *current_log_ : instance();
+  }
+
+  /**
+   * @brief Constructor for creating an unconfigured log. All streams are
+   * disabled until the log is configured
+   */
+  Log()
+      : config_(), writer_running_(false), dump_requested_(false),
+        dump_count_(0), recorder_dumps_(0), streams_mutex_("log_streams") {}
+
+  /**
+   * @brief Constructor for creating and configuring a log
+   * @param config The configuration
+   */
+  explicit Log(LogConfig config) : Log() { configure(config); }
+
   /**
   * @brief Destructor
   */
   ~Log();
 
   /**
-  * @brief Configure the Log instance
+  * @brief Configure the Log instance. Throws if the log directory is already
+  * used by another Log
   * @param config The configuration
   */
   void configure(LogConfig config);
@@ -56,6 +94,23 @@ public:
   */
   DataStream &operator[](std::string id);
 
+  /**
+  * @brief Index operator for retrieving a data stream from a handle. Does not
+  * lock or look up the stream id
+  * @param handle Handle returned by registerStream
+  * @return DataStream referred to by the handle
+  */
+  DataStream &operator[](const StreamHandle &handle) { return handle.stream(); }
+
+  /**
+  * @brief Get a handle to a data stream. The stream does not need to be
+  * configured yet; the handle refers to a disabled stream until it is.
+  * Registering the same id again returns an equivalent handle
+  * @param id ID of DataStream
+  * @return Handle to the stream
+  */
+  StreamHandle registerStream(std::string id);
+
   /**
   * @brief Add a data stream to the log
   * @param stream_config Configuration of the stream to add
@@ -68,6 +123,30 @@ public:
   */
   boost::filesystem::path directory();
 
+  /**
+  * @brief Report a fault to the flight recorder. The writer thread dumps the
+  * recorded history of all streams (see dumpRecorders); the call itself does
+  * not block on file I/O. Reports within recorder_dump_interval of the last
+  * accepted report are ignored
+  * @param reason Description of the fault
+  */
+  void requestRecorderDump(std::string reason);
+
+  /**
+  * @brief Write the flight recorder history of all streams into a new
+  * directory recorder_<n> inside the log directory
+  * @param reason Description of the fault
+  * @return Directory of the dump. Empty if no stream had recorded data
+  */
+  boost::filesystem::path dumpRecorders(std::string reason);
+
+  /**
+  * @brief Number of stream sets replaced by configure that are not freed yet
+  * (see freeRetiredStreams)
+  * @return Number of retired stream sets
+  */
+  size_t retiredStreams();
+
   /**
    * @brief Delete the copy constructor
    *
@@ -82,8 +161,25 @@ public:
   void operator=(Log const &) = delete;
 
 private:
+  friend class LogContext;
+
+  /**
+  * @brief Streams replaced by configure
+  */
+  struct RetiredStreams {
+    std::unordered_map<std::string, DataStream> streams; ///< Closed streams
+    std::chrono::steady_clock::time_point time; ///< Time of the replacement
+  };
+
   /**
-  * @brief Setup streams and start write timer
+  * @brief Claim a log directory for this log and release the previous one
+  * @param directory Directory to claim
+  * @return False if another log uses the directory
+  */
+  bool claimDirectory(const boost::filesystem::path &directory);
+
+  /**
+  * @brief Setup streams and start writer thread
   * @param config Log configuration
   */
   void configureStreams(LogConfig config);
@@ -94,12 +190,49 @@ private:
   void writeStreams();
 
   /**
-   * @brief Constructor for creating log
-   */
-  Log()
-      : config_(),
-        log_timer_(std::bind(&Log::writeStreams, std::ref(*this)),
-                   std::chrono::milliseconds(config_.write_duration())) {}
+  * @brief Free the retired streams that no thread can be writing to any
+  * more. Needs streams_mutex_ to be locked
+  *
+  * A thread streaming through a handle loads the stream before startl, so it
+  * may still use a stream that was replaced. A retired stream is freed once
+  * its producer is not inside a data point (even writer epoch) and a grace
+  * period has passed since the handles were repointed, which covers threads
+  * that loaded the stream just before the replacement.
+  */
+  void freeRetiredStreams();
+
+  /**
+  * @brief Get the disabled stream returned for unknown stream ids. Creates it
+  * if it does not exist. Needs streams_mutex_ to be locked
+  * @return Disabled stream that lives as long as the Log
+  */
+  DataStream &emptyStream();
+
+  /**
+  * @brief Point registered handles to the current streams. Needs
+  * streams_mutex_ to be locked
+  */
+  void rebindHandles();
+
+  /**
+  * @brief Start the writer thread
+  */
+  void startWriter();
+
+  /**
+  * @brief Stop the writer thread and wait for it to finish
+  */
+  void stopWriter();
+
+  /**
+  * @brief Writer thread loop. Drains all streams every write_duration
+  */
+  void writerLoop();
+
+  /**
+  * @brief Write the lock statistics to lock_profile.txt in the log directory
+  */
+  void writeLockReport();
 
   /**
    * @brief Config specifying streams and frequencies etc
@@ -110,9 +243,68 @@ private:
    */
   std::unordered_map<std::string, DataStream> streams_;
   /**
-   * @brief Timer to write log data
+   * @brief Disabled stream for unknown stream ids. Not part of streams_, so
+   * that handles can refer to it while the streams are replaced
+   */
+  std::unique_ptr<DataStream> empty_stream_;
+  /**
+   * @brief Streams replaced by configure. Moving the maps keeps the streams
+   * in place for threads still writing through a handle until they are freed
+   * by freeRetiredStreams
+   */
+  std::list<RetiredStreams> retired_streams_;
+  /**
+   * @brief Slots for registered stream handles. Slots are never removed so
+   * that handles stay valid
+   */
+  std::unordered_map<std::string, std::unique_ptr<std::atomic<DataStream *>>>
+      handle_slots_;
+  /**
+   * @brief Disk budget shared by the segment files of all streams
+   */
+  std::shared_ptr<DiskBudget> disk_budget_;
+  /**
+   * @brief Thread that writes log data
+   */
+  std::thread writer_thread_;
+  /**
+   * @brief True while the writer thread should keep running
+   */
+  bool writer_running_;
+  /**
+   * @brief Synchronize start/stop of the writer thread. Never taken by
+   * streaming threads
+   */
+  std::mutex writer_mutex_;
+  /**
+   * @brief Wakes up the writer thread when it is stopped or a recorder dump
+   * is requested
+   */
+  std::condition_variable writer_cv_;
+  /**
+   * @brief True if the writer thread should dump the flight recorders
+   */
+  bool dump_requested_;
+  /**
+   * @brief Fault reported with the pending recorder dump
    */
-  AsyncTimer log_timer_;
+  std::string dump_reason_;
+  /**
+   * @brief Number of accepted recorder dump requests
+   */
+  uint64_t dump_count_;
+  /**
+   * @brief Time of the last accepted recorder dump request
+   */
+  std::chrono::steady_clock::time_point last_dump_request_;
+  /**
+   * @brief Number of recorder dump directories created
+   */
+  std::atomic<uint64_t> recorder_dumps_;
+  /**
+  * @brief Time of the last lock report, used by the writer thread
+  */
+  std::chrono::steady_clock::time_point last_lock_report_;
   /**
    * @brief Log folder where logs are stored
    */
@@ -121,5 +313,41 @@ private:
    * @brief Ensure creation/access/configure/write all
    * are synced even called from multiple threads
    */
-  boost::recursive_mutex streams_mutex;
+  ProfiledRecursiveMutex streams_mutex_;
+  /**
+   * @brief Log bound to the current thread. Null for the default instance
+   */
+  static thread_local Log *current_log_;
+};
+
+/**
+ * @brief Makes a Log the current log of the calling thread for the lifetime
+ * of the context.
+ *
+ * DATA_LOG, DATA_HEADER and registerStream calls through Log::current() then
+ * use this log instead of the default instance. Contexts can be nested; the
+ * previous log is restored on destruction. The binding is not inherited by
+ * threads started in the context, but stream handles registered in it keep
+ * referring to its log from any thread.
+ */
+class LogContext {
+public:
+  /**
+  * @brief Bind a log to the calling thread
+  * @param log Log to bind. Has to outlive the context
+  */
+  explicit LogContext(Log &log) : previous_log_(Log::current_log_) {
+    Log::current_log_ = &log;
+  }
+
+  /**
+  * @brief Restore the previously bound log
+  */
+  ~LogContext() { Log::current_log_ = previous_log_; }
+
+  LogContext(const LogContext &) = delete;
+  LogContext &operator=(const LogContext &) = delete;
+
+private:
+  Log *previous_log_; ///< Log bound before this context
 };
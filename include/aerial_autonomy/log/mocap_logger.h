@@ -1,5 +1,7 @@
 #pragma once
 
+#include "aerial_autonomy/log/log.h"
+
 #include <geometry_msgs/TransformStamped.h>
 #include <ros/ros.h>
 
@@ -30,4 +32,8 @@ protected:
   * @brief Subscriber to get data from ros topic
   */
   ros::Subscriber mocap_sub_;
+  /**
+  * @brief Data stream for mocap data
+  */
+  StreamHandle log_stream_;
 };
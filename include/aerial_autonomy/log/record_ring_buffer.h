@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Bounded single-producer/single-consumer ring buffer of byte records.
+ *
+ * Each record is stored as a 32 bit length followed by the record bytes. A
+ * record is either pushed completely or not at all, so the consumer only ever
+ * sees whole records. push and pop are wait-free as long as there is exactly
+ * one producer thread and one consumer thread.
+ */
+class RecordRingBuffer {
+public:
+  /**
+  * @brief Constructor
+  * @param capacity Size of the ring in bytes
+  */
+  RecordRingBuffer(size_t capacity);
+
+  /**
+  * @brief Copy a record into the ring. Called by the producer.
+  * @param data Record bytes
+  * @param size Number of bytes in the record
+  * @return False if the ring does not have enough free space for the record
+  */
+  bool push(const char *data, size_t size);
+
+  /**
+  * @brief Remove the oldest record from the ring. Called by the consumer.
+  * @param record Replaced by the record bytes
+  * @return False if the ring is empty
+  */
+  bool pop(std::string &record);
+
+  /**
+  * @brief Getter for capacity
+  * @return Size of the ring in bytes
+  */
+  size_t capacity() const;
+
+private:
+  /**
+  * @brief Copy bytes into the ring starting at a position, wrapping around
+  * the end
+  * @param position Unwrapped write position
+  * @param data Bytes to copy
+  * @param size Number of bytes
+  */
+  void copyIn(uint64_t position, const char *data, size_t size);
+
+  /**
+  * @brief Copy bytes out of the ring starting at a position, wrapping around
+  * the end
+  * @param position Unwrapped read position
+  * @param data Buffer to fill
+  * @param size Number of bytes
+  */
+  void copyOut(uint64_t position, char *data, size_t size) const;
+
+  const size_t capacity_;        ///< Size of the ring in bytes
+  std::unique_ptr<char[]> ring_; ///< Ring storage
+  std::atomic<uint64_t> head_;   ///< Total bytes written by the producer
+  std::atomic<uint64_t> tail_;   ///< Total bytes read by the consumer
+};
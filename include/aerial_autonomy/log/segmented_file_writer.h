@@ -0,0 +1,160 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Tracks the segment files written by all streams of a Log and deletes
+ * the oldest closed segments when their total size exceeds a budget.
+ *
+ * Thread-safe; it is only accessed when segments are opened or closed.
+ */
+class DiskBudget {
+public:
+  /**
+  * @brief Constructor
+  * @param budget Maximum total size of segment files in bytes. Zero disables
+  * the budget
+  */
+  DiskBudget(uint64_t budget);
+
+  /**
+  * @brief Register a newly opened segment. Retires old segments if the budget
+  * is exceeded
+  * @param path Segment file path
+  * @param size Preallocated size of the segment in bytes
+  */
+  void openSegment(const boost::filesystem::path &path, uint64_t size);
+
+  /**
+  * @brief Mark a segment as closed so that it can be retired
+  * @param path Segment file path
+  * @param size Final size of the segment in bytes
+  */
+  void closeSegment(const boost::filesystem::path &path, uint64_t size);
+
+  /**
+  * @brief Total size of the tracked segments
+  * @return Size in bytes
+  */
+  uint64_t usage();
+
+private:
+  /**
+  * @brief Delete the oldest closed segments until the usage is within the
+  * budget. Needs mutex_ to be locked
+  */
+  void retireSegments();
+
+  /**
+  * @brief Segment file tracked by the budget
+  */
+  struct Segment {
+    boost::filesystem::path path; ///< File path
+    uint64_t size;                ///< Size on disk in bytes
+    bool open;                    ///< Whether the segment is being written
+  };
+
+  const uint64_t budget_;       ///< Maximum total size in bytes
+  uint64_t usage_;              ///< Current total size in bytes
+  std::list<Segment> segments_; ///< Segments in the order they were opened
+  std::mutex mutex_;            ///< Synchronizes streams sharing the budget
+};
+
+/**
+ * @brief Writes a byte stream into a sequence of preallocated, memory-mapped
+ * segment files named <path>.000000, <path>.000001, ...
+ *
+ * Writing a record is a memcpy into the mapped segment; the kernel writes
+ * dirty pages back in the background so there is no explicit flush. Records
+ * are never split across segments, and an optional segment header (such as a
+ * text header or a binary schema) is repeated at the start of every segment so
+ * that each segment can be read on its own. A segment is truncated to the size
+ * of its contents when it is closed.
+ */
+class SegmentedFileWriter {
+public:
+  /**
+  * @brief Constructor. Opens the first segment
+  * @param path Base path of the segment files
+  * @param segment_size Size of each segment in bytes
+  * @param disk_budget Budget shared between the streams of a Log. Can be null
+  */
+  SegmentedFileWriter(boost::filesystem::path path, uint64_t segment_size,
+                      std::shared_ptr<DiskBudget> disk_budget = nullptr);
+
+  /**
+  * @brief Destructor. Closes the current segment
+  */
+  ~SegmentedFileWriter();
+
+  /**
+  * @brief Append a record to the current segment. Rotates to a new segment if
+  * the record does not fit
+  * @param data Record bytes
+  * @param size Number of bytes
+  * @return False if the record was dropped because it does not fit in an
+  * empty segment or a new segment could not be opened
+  */
+  bool write(const char *data, size_t size);
+
+  /**
+  * @brief Append a header record to the current segment and repeat it at the
+  * start of every new segment
+  * @param data Header bytes
+  * @param size Number of bytes
+  * @return False if the header was dropped because it does not fit in a
+  * segment or a new segment could not be opened
+  */
+  bool writeHeader(const char *data, size_t size);
+
+  /**
+  * @brief Number of segments opened so far
+  * @return Number of segments
+  */
+  unsigned segmentCount() const;
+
+  /**
+  * @brief Get the path of a segment file
+  * @param path Base path of the segment files
+  * @param index Segment index
+  * @return Segment file path
+  */
+  static boost::filesystem::path
+  segmentPath(const boost::filesystem::path &path, unsigned index);
+
+  /**
+   * @brief Delete the copy constructor
+   */
+  SegmentedFileWriter(const SegmentedFileWriter &) = delete;
+  /**
+   * @brief Delete assign operator
+   */
+  void operator=(const SegmentedFileWriter &) = delete;
+
+private:
+  /**
+  * @brief Create, preallocate and map the next segment file
+  * @return False if the segment could not be opened
+  */
+  bool openSegment();
+
+  /**
+  * @brief Unmap the current segment and truncate it to its contents
+  */
+  void closeSegment();
+
+  boost::filesystem::path path_;            ///< Base path of segment files
+  const uint64_t segment_size_;             ///< Size of each segment in bytes
+  std::shared_ptr<DiskBudget> disk_budget_; ///< Shared disk budget
+  std::string segment_header_;              ///< Written at start of segments
+  int fd_;                                  ///< Current segment file
+  char *map_;                               ///< Mapping of current segment
+  uint64_t offset_;                         ///< Bytes used in current segment
+  unsigned segment_count_;                  ///< Number of segments opened
+};
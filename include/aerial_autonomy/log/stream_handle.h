@@ -0,0 +1,36 @@
+#pragma once
+
+#include "aerial_autonomy/log/data_stream.h"
+
+#include <atomic>
+
+/**
+ * @brief Pre-resolved reference to a Log data stream.
+ *
+ * Handles are obtained from Log::registerStream, typically when a controller
+ * or estimator is constructed. Accessing the stream through a handle is a
+ * single atomic load instead of a string lookup under the Log mutex. The Log
+ * rebinds registered handles when streams are (re)configured, so a handle
+ * stays valid for the lifetime of the Log.
+ */
+class StreamHandle {
+public:
+  /**
+  * @brief Get the data stream this handle refers to. Returns a disabled
+  * stream if the stream id is not configured in the Log
+  * @return Data stream
+  */
+  DataStream &stream() const {
+    return *slot_->load(std::memory_order_acquire);
+  }
+
+private:
+  friend class Log;
+  /**
+  * @brief Constructor. Only the Log creates handles
+  * @param slot Slot owned by the Log which holds the current stream
+  */
+  explicit StreamHandle(std::atomic<DataStream *> *slot) : slot_(slot) {}
+
+  std::atomic<DataStream *> *slot_; ///< Current stream for the handle's id
+};
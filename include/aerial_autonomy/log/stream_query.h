@@ -0,0 +1,43 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Time window and column subset to extract from a stream file
+ */
+struct StreamQuery {
+  /**
+   * @brief Constructor. Queries all data points and columns
+   */
+  StreamQuery();
+
+  int64_t start;                    ///< First timestamp to extract
+  int64_t end;                      ///< Last timestamp to extract
+  std::vector<std::string> columns; ///< Header names to extract. All if empty
+  std::string delimiter;            ///< Delimiter of text stream files
+};
+
+/**
+ * @brief Extract a time window and a subset of columns from a text, binary or
+ * compressed stream file as delimiter separated text.
+ *
+ * If the stream file has a time index (see TimeIndexWriter), reading starts
+ * at the last indexed record before the window instead of the start of the
+ * file. Data points are assumed to be in time order, so reading stops at the
+ * first data point after the window.
+ *
+ * Throws std::runtime_error if the file cannot be read or a column does not
+ * exist
+ *
+ * @param path Path of the stream file
+ * @param query Time window and columns to extract
+ * @param out Stream to write the header and the extracted data points to
+ * @return Number of extracted data points
+ */
+uint64_t queryStream(const boost::filesystem::path &path,
+                     const StreamQuery &query, std::ostream &out);
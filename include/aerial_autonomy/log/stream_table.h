@@ -0,0 +1,58 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Data points of a stream file loaded into memory, with every column
+ * converted to double
+ */
+struct StreamTable {
+  std::vector<std::string> names;        ///< Header names, starting with #Time
+  std::vector<int64_t> times;            ///< Timestamp of each data point
+  std::vector<std::vector<double>> rows; ///< Columns of each data point
+
+  /**
+  * @brief Find a column by its header name
+  *
+  * Throws std::runtime_error if the column does not exist
+  *
+  * @param name Header name
+  * @return Index of the column in the rows
+  */
+  size_t column(const std::string &name) const;
+
+  /**
+  * @brief Time of a data point relative to the first data point
+  * @param row Index of the data point
+  * @return Time in seconds
+  */
+  double seconds(size_t row) const;
+
+  /**
+  * @brief Find the data point closest to a timestamp. Data points are
+  * assumed to be in time order
+  * @param time Timestamp in the units of the #Time column
+  * @return Index of the data point or rows.size() if there is none
+  */
+  size_t nearestRow(int64_t time) const;
+};
+
+/**
+ * @brief Load a text, binary or compressed stream file into memory.
+ *
+ * If the stream was logged with the MMAP_SEGMENTS backend, the segments left
+ * on disk (see SegmentedFileWriter::segmentPath) are loaded in order instead.
+ * Data points with fewer columns than the header are skipped.
+ *
+ * Throws std::runtime_error if neither the file nor any segment can be read
+ *
+ * @param path Path of the stream file, i.e. log directory / stream id
+ * @param delimiter Delimiter of text stream files
+ * @return Loaded data points
+ */
+StreamTable readStreamTable(const boost::filesystem::path &path,
+                            const std::string &delimiter = ",");
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "aerial_autonomy/log/binary_log_format.h"
+#include "aerial_autonomy/log/telemetry_tap.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reads the records of a live DataStream from the shared memory ring
+ * of a TelemetryTap.
+ *
+ * The reader starts at the newest record when it is opened and never blocks
+ * the writer. If the reader falls more than a ring behind, the records it
+ * missed are counted by lostRecords. Readers in any number of processes can
+ * observe the same tap.
+ */
+class TelemetryReader {
+public:
+  /**
+  * @brief Constructor. Maps the shared memory object of a tap
+  *
+  * Throws std::runtime_error if the tap does not exist or is not a telemetry
+  * ring
+  *
+  * @param name Tap name as configured for the stream
+  */
+  TelemetryReader(std::string name);
+
+  /**
+  * @brief Destructor
+  */
+  ~TelemetryReader();
+
+  /**
+  * @brief Check the record format
+  * @return True if records are binary, false if they are delimiter separated
+  * text
+  */
+  bool binary() const;
+
+  /**
+  * @brief Check if the tap was closed, e.g. because the Log was reconfigured.
+  * A closed tap does not publish any more records
+  * @return True if the tap is closed
+  */
+  bool closed() const;
+
+  /**
+  * @brief Get the column names of the stream
+  * @return Header names. Empty if the stream has no header (yet)
+  */
+  std::vector<std::string> names();
+
+  /**
+  * @brief Read the next raw record
+  * @param record Text line or fixed-width binary record
+  * @return False if there is no new record
+  */
+  bool next(std::string &record);
+
+  /**
+  * @brief Read the next record and convert all its columns to doubles
+  * @param values Column values, starting with the timestamp
+  * @return False if there is no new record
+  */
+  bool next(std::vector<double> &values);
+
+  /**
+  * @brief Number of records overwritten before they could be read
+  * @return Number of lost records
+  */
+  uint64_t lostRecords() const;
+
+  /**
+  * @brief Delete the copy constructor
+  */
+  TelemetryReader(const TelemetryReader &) = delete;
+  /**
+  * @brief Delete assign operator
+  */
+  void operator=(const TelemetryReader &) = delete;
+
+private:
+  /**
+  * @brief Copy the header area if it changed since the last call
+  * @return False if the header could not be copied consistently
+  */
+  bool updateHeader();
+
+  size_t size_;                       ///< Size of the mapping
+  const char *map_;                   ///< Mapping of the shared memory object
+  const telemetry::RingHeader *ring_; ///< Ring header in the mapping
+  uint64_t next_;                     ///< Index of the next record to read
+  uint64_t lost_records_;             ///< Records overwritten before reading
+  uint64_t header_sequence_;          ///< Sequence of the copied header
+  std::string header_;                ///< Copied header
+  binary_log::Schema schema_;         ///< Schema of binary records
+};
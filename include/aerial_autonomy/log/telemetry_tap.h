@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Layout of the shared-memory telemetry ring shared by TelemetryTap
+ * and TelemetryReader.
+ *
+ * The shared memory object holds a RingHeader, a header area of slot_size
+ * bytes and slot_count slots of sizeof(Slot) + slot_size bytes. Record n is
+ * stored in slot n % slot_count. Every slot and the header area are guarded by
+ * a sequence number (seqlock): it is odd while the writer copies a record and
+ * 2 * (n + 1) once record n is complete, so readers never block the writer and
+ * detect when a slot was overwritten while they copied it.
+ */
+namespace telemetry {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared memory telemetry needs address-free 64 bit atomics");
+
+/**
+ * @brief Magic bytes identifying a telemetry ring
+ */
+const char kMagic[4] = {'A', 'A', 'T', 'M'};
+
+/**
+ * @brief Version of the ring layout
+ */
+const uint32_t kVersion = 1;
+
+/**
+ * @brief Maximum delimiter length stored in the ring header
+ */
+const size_t kMaxDelimiterSize = 15;
+
+/**
+ * @brief Start of the shared memory object
+ */
+struct RingHeader {
+  char magic[4];                         ///< Identifies a telemetry ring
+  uint32_t version;                      ///< Layout version
+  uint32_t slot_count;                   ///< Number of record slots
+  uint32_t slot_size;                    ///< Maximum record size in bytes
+  uint8_t binary;                        ///< Whether records are binary
+  char delimiter[kMaxDelimiterSize + 1]; ///< Text delimiter
+  std::atomic<uint32_t> open;            ///< Cleared when the tap closes
+  std::atomic<uint64_t> head;            ///< Number of records published
+  std::atomic<uint64_t> header_sequence; ///< Seqlock of the header area
+  uint32_t header_size;                  ///< Bytes in the header area
+};
+
+/**
+ * @brief Start of a record slot. Followed by slot_size record bytes
+ */
+struct Slot {
+  std::atomic<uint64_t> sequence; ///< Seqlock of the slot
+  uint32_t size;                  ///< Bytes in the slot
+};
+
+/**
+ * @brief Offset of the header area in the shared memory object
+ * @return Offset in bytes
+ */
+size_t headerOffset();
+
+/**
+ * @brief Offset of a record slot in the shared memory object. Slots are 8 byte
+ * aligned
+ * @param slot_size Maximum record size in bytes
+ * @param index Slot index. The size of the object for index == slot_count
+ * @return Offset in bytes
+ */
+size_t slotOffset(uint32_t slot_size, uint64_t index);
+
+/**
+ * @brief Name of the shared memory object for a tap
+ * @param name Tap name as configured for the stream
+ * @return Name passed to shm_open
+ */
+std::string shmName(const std::string &name);
+}
+
+/**
+ * @brief Mirrors the records of a DataStream into a named POSIX shared
+ * memory ring so that local tools can observe them live (see
+ * TelemetryReader).
+ *
+ * The tap is written by the DataStream consumer (the Log writer thread), so
+ * it adds no work to the threads streaming data. There is a single writer;
+ * slow readers lose old records instead of blocking it. Tap names are
+ * exclusive: the shared memory object is created by the tap and removed when
+ * it is destroyed.
+ */
+class TelemetryTap {
+public:
+  /**
+  * @brief Constructor. Creates the shared memory object
+  *
+  * Throws std::runtime_error if the shared memory object cannot be created,
+  * e.g. because another tap (or a crashed process) uses the name
+  *
+  * @param name Tap name. The shared memory object is telemetry::shmName(name)
+  * @param slot_count Number of records kept in the ring
+  * @param slot_size Maximum record size in bytes. Larger records are dropped
+  * @param binary Whether records are binary or delimiter separated text
+  * @param delimiter Delimiter of text records
+  */
+  TelemetryTap(std::string name, uint32_t slot_count, uint32_t slot_size,
+               bool binary, std::string delimiter);
+
+  /**
+  * @brief Destructor. Marks the ring closed and removes the shared memory
+  * object
+  */
+  ~TelemetryTap();
+
+  /**
+  * @brief Publish a data point record
+  * @param data Record bytes
+  * @param size Number of bytes
+  * @return False if the record is larger than a slot
+  */
+  bool publish(const char *data, size_t size);
+
+  /**
+  * @brief Replace the header (text header or binary schema) of the ring
+  * @param data Header bytes
+  * @param size Number of bytes
+  * @return False if the header is larger than a slot
+  */
+  bool publishHeader(const char *data, size_t size);
+
+  /**
+  * @brief Delete the copy constructor
+  */
+  TelemetryTap(const TelemetryTap &) = delete;
+  /**
+  * @brief Delete assign operator
+  */
+  void operator=(const TelemetryTap &) = delete;
+
+private:
+  std::string shm_name_;        ///< Name of the shared memory object
+  size_t size_;                 ///< Size of the mapping
+  char *map_;                   ///< Mapping of the shared memory object
+  telemetry::RingHeader *ring_; ///< Ring header in the mapping
+  uint64_t head_;               ///< Number of records published
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/**
+ * @brief Writes a sparse time index next to a stream file.
+ *
+ * The index maps the timestamp of every interval-th data point to the byte
+ * offset of its record in the stream file, so that a reader can seek close to
+ * a time without parsing the file. The index file starts with a magic and a
+ * version followed by entries of an int64 timestamp and a uint64 offset in
+ * native byte order. Entries are in the order the records were written.
+ */
+class TimeIndexWriter {
+public:
+  /**
+  * @brief Constructor
+  *
+  * Throws std::runtime_error if the index file cannot be opened
+  *
+  * @param path Path of the index file
+  * @param interval Number of data points between index entries
+  */
+  TimeIndexWriter(boost::filesystem::path path, unsigned interval);
+
+  /**
+  * @brief Register a record written to the stream file. Adds an index entry
+  * if interval data points were registered since the last entry
+  * @param time Timestamp of the first data point in the record
+  * @param offset Byte offset of the record in the stream file
+  * @param data_points Number of data points in the record
+  */
+  void add(int64_t time, uint64_t offset, uint32_t data_points = 1);
+
+  /**
+  * @brief Flush index entries to file
+  */
+  void flush();
+
+  /**
+  * @brief Get the path of the index file for a stream file
+  * @param stream_path Path of the stream file
+  * @return Index file path
+  */
+  static boost::filesystem::path
+  indexPath(const boost::filesystem::path &stream_path);
+
+private:
+  std::ofstream fs_;        ///< Index file
+  const unsigned interval_; ///< Data points between index entries
+  unsigned since_entry_;    ///< Data points since the last entry
+};
+
+/**
+ * @brief Reads a time index written by TimeIndexWriter
+ */
+class TimeIndex {
+public:
+  /**
+  * @brief Constructor. Loads all index entries.
+  *
+  * Throws std::runtime_error if the file cannot be opened or is not an index
+  *
+  * @param path Path of the index file
+  */
+  TimeIndex(boost::filesystem::path path);
+
+  /**
+  * @brief Find the offset to start reading from to get all data points at or
+  * after a time. Binary search over the index entries
+  * @param time Timestamp to seek to
+  * @param offset Byte offset of the last indexed record before time
+  * @return False if no indexed record is before time
+  */
+  bool seek(int64_t time, uint64_t &offset) const;
+
+  /**
+  * @brief Number of index entries
+  * @return Number of entries
+  */
+  size_t size() const;
+
+private:
+  /**
+  * @brief Index entry
+  */
+  struct Entry {
+    int64_t time;    ///< Timestamp of the indexed record
+    uint64_t offset; ///< Byte offset of the indexed record
+  };
+
+  std::vector<Entry> entries_; ///< Index entries in file order
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#define TRACE_SPAN_CONCAT_(a, b) a##b
+#define TRACE_SPAN_VARIABLE_(line) TRACE_SPAN_CONCAT_(trace_span_, line)
+/**
+ * @brief Trace the rest of the enclosing scope as a span with the given name.
+ * The name must outlive the tracer, i.e. be a string literal or a name
+ * returned by Tracer::intern
+ */
+#define TRACE_SPAN(name) TraceSpan TRACE_SPAN_VARIABLE_(__LINE__)(name)
+
+/**
+ * @brief Collects timed spans from all threads and exports them as Chrome
+ * trace-event JSON, viewable in chrome://tracing or Perfetto.
+ *
+ * Each thread records into its own preallocated ring, so recording a span is
+ * two clock reads and a few relaxed stores without any lock. When a ring is
+ * full the oldest spans are overwritten. Export copies the rings while
+ * threads keep recording and drops the spans overwritten during the copy.
+ * Tracing is disabled by default; a disabled span costs one atomic load.
+ */
+class Tracer {
+public:
+  /**
+  * @brief Get the process wide tracer. Never destroyed so that spans can be
+  * recorded during static destruction
+  */
+  static Tracer &instance();
+
+  /**
+  * @brief Start recording spans
+  * @param events_per_thread Size of the ring of threads that record their
+  * first span after this call
+  */
+  void enable(size_t events_per_thread = 16384);
+
+  /**
+  * @brief Stop recording spans. Recorded spans are kept for export
+  */
+  void disable();
+
+  /**
+  * @brief Check if spans are recorded
+  * @return True if enabled
+  */
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+  * @brief Keep a copy of a name alive for the lifetime of the process so it
+  * can be used for spans
+  * @param name Name to intern
+  * @return Pointer to the interned name, the same for equal names
+  */
+  const char *intern(const std::string &name);
+
+  /**
+  * @brief Name the calling thread in exported traces
+  * @param name Thread name
+  */
+  void setThreadName(const std::string &name);
+
+  /**
+  * @brief Record a finished span of the calling thread. Ignored if disabled
+  * @param name Span name, must outlive the tracer
+  * @param start Start time from now()
+  * @param end End time from now()
+  */
+  void record(const char *name, int64_t start, int64_t end);
+
+  /**
+  * @brief Write the recorded spans of all threads as Chrome trace-event JSON
+  * @param os Output stream
+  * @return Number of spans written
+  */
+  size_t writeChromeTrace(std::ostream &os);
+
+  /**
+  * @brief Write the recorded spans of all threads to a Chrome trace-event
+  * JSON file
+  * @param file Path of the file
+  * @return Number of spans written
+  */
+  size_t writeChromeTrace(const boost::filesystem::path &file);
+
+  /**
+  * @brief Current time used for spans
+  * @return Steady clock time in nanoseconds
+  */
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+private:
+  /**
+  * @brief Spans of one thread
+  */
+  struct Ring;
+  /**
+  * @brief Tracing state of a thread
+  */
+  struct ThreadState;
+
+  /**
+  * @brief Constructor
+  */
+  Tracer();
+
+  /**
+  * @brief Get the ring of the calling thread, creating it if needed
+  * @return Ring of the calling thread
+  */
+  Ring &threadRing();
+
+  /**
+  * @brief Maximum number of rings of exited threads kept for export
+  */
+  static const size_t kMaxRetiredRings = 64;
+
+  std::atomic<bool> enabled_;   ///< True when recording
+  std::atomic<int64_t> origin_; ///< Time of the first enable
+  size_t events_per_thread_;    ///< Size of new rings
+  std::vector<std::shared_ptr<Ring>> rings_; ///< Rings of all threads
+  std::set<std::string> names_;              ///< Interned names
+  int next_thread_id_;                       ///< Id of the next ring
+  std::mutex mutex_; ///< Guards the rings, names and thread names
+  static thread_local ThreadState thread_state_; ///< State of this thread
+};
+
+/**
+ * @brief Records the lifetime of the object as a span of the calling thread
+ */
+class TraceSpan {
+public:
+  /**
+  * @brief Constructor starts the span
+  * @param name Span name, must outlive the tracer
+  */
+  explicit TraceSpan(const char *name)
+      : name_(name),
+        start_(Tracer::instance().enabled() ? Tracer::now() : -1) {}
+
+  /**
+  * @brief Destructor records the span
+  */
+  ~TraceSpan() {
+    if (start_ >= 0) {
+      Tracer::instance().record(name_, start_, Tracer::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  const char *name_; ///< Span name
+  int64_t start_;    ///< Start time, negative if tracing was disabled
+};
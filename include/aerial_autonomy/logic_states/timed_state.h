@@ -6,6 +6,7 @@
  * system
  */
 
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/logic_states/base_state.h"
 #include <chrono>
 
@@ -23,7 +24,7 @@ public:
   template <class Event, class FSM> void on_entry(Event const &e, FSM &fsm) {
     BaseState<RobotSystemT, LogicStateMachineT, ActionFctr>::on_entry(e, fsm);
     // log start time
-    entry_time_ = std::chrono::high_resolution_clock::now();
+    entry_time_ = Clock::instance().now();
   }
 
   /**
@@ -31,8 +32,7 @@ public:
   * @return The amount of time spent in the state
   */
   std::chrono::duration<double> timeInState() {
-    return std::chrono::duration<double>(
-        std::chrono::high_resolution_clock::now() - entry_time_);
+    return std::chrono::duration<double>(Clock::instance().now() - entry_time_);
   }
 
   /**
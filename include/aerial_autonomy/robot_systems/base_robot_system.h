@@ -5,8 +5,19 @@
 #include <aerial_autonomy/common/type_map.h>
 // Iterable Enum
 #include <aerial_autonomy/common/iterable_enum.h>
-// Boost thread stuff
-#include <boost/thread/mutex.hpp>
+// Flight recorder dumps
+#include <aerial_autonomy/log/log.h>
+// Profiled mutexes
+#include <aerial_autonomy/common/profiled_mutex.h>
+// Active controller table
+#include <array>
+#include <atomic>
+#include <thread>
+// Deadline watchdog
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
 // Unique ptr
 #include <memory>
 
@@ -23,25 +34,206 @@ protected:
 
 private:
   /**
-  * @brief Map to store active controller based on controller group
+  * @brief Active connector of a controller group.
+  *
+  * The runner of the group never waits: it marks its run in the epoch and
+  * reads the connector pointer. A switch publishes the new pointer and
+  * then waits for the run in progress, if any, to end, so that once a
+  * switch returns the previous connector is no longer running.
+  */
+  struct ActiveController {
+    /**
+    * @brief Active connector, null if none
+    */
+    std::atomic<AbstractControllerConnector *> connector;
+    /**
+    * @brief Incremented when a run starts and when it ends, so it is odd
+    * while a run is in progress
+    */
+    std::atomic<uint64_t> run_epoch;
+    /**
+    * @brief Serializes switches of the group
+    */
+    ProfiledMutex switch_mutex{"controller_switch"};
+  };
+
+  /**
+  * @brief Ends a run of a controller group, also if the run throws
+  */
+  struct RunGuard {
+    /**
+    * @brief Constructor
+    * @param active_controller Table entry of the running group
+    * @param epoch Odd epoch of the run
+    */
+    RunGuard(ActiveController &active_controller, uint64_t epoch)
+        : active_controller(active_controller), epoch(epoch) {
+      runningGroup() = &active_controller;
+    }
+    /**
+    * @brief Destructor publishes the end of the run
+    */
+    ~RunGuard() {
+      runningGroup() = nullptr;
+      active_controller.run_epoch.store(epoch + 1);
+    }
+    ActiveController &active_controller; ///< Table entry of the group
+    const uint64_t epoch;                ///< Epoch of the run
+  };
+
+  /**
+  * @brief Number of controller groups
+  */
+  static const size_t kControllerGroups =
+      static_cast<size_t>(ControllerGroup::Last) + 1;
+
+  /**
+  * @brief Active connector of each controller group, indexed by group
+  */
+  std::array<ActiveController, kControllerGroups> active_controllers_;
+
+  /**
+  * @brief Get the table entry of a controller group
+  * @param controller_group Group to look up
+  * @return Active connector of the group
+  */
+  ActiveController &activeController(ControllerGroup controller_group) {
+    return active_controllers_[static_cast<size_t>(controller_group)];
+  }
+
+  /**
+  * @brief Get the table entry of a controller group
+  * @param controller_group Group to look up
+  * @return Active connector of the group
+  */
+  const ActiveController &
+  activeController(ControllerGroup controller_group) const {
+    return active_controllers_[static_cast<size_t>(controller_group)];
+  }
+
+  /**
+  * @brief Table entry of the group run by the calling thread
+  * @return Reference to the entry, null outside runs
+  */
+  static const ActiveController *&runningGroup() {
+    static thread_local const ActiveController *running_group = nullptr;
+    return running_group;
+  }
+
+  /**
+  * @brief Wait for the run of a group that is in progress, if any, to end.
+  * Must be called after publishing a new connector pointer: later runs
+  * read the new pointer. Does not wait when called from the run itself
+  * @param active_controller Table entry of the group
+  */
+  static void waitForRun(const ActiveController &active_controller) {
+    if (runningGroup() == &active_controller) {
+      return;
+    }
+    uint64_t epoch = active_controller.run_epoch.load();
+    while ((epoch & 1) && active_controller.run_epoch.load() == epoch) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  /**
+  * @brief Compute deadline of a connector and the fallback engaged when the
+  * connector keeps missing it
+  */
+  struct DeadlineWatchdog {
+    ControllerGroup group;                 ///< Group of the connector
+    std::chrono::duration<double> deadline; ///< Maximum run time
+    unsigned max_missed; ///< Consecutive misses that engage the fallback
+    std::function<void()> engage_fallback; ///< Activates the fallback
+    unsigned missed;         ///< Current number of consecutive misses
+    bool tripped;            ///< True once the fallback has been engaged
+    std::string description; ///< Reason for engaging the fallback
+  };
+  /**
+  * @brief Deadline watchdogs by connector
+  */
+  std::map<const AbstractControllerConnector *, DeadlineWatchdog>
+      deadline_watchdogs_;
+  /**
+  * @brief Guards the state of the deadline watchdogs
+  */
+  mutable ProfiledMutex watchdog_mutex_{"controller_watchdog"};
+  /**
+  * @brief Log whose flight recorder is dumped when a deadline watchdog trips.
+  * Captured at construction since the connectors run on timer threads
+  */
+  Log &log_;
+  /**
+  * @brief Functions applying the execution period of the active connector
+  * to the timer of each controller group
   */
-  std::map<ControllerGroup, AbstractControllerConnector *> active_controllers_;
+  std::map<ControllerGroup, std::function<void(std::chrono::duration<double>)>>
+      execution_period_callbacks_;
   /**
-  * @brief Map to lock and swap the active controller for a given
-  * controller group
+  * @brief Guards the execution period callbacks
   */
-  std::map<ControllerGroup, std::unique_ptr<boost::mutex>> thread_mutexes_;
+  ProfiledMutex execution_period_mutex_{"controller_execution_period"};
+
+  /**
+  * @brief Pass the execution period of a newly active connector to the timer
+  * of its group
+  * @param controller_group Group of the connector
+  * @param period Period of the connector, zero for the group timer period
+  */
+  void applyExecutionPeriod(ControllerGroup controller_group,
+                            std::chrono::duration<double> period) {
+    std::lock_guard<ProfiledMutex> lock(execution_period_mutex_);
+    auto callback = execution_period_callbacks_.find(controller_group);
+    if (callback != execution_period_callbacks_.end() && callback->second) {
+      callback->second(period);
+    }
+  }
+
+  /**
+  * @brief Count a missed deadline if a run took too long
+  * @param connector Connector that ran
+  * @param run_time Duration of the run
+  * @return Function engaging the fallback if the connector has missed too
+  * many deadlines, otherwise null
+  */
+  std::function<void()>
+  checkDeadline(const AbstractControllerConnector *connector,
+                std::chrono::duration<double> run_time) {
+    auto it = deadline_watchdogs_.find(connector);
+    if (it == deadline_watchdogs_.end()) {
+      return nullptr;
+    }
+    DeadlineWatchdog &watchdog = it->second;
+    std::lock_guard<ProfiledMutex> lock(watchdog_mutex_);
+    if (watchdog.tripped) {
+      return nullptr;
+    }
+    if (run_time <= watchdog.deadline) {
+      watchdog.missed = 0;
+      return nullptr;
+    }
+    if (++watchdog.missed < watchdog.max_missed) {
+      return nullptr;
+    }
+    std::stringstream description;
+    description << "Missed " << watchdog.missed << " compute deadlines of "
+                << watchdog.deadline.count() * 1e3 << " ms, last run took "
+                << run_time.count() * 1e3 << " ms. Switched to fallback";
+    watchdog.tripped = true;
+    watchdog.description = description.str();
+    LOG(ERROR) << "Deadline watchdog: " << watchdog.description;
+    log_.requestRecorderDump("Deadline watchdog");
+    return watchdog.engage_fallback;
+  }
 
 public:
   /**
-  * @brief Constructor to initialize active controllers and mutexes to NULL
+  * @brief Constructor to initialize active controllers to NULL
   */
-  BaseRobotSystem() {
-    // Initialize active controller map
-    for (auto controller_group : IterableEnum<ControllerGroup>()) {
-      active_controllers_.emplace(controller_group, nullptr);
-      thread_mutexes_[controller_group] =
-          std::unique_ptr<boost::mutex>(new boost::mutex);
+  BaseRobotSystem() : log_(Log::current()) {
+    for (auto &active_controller : active_controllers_) {
+      active_controller.connector.store(nullptr);
+      active_controller.run_epoch.store(0);
     }
   }
 
@@ -70,11 +262,72 @@ public:
     }
     // Initialize and swap
     {
-      boost::mutex::scoped_lock lock(*thread_mutexes_[controller_group]);
+      ActiveController &active_controller = activeController(controller_group);
+      std::lock_guard<ProfiledMutex> lock(active_controller.switch_mutex);
+      if (active_controller.connector.load() == controller_connector) {
+        // Stop running the connector while it is initialized again
+        active_controller.connector.store(nullptr);
+        waitForRun(active_controller);
+      }
       VLOG(1) << "Initializing";
       controller_connector->initialize();
-      active_controllers_[controller_group] = controller_connector;
+      active_controller.connector.store(controller_connector);
+      waitForRun(active_controller);
     }
+    auto watchdog = deadline_watchdogs_.find(controller_connector);
+    if (watchdog != deadline_watchdogs_.end()) {
+      std::lock_guard<ProfiledMutex> lock(watchdog_mutex_);
+      watchdog->second.missed = 0;
+      watchdog->second.tripped = false;
+    }
+    applyExecutionPeriod(controller_group,
+                         controller_connector->getExecutionPeriod());
+  }
+
+  /**
+  * @brief Set the function that changes the period of the timer running a
+  * controller group. It is called with the execution period of every
+  * connector activated in the group, where zero stands for the default period
+  * of the timer
+  *
+  * @param controller_group Group run by the timer
+  * @param callback Function setting the timer period, or null to stop
+  * calling
+  */
+  void setExecutionPeriodCallback(
+      ControllerGroup controller_group,
+      std::function<void(std::chrono::duration<double>)> callback) {
+    std::lock_guard<ProfiledMutex> lock(execution_period_mutex_);
+    execution_period_callbacks_[controller_group] = callback;
+  }
+
+  /**
+  * @brief Enforce a compute deadline on a connector. A run cannot be
+  * interrupted, so the watchdog acts once a run has returned: when the
+  * connector has missed the deadline in a given number of consecutive runs,
+  * the fallback is engaged. Until the connector is activated again, its
+  * status is critical with the reason for the switch. Must be called before
+  * the controllers run
+  *
+  * @param connector Connector to watch
+  * @param deadline Maximum duration of a run of the connector
+  * @param max_missed Number of consecutive missed deadlines that engage the
+  * fallback
+  * @param engage_fallback Function that sets the goal of a cheaper fallback
+  * connector and activates it, e.g. to hover in place
+  */
+  void setDeadlineWatchdog(const AbstractControllerConnector *connector,
+                           std::chrono::duration<double> deadline,
+                           unsigned max_missed,
+                           std::function<void()> engage_fallback) {
+    DeadlineWatchdog watchdog;
+    watchdog.group = connector->getControllerGroup();
+    watchdog.deadline = deadline;
+    watchdog.max_missed = std::max(max_missed, 1u);
+    watchdog.engage_fallback = engage_fallback;
+    watchdog.missed = 0;
+    watchdog.tripped = false;
+    deadline_watchdogs_[connector] = watchdog;
   }
 
   /**
@@ -122,10 +375,17 @@ public:
   template <class ControllerConnectorT> ControllerStatus getStatus() const {
     const ControllerConnectorT *controller_connector =
         controller_connector_container_.getObject<ControllerConnectorT>();
-    auto active_controller =
-        active_controllers_.find(controller_connector->getControllerGroup());
-    if (active_controller == active_controllers_.end() ||
-        controller_connector != active_controller->second) {
+    if (controller_connector !=
+        activeController(controller_connector->getControllerGroup())
+            .connector.load()) {
+      auto watchdog = deadline_watchdogs_.find(controller_connector);
+      if (watchdog != deadline_watchdogs_.end()) {
+        std::lock_guard<ProfiledMutex> lock(watchdog_mutex_);
+        if (watchdog->second.tripped) {
+          return ControllerStatus(ControllerStatus::Critical,
+                                  watchdog->second.description);
+        }
+      }
       return ControllerStatus::NotEngaged;
     }
     return controller_connector->getStatus();
@@ -141,10 +401,26 @@ public:
   */
   ControllerStatus
   getActiveControllerStatus(ControllerGroup controller_group) const {
-    auto active_controller = active_controllers_.find(controller_group);
-    if (active_controller != active_controllers_.end() &&
-        active_controller->second != nullptr) {
-      return active_controller->second->getStatus();
+    const AbstractControllerConnector *active_controller =
+        activeController(controller_group).connector.load();
+    if (active_controller != nullptr) {
+      ControllerStatus status = active_controller->getStatus();
+      if (status == ControllerStatus::NotEngaged) {
+        return status;
+      }
+      // Report fallbacks engaged by deadline watchdogs without changing the
+      // status of the fallback
+      std::lock_guard<ProfiledMutex> lock(watchdog_mutex_);
+      for (const auto &watchdog : deadline_watchdogs_) {
+        if (watchdog.second.group == controller_group &&
+            watchdog.second.tripped &&
+            watchdog.first != active_controller) {
+          status += ControllerStatus(status.status(),
+                                     "Deadline watchdog: " +
+                                         watchdog.second.description);
+        }
+      }
+      return status;
     } else {
       return ControllerStatus(ControllerStatus::NotEngaged);
     }
@@ -157,41 +433,66 @@ public:
   * switched off
   */
   void abortController(ControllerGroup controller_group) {
-    AbstractControllerConnector *const active_controller =
-        active_controllers_[controller_group];
-    if (active_controller != nullptr) {
-      // Disengage the controller
-      {
-        VLOG(1) << "Aborting controller";
-        boost::mutex::scoped_lock lock(*thread_mutexes_[controller_group]);
-        active_controller->disengage();
-        active_controllers_[controller_group] = nullptr;
-        VLOG(1) << "Aborting done";
-      }
-      AbstractControllerConnector *dependent_connector =
-          active_controller->getDependentConnector();
-      if (dependent_connector != nullptr) {
-        VLOG(1) << "Aborting dependent connector";
-        ControllerGroup dependent_group =
-            dependent_connector->getControllerGroup();
-        abortController(dependent_group);
-        VLOG(1) << "Aborting done for dep";
+    ActiveController &group_controller = activeController(controller_group);
+    AbstractControllerConnector *active_controller;
+    // Disengage the controller once its last run has ended
+    {
+      std::lock_guard<ProfiledMutex> lock(group_controller.switch_mutex);
+      active_controller = group_controller.connector.exchange(nullptr);
+      if (active_controller == nullptr) {
+        return;
       }
+      VLOG(1) << "Aborting controller";
+      waitForRun(group_controller);
+      active_controller->disengage();
+      VLOG(1) << "Aborting done";
+    }
+    AbstractControllerConnector *dependent_connector =
+        active_controller->getDependentConnector();
+    if (dependent_connector != nullptr) {
+      VLOG(1) << "Aborting dependent connector";
+      ControllerGroup dependent_group =
+          dependent_connector->getControllerGroup();
+      abortController(dependent_group);
+      VLOG(1) << "Aborting done for dep";
     }
   }
 
   /**
   * @brief Run active controller stored for a given controller group
   *
+  * Never waits for a switch of the active controller. A group is run by one
+  * thread at a time; a call overlapping a run of the same group returns
+  * without running
+  *
   * @param controller_group group for which active controller is run
   */
   void runActiveController(ControllerGroup controller_group) {
-    // lock to ensure active_control fcn is not changed
-    AbstractControllerConnector *const active_controller =
-        active_controllers_[controller_group];
-    if (active_controller != nullptr) {
-      boost::mutex::scoped_lock lock(*thread_mutexes_[controller_group]);
+    ActiveController &group_controller = activeController(controller_group);
+    uint64_t epoch = group_controller.run_epoch.load();
+    if ((epoch & 1) ||
+        !group_controller.run_epoch.compare_exchange_strong(epoch, epoch + 1)) {
+      VLOG(1) << "Skipping overlapping run of a controller group";
+      return;
+    }
+    std::function<void()> engage_fallback;
+    {
+      RunGuard guard(group_controller, epoch + 1);
+      // Read after marking the run, so a switch either sees the run or the
+      // run sees the new connector
+      AbstractControllerConnector *const active_controller =
+          group_controller.connector.load();
+      if (active_controller == nullptr) {
+        return;
+      }
+      auto start = std::chrono::steady_clock::now();
       active_controller->run();
+      engage_fallback = checkDeadline(
+          active_controller, std::chrono::steady_clock::now() - start);
+    }
+    // Switching connectors waits for the run to end
+    if (engage_fallback) {
+      engage_fallback();
     }
   }
 
@@ -40,17 +40,28 @@ public:
         visual_servoing_arm_connector_(
             *tracker_, *drone_hardware_, *arm_hardware_,
             relative_pose_controller_, camera_transform_, arm_transform_),
-        mpc_controller_(
-            config_.uav_vision_system_config()
-                .uav_arm_system_config()
-                .mpc_controller_config(),
-            std::chrono::milliseconds(config_.uav_controller_timer_duration())),
+        mpc_controller_(config_.uav_vision_system_config()
+                            .uav_arm_system_config()
+                            .mpc_controller_config(),
+                        UAVSystem::connectorPeriod(
+                            config_.mpc_connector_config().execution_period(),
+                            config_)),
         mpc_connector_(*drone_hardware_, *arm_hardware_, mpc_controller_,
                        thrust_gain_estimator_,
                        config.thrust_gain_estimator_config().buffer_size(),
                        config.mpc_connector_config(), odom_sensor_) {
     controller_connector_container_.setObject(visual_servoing_arm_connector_);
     controller_connector_container_.setObject(mpc_connector_);
+    mpc_connector_.setExecutionPeriod(std::chrono::duration<double>(
+        config_.mpc_connector_config().execution_period() * 1e-3));
+    if (config_.has_mpc_deadline_watchdog_config()) {
+      const auto &watchdog_config = config_.mpc_deadline_watchdog_config();
+      setDeadlineWatchdog(
+          &mpc_connector_,
+          std::chrono::duration<double>(watchdog_config.deadline() * 1e-3),
+          watchdog_config.max_missed_deadlines(),
+          std::bind(&UAVArmSystem::hoverInPlace, this));
+    }
   }
 
   /**
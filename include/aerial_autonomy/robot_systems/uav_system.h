@@ -224,6 +224,24 @@ private:
     return odom_sensor;
   }
 
+protected:
+  /**
+  * @brief Time between two runs of a connector with its own execution period
+  *
+  * @param execution_period Period of the connector in milliseconds, zero for
+  * the uav controller timer duration
+  * @param config UAV system config
+  *
+  * @return Period of the connector
+  */
+  static std::chrono::duration<double>
+  connectorPeriod(double execution_period, const UAVSystemConfig &config) {
+    if (execution_period > 0) {
+      return std::chrono::duration<double>(execution_period * 1e-3);
+    }
+    return std::chrono::milliseconds(config.uav_controller_timer_duration());
+  }
+
 public:
   /**
    * @brief Constructor with default configuration
@@ -266,7 +284,8 @@ public:
             std::chrono::milliseconds(config.uav_controller_timer_duration())),
         quad_mpc_controller_(
             config.quad_mpc_controller_config(),
-            std::chrono::milliseconds(config.uav_controller_timer_duration())),
+            UAVSystem::connectorPeriod(
+                config.mpc_connector_config().execution_period(), config)),
         velocity_sensor_(
             UAVSystem::chooseSensor(velocity_sensor, drone_hardware_, config)),
         odom_sensor_(UAVSystem::createOdomSensor(config)),
@@ -304,6 +323,22 @@ public:
         joystick_velocity_controller_drone_connector_);
     controller_connector_container_.setObject(quad_mpc_connector_);
     controller_connector_container_.setObject(rpyt_based_reference_connector_);
+    // Connectors with their own rate
+    quad_mpc_connector_.setExecutionPeriod(std::chrono::duration<double>(
+        config.mpc_connector_config().execution_period() * 1e-3));
+    rpyt_based_reference_connector_.setExecutionPeriod(
+        std::chrono::duration<double>(
+            config.rpyt_reference_connector_config().execution_period() *
+            1e-3));
+    // Hover in place if MPC runs too long
+    if (config_.has_mpc_deadline_watchdog_config()) {
+      const auto &watchdog_config = config_.mpc_deadline_watchdog_config();
+      setDeadlineWatchdog(
+          &quad_mpc_connector_,
+          std::chrono::duration<double>(watchdog_config.deadline() * 1e-3),
+          watchdog_config.max_missed_deadlines(),
+          std::bind(&UAVSystem::hoverInPlace, this));
+    }
     // Visualization
     if (config_.visualize_mpc_trajectories()) {
       mpc_visualizer_.reset(
@@ -460,6 +495,31 @@ public:
     }
     return SensorStatus::VALID;
   }
+
+  /**
+  * @brief Set a function called whenever the pose sensor receives a new pose
+  * @param callback Function to call, or null to stop calling
+  * @return False if there is no pose sensor, i.e. poses come from the quad
+  * data
+  */
+  bool setPoseSampleCallback(std::function<void()> callback) {
+    if (!odom_sensor_) {
+      return false;
+    }
+    odom_sensor_->setSampleCallback(callback);
+    return true;
+  }
+
+  /**
+  * @brief Hold the current position and yaw using the RPYT based position
+  * controller. Fallback of the MPC deadline watchdog
+  */
+  void hoverInPlace() {
+    parsernode::common::quaddata data = getUAVData();
+    PositionYaw hover(data.localpos.x, data.localpos.y, data.localpos.z,
+                      data.rpydata.z);
+    setGoal<RPYTBasedPositionControllerDroneConnector, PositionYaw>(hover);
+  }
   void resetThrustMixingGain() {
     thrust_gain_estimator_.resetThrustMixingGain();
   }
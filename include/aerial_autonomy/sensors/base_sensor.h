@@ -1,8 +1,48 @@
 #pragma once
 #include "aerial_autonomy/types/sensor_status.h"
 #include <aerial_autonomy/common/atomic.h>
+#include <aerial_autonomy/common/clock.h>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 
+/**
+* @brief Sensor data with the sequence number and receive time of its sample
+*
+* @tparam SensorDataT type of sensor data
+*/
+template <class SensorDataT> struct SensorSample {
+  /**
+  * @brief Constructor
+  */
+  SensorSample() : data(), sequence(0), receive_time() {}
+  /**
+  * @brief Constructor
+  *
+  * @param data Sensor data
+  * @param sequence Sequence number of the sample
+  * @param receive_time Time the sample was received
+  */
+  SensorSample(SensorDataT data, uint64_t sequence,
+               Clock::time_point receive_time)
+      : data(data), sequence(sequence), receive_time(receive_time) {}
+  SensorDataT data; ///< Sensor data
+  /**
+  * @brief Increases by one with every sample a sensor receives, starting
+  * from one. Zero for sensors that are polled instead, whose every read is a
+  * new sample
+  */
+  uint64_t sequence;
+  /**
+  * @brief Clock time at which the sensor received the sample, or at which a
+  * polled sensor was read. Not the acquisition time in the message header,
+  * which is on the clock of the sender
+  */
+  Clock::time_point receive_time;
+};
+
 /**
 * @brief Base class for sensors
 *
@@ -14,7 +54,7 @@ public:
   /**
   * @brief Constructor
   */
-  Sensor() {}
+  Sensor() : sample_(LockName("sensor_sample")), sequence_(0) {}
   /**
   * @brief gets the latest sensor data
   */
@@ -23,6 +63,69 @@ public:
   * @brief gets the current status of the sensor
   */
   virtual SensorStatus getSensorStatus() = 0;
+  /**
+  * @brief gets the latest sensor data with its sequence number and receive
+  * time. The data of a sample is always from a single sensor message.
+  * Readers can compare sequence numbers to skip work when no new sample has
+  * arrived
+  */
+  virtual SensorSample<SensorDataT> getSample() {
+    SensorSample<SensorDataT> sample = sample_;
+    if (sample.sequence == 0) {
+      // Polled sensor, or no sample received yet
+      sample.data = getSensorData();
+      sample.receive_time = Clock::instance().now();
+    }
+    return sample;
+  }
+  /**
+  * @brief Set a function called whenever the sensor receives a new sample,
+  * e.g. to run a controller on fresh data. Only sensors that receive
+  * samples, as opposed to being polled, call it. Waits for a running call of
+  * the previous function to return
+  * @param callback Function to call, or null to stop calling
+  */
+  void setSampleCallback(std::function<void()> callback) {
+    boost::mutex::scoped_lock lock(sample_callback_mutex_);
+    sample_callback_ = callback;
+  }
+
+protected:
+  /**
+  * @brief Store a new sample, stamped with the current clock time, and call
+  * the sample callback. Called by sensors that receive samples
+  * @param data Sensor data of the sample
+  */
+  void publishSample(const SensorDataT &data) {
+    sample_ = SensorSample<SensorDataT>(data, ++sequence_,
+                                        Clock::instance().now());
+    notifySample();
+  }
+
+  /**
+  * @brief Get the last sample stored with publishSample
+  * @return Last sample, default constructed with sequence zero if none
+  */
+  SensorSample<SensorDataT> latestSample() const { return sample_; }
+
+private:
+  /**
+  * @brief Call the sample callback
+  */
+  void notifySample() {
+    boost::mutex::scoped_lock lock(sample_callback_mutex_);
+    if (sample_callback_) {
+      sample_callback_();
+    }
+  }
+
+  std::function<void()> sample_callback_; ///< Called on new samples
+  boost::mutex sample_callback_mutex_;    ///< Guards the sample callback
+  /**
+  * @brief Last sample stored with publishSample
+  */
+  Atomic<SensorSample<SensorDataT>, atomic_policy::TripleBuffer> sample_;
+  std::atomic<uint64_t> sequence_; ///< Sequence number of the last sample
 };
 
 /**
@@ -22,7 +22,8 @@ public:
   OdomFromPoseSensor(OdomSensorConfig sensor_config);
 
   /**
-  * @brief  get the latest sensor measurement
+  * @brief  get the latest sensor measurement. Pose and velocity are from the
+  * same pose message
   *
   * @return sensor measurement
   */
@@ -45,8 +46,6 @@ public:
 private:
   ros::NodeHandle nh_;                             ///< Nodehandle
   ros::Subscriber pose_sub_;                       ///< ros subscriber
-  Atomic<tf::StampedTransform> pose_;              ///< latest pose
-  Atomic<tf::Vector3> velocity_;                   ///< latest pose
   ExponentialFilter<tf::Vector3> velocity_filter_; ///< Filter velocity
   bool pose_initialized_;                          ///< Pose initialized
   OdomSensorConfig config_;                        ///< Odom sensor config
@@ -43,8 +43,7 @@ public:
   void poseCallback(const geometry_msgs::TransformStampedConstPtr &pose_input);
 
 private:
-  ros::NodeHandle nh_;                ///< Nodehandle
-  ros::Subscriber pose_sub_;          ///< ros subscriber
-  Atomic<tf::StampedTransform> pose_; ///< latest pose
-  ros::Duration validity_buffer_;     ///< timeout for messages
+  ros::NodeHandle nh_;            ///< Nodehandle
+  ros::Subscriber pose_sub_;      ///< ros subscriber
+  ros::Duration validity_buffer_; ///< timeout for messages
 };
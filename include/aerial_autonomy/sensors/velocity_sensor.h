@@ -26,10 +26,7 @@ public:
   /**
   * @brief gives sensor data
   */
-  Velocity getSensorData() {
-    Velocity sensor_data = sensor_data_;
-    return sensor_data;
-  }
+  Velocity getSensorData() { return latestSample().data; }
   /**
   * @brief gives sensor status
   */
@@ -54,7 +51,7 @@ private:
     Velocity vel_sensor_data(msg->twist.twist.linear.x,
                              msg->twist.twist.linear.y,
                              msg->twist.twist.linear.z);
-    sensor_data_ = vel_sensor_data;
+    publishSample(vel_sensor_data);
   }
   /**
   * @brief sensor config
@@ -71,9 +68,5 @@ private:
   /**
   * @brief time of last msg recieved
   */
-  Atomic<ros::Time> last_msg_time_;
-  /**
-  * @brief variable to store sensor data
-  */
-  Atomic<Velocity> sensor_data_;
+  Atomic<ros::Time> last_msg_time_{LockName("velocity_sensor_time")};
 };
@@ -12,6 +12,10 @@
 /**
 * @brief Connects a logic state machine to the GUI over a ROS interface
 *
+* Events are posted to the state machine, so the ROS callbacks return
+* without waiting for the state machine to process them. Destroy the
+* connector only after the state machine stopped dispatching.
+*
 * @tparam EventManagerT event manager type used to trigger events to state
 * machine
 * @tparam LogicStateMachineT logic state machine type used to trigger pose
@@ -75,8 +79,13 @@ private:
   * @param event_data name of event to trigger
   */
   void eventCallback(const std_msgs::StringConstPtr &event_data) {
-    VLOG(1) << "Triggering event: " << event_data;
-    event_manager_.triggerEvent(event_data->data, logic_state_machine_);
+    std::string event_name = event_data->data;
+    VLOG(1) << "Triggering event: " << event_name;
+    logic_state_machine_.post(event_name, [this, event_name] {
+      if (!event_manager_.triggerEvent(event_name, logic_state_machine_)) {
+        LOG(WARNING) << "Unknown event: " << event_name;
+      }
+    });
   }
 
   /**
@@ -93,7 +102,7 @@ private:
     VLOG(1) << "Received Pose command: " << pose_command.x << "\t"
             << pose_command.y << "\t" << pose_command.z << "\t"
             << pose_command.yaw;
-    logic_state_machine_.process_event(pose_command);
+    logic_state_machine_.postEvent(pose_command);
   }
 
   /**
@@ -107,7 +116,7 @@ private:
                         velocity_yaw.yaw);
     VLOG(1) << "Received Velocity Yaw command: " << command.x << "\t"
             << command.y << "\t" << command.z << "\t" << command.yaw;
-    logic_state_machine_.process_event(command);
+    logic_state_machine_.postEvent(command);
   }
 
   /**
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <glog/logging.h>
 #include <ros/ros.h>
 #include <std_msgs/String.h>
 
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
 #include "common_system_handler_config.pb.h"
+#include "uav_system_handler_config.pb.h"
 #include <aerial_autonomy/actions_guards/base_functors.h>
 #include <aerial_autonomy/common/async_timer.h>
 #include <aerial_autonomy/common/system_status_publisher.h>
+#include <aerial_autonomy/common/timer_executor_pool.h>
 #include <aerial_autonomy/state_machines/state_machine_gui_connector.h>
+#include <aerial_autonomy/types/controller_groups.h>
 
 /**
  * @brief Provides logic common to different system handlers to
@@ -39,24 +47,39 @@ public:
       : nh_("~common"), logic_state_machine_(std::ref(robot_system),
                                              std::cref(state_machine_config)),
         state_machine_gui_connector_(nh_, event_manager_, logic_state_machine_),
-        system_status_pub_(nh_, robot_system, logic_state_machine_),
+        timer_executors_(std::make_shared<TimerExecutorPool>(
+            config.timer_executor_threads(), config.realtime_config())),
+        system_status_pub_(nh_, robot_system, logic_state_machine_,
+                           timer_executors_),
         status_timer_(
             std::bind(
                 &SystemStatusPublisher<LogicStateMachineT>::publishSystemStatus,
                 std::ref(system_status_pub_)),
-            std::chrono::milliseconds(config.status_timer_duration())),
+            std::chrono::milliseconds(config.status_timer_duration()),
+            "status_timer", timer_executors_->executor("status_timer"),
+            TimerPriority::Low),
         logic_state_machine_timer_(
-            std::bind(&LogicStateMachineT::template process_event<
-                          InternalTransitionEvent>,
-                      std::ref(logic_state_machine_),
-                      InternalTransitionEvent()),
-            std::chrono::milliseconds(config.state_machine_timer_duration())) {}
+            std::bind(&CommonSystemHandler::postInternalTransition, this),
+            std::chrono::milliseconds(config.state_machine_timer_duration()),
+            "logic_state_machine_timer",
+            timer_executors_->executor("logic_state_machine_timer")),
+        internal_transition_pending_(false) {}
 
   /**
   * @brief Delete copy constructor
   */
   CommonSystemHandler(const CommonSystemHandler &) = delete;
 
+  /**
+  * @brief Destructor stops the state machine dispatch thread before the
+  * objects used by posted events are destroyed
+  */
+  ~CommonSystemHandler() {
+    status_timer_.stop();
+    logic_state_machine_timer_.stop();
+    logic_state_machine_.stopDispatch();
+  }
+
   /**
    * @brief Checks if internal ROS topics are connected
    * @return Returns true if connected and false otherwise
@@ -66,6 +89,77 @@ public:
            state_machine_gui_connector_.isPoseCommandConnected();
   }
 
+  /**
+  * @brief Get the executor that should run a timer of the system handler
+  * @param timer_name Name of the timer
+  * @return Real-time executor of the timer if configured, otherwise the
+  * shared timer executor
+  */
+  std::shared_ptr<TimerExecutor> timerExecutor(const std::string &timer_name) {
+    return timer_executors_->executor(timer_name);
+  }
+
+  /**
+  * @brief Drive the uav controller timer by new poses of the UAV system if
+  * sensor triggered controllers are configured, and by the execution period
+  * of its active UAV connector unless the timer runs phase aligned
+  * controllers. Has to be undone with disconnectUAVControllerTimer before the
+  * timer is destroyed
+  *
+  * Throws std::runtime_error if the timer runs phase aligned controllers and
+  * a connector has its own execution period, since the connector would run
+  * at the pipeline period instead
+  * @param timer Timer running the UAV controllers
+  * @param uav_system UAV system providing the poses and connectors
+  * @param config System handler configuration
+  * @param phase_aligned True if the timer runs a phase aligned pipeline, whose
+  * period is fixed
+  */
+  void connectUAVControllerTimer(AsyncTimer &timer, RobotSystemT &uav_system,
+                                 const UAVSystemHandlerConfig &config,
+                                 bool phase_aligned) {
+    const auto &uav_system_config = config.uav_system_config();
+    if (phase_aligned &&
+        (uav_system_config.mpc_connector_config().execution_period() > 0 ||
+         uav_system_config.rpyt_reference_connector_config()
+                 .execution_period() > 0)) {
+      throw std::runtime_error("Connector execution periods cannot be used "
+                               "with phase aligned controllers");
+    }
+    if (config.sensor_triggered_controllers()) {
+      std::chrono::duration<double, std::milli> min_period(
+          config.sensor_trigger_min_period());
+      if (!uav_system.setPoseSampleCallback(
+              [&timer, min_period] { timer.trigger(min_period); })) {
+        LOG(WARNING) << "No pose sensor to trigger the controllers. Running "
+                        "them periodically";
+      }
+    }
+    if (!phase_aligned) {
+      // Run the active UAV connector at its preferred rate
+      std::chrono::milliseconds default_period(
+          uav_system_config.uav_controller_timer_duration());
+      uav_system.setExecutionPeriodCallback(
+          ControllerGroup::UAV,
+          [&timer, default_period](std::chrono::duration<double> period) {
+            if (period <= std::chrono::duration<double>(0)) {
+              period = default_period;
+            }
+            timer.setDuration(period);
+          });
+    }
+  }
+
+  /**
+  * @brief Stop the sensor triggers and rate changes of the uav controller
+  * timer set up by connectUAVControllerTimer
+  * @param uav_system UAV system passed to connectUAVControllerTimer
+  */
+  void disconnectUAVControllerTimer(RobotSystemT &uav_system) {
+    uav_system.setPoseSampleCallback(nullptr);
+    uav_system.setExecutionPeriodCallback(ControllerGroup::UAV, nullptr);
+  }
+
   /**
   * @brief Start state machine internal event processing and status timer
   */
@@ -87,8 +181,30 @@ protected:
   StateMachineGUIConnector<EventManagerT, LogicStateMachineT>
       state_machine_gui_connector_; ///< Connects event manager to the state
                                     /// machine
+  std::shared_ptr<TimerExecutorPool>
+      timer_executors_; ///< Run the timers of the system handler
   SystemStatusPublisher<LogicStateMachineT>
       system_status_pub_;   ///< publishes status messages
   AsyncTimer status_timer_; ///< Update uav status and state machine status
   AsyncTimer logic_state_machine_timer_; ///< Timer for running state machine
+  /**
+  * @brief True while an internal transition event posted by the state
+  * machine timer waits to be processed
+  */
+  std::atomic<bool> internal_transition_pending_;
+
+private:
+  /**
+  * @brief Post an internal transition event unless the previous one is still
+  * queued, so that a busy state machine does not accumulate timer events
+  */
+  void postInternalTransition() {
+    if (internal_transition_pending_.exchange(true)) {
+      return;
+    }
+    logic_state_machine_.post(typeid(InternalTransitionEvent).name(), [this] {
+      internal_transition_pending_ = false;
+      logic_state_machine_.process_event(InternalTransitionEvent());
+    });
+  }
 };
@@ -28,7 +28,10 @@ public:
         mpc_visualization_timer_(
             std::bind(&UAVArmSystem::visualizeMPC, std::ref(this->uav_system_)),
             std::chrono::milliseconds(
-                config.mpc_visualization_timer_duration())) {
+                config.mpc_visualization_timer_duration()),
+            "mpc_visualization_timer",
+            this->timerExecutor("mpc_visualization_timer"),
+            TimerPriority::Low) {
     if (config.uav_system_config().visualize_mpc_trajectories()) {
       mpc_visualization_timer_.start();
     }
@@ -4,6 +4,7 @@
 
 #include <aerial_autonomy/VelocityBasedPositionControllerDynamicConfig.h>
 #include <aerial_autonomy/actions_guards/base_functors.h>
+#include <aerial_autonomy/common/phase_aligned_pipeline.h>
 #include <aerial_autonomy/log/mocap_logger.h>
 #include <aerial_autonomy/robot_systems/uav_arm_system.h>
 #include <aerial_autonomy/system_handlers/common_system_handler.h>
@@ -33,34 +34,81 @@ public:
       : uav_system_(config.uav_system_config()),
         common_handler_(config.base_config(), uav_system_,
                         state_machine_config),
+        controller_pipeline_(std::chrono::milliseconds(
+            config.uav_system_config().uav_controller_timer_duration())),
         uav_controller_timer_(
-            std::bind(&UAVArmSystem::runActiveController, std::ref(uav_system_),
-                      ControllerGroup::UAV),
+            std::bind(&PhaseAlignedPipeline::tick,
+                      std::ref(controller_pipeline_)),
             std::chrono::milliseconds(
-                config.uav_system_config().uav_controller_timer_duration())),
+                config.uav_system_config().uav_controller_timer_duration()),
+            "uav_controller_timer",
+            common_handler_.timerExecutor("uav_controller_timer"),
+            TimerPriority::High),
         high_level_controller_timer_(
             std::bind(&UAVSystem::runActiveController, std::ref(uav_system_),
                       ControllerGroup::HighLevel),
             std::chrono::milliseconds(
                 config.uav_system_config()
                     .uav_vision_system_config()
-                    .high_level_controller_timer_duration())),
+                    .high_level_controller_timer_duration()),
+            "high_level_controller_timer",
+            common_handler_.timerExecutor("high_level_controller_timer"),
+            TimerPriority::High),
         arm_controller_timer_(
             std::bind(&UAVArmSystem::runActiveController, std::ref(uav_system_),
                       ControllerGroup::Arm),
             std::chrono::milliseconds(config.uav_arm_system_handler_config()
-                                          .arm_controller_timer_duration())),
+                                          .arm_controller_timer_duration()),
+            "arm_controller_timer",
+            common_handler_.timerExecutor("arm_controller_timer"),
+            TimerPriority::High),
         quad_mpc_visualization_timer_(
             std::bind(&UAVSystem::visualizeQuadMPC,
                       std::ref(this->uav_system_)),
             std::chrono::milliseconds(
-                config.mpc_visualization_timer_duration())) {
+                config.mpc_visualization_timer_duration()),
+            "quad_mpc_visualization_timer",
+            common_handler_.timerExecutor("quad_mpc_visualization_timer"),
+            TimerPriority::Low) {
+    bool phase_aligned = config.phase_aligned_controllers();
+    if (phase_aligned) {
+      std::chrono::milliseconds high_level_duration(
+          config.uav_system_config()
+              .uav_vision_system_config()
+              .high_level_controller_timer_duration());
+      controller_pipeline_.addStage(
+          "high_level_controller",
+          std::bind(&UAVSystem::runActiveController, std::ref(uav_system_),
+                    ControllerGroup::HighLevel),
+          high_level_duration);
+    }
+    controller_pipeline_.addStage(
+        "uav_controller",
+        std::bind(&UAVArmSystem::runActiveController, std::ref(uav_system_),
+                  ControllerGroup::UAV),
+        std::chrono::milliseconds(
+            config.uav_system_config().uav_controller_timer_duration()));
+    if (phase_aligned) {
+      std::chrono::milliseconds arm_duration(
+          config.uav_arm_system_handler_config()
+              .arm_controller_timer_duration());
+      controller_pipeline_.addStage(
+          "arm_controller",
+          std::bind(&UAVArmSystem::runActiveController, std::ref(uav_system_),
+                    ControllerGroup::Arm),
+          arm_duration);
+    }
 
     // Get the party started
     common_handler_.startTimers();
     uav_controller_timer_.start();
-    high_level_controller_timer_.start();
-    arm_controller_timer_.start();
+    common_handler_.connectUAVControllerTimer(uav_controller_timer_,
+                                              uav_system_, config,
+                                              phase_aligned);
+    if (!phase_aligned) {
+      high_level_controller_timer_.start();
+      arm_controller_timer_.start();
+    }
     if (config.uav_system_config().visualize_mpc_trajectories()) {
       quad_mpc_visualization_timer_.start();
     }
@@ -71,6 +119,14 @@ public:
   */
   UAVArmSystemHandler(const UAVArmSystemHandler &) = delete;
 
+  /**
+  * @brief Destructor stops sensor triggers and rate changes of the uav
+  * controller timer before the timer is destroyed
+  */
+  ~UAVArmSystemHandler() {
+    common_handler_.disconnectUAVControllerTimer(uav_system_);
+  }
+
   /**
    * @brief Get UAV state
    * @return The UAV state
@@ -86,12 +142,23 @@ public:
   bool isConnected() { return common_handler_.isConnected(); }
 
 protected:
+  /**
+  * @brief Get the executor that should run a timer of the system handler
+  * @param timer_name Name of the timer
+  * @return Timer executor
+  */
+  std::shared_ptr<TimerExecutor> timerExecutor(const std::string &timer_name) {
+    return common_handler_.timerExecutor(timer_name);
+  }
+
   UAVArmSystem uav_system_; ///< Contains controllers
 
 private:
   CommonSystemHandler<LogicStateMachineT, EventManagerT, UAVArmSystem>
       common_handler_;              ///< Common logic to create state machine
                                     ///< and associated connections.
+  PhaseAlignedPipeline controller_pipeline_; ///< Controllers run by the uav
+                                             ///< controller timer
   AsyncTimer uav_controller_timer_; ///< Timer for running uav controller
   AsyncTimer high_level_controller_timer_; ///< Timer for running high level
   AsyncTimer arm_controller_timer_;        ///< Timer for running arm controller
@@ -33,15 +33,23 @@ public:
             std::bind(&UAVSystem::runActiveController, std::ref(uav_system_),
                       ControllerGroup::UAV),
             std::chrono::milliseconds(
-                config.uav_system_config().uav_controller_timer_duration())),
+                config.uav_system_config().uav_controller_timer_duration()),
+            "uav_controller_timer",
+            common_handler_.timerExecutor("uav_controller_timer"),
+            TimerPriority::High),
         quad_mpc_visualization_timer_(
             std::bind(&UAVSystem::visualizeQuadMPC,
                       std::ref(this->uav_system_)),
             std::chrono::milliseconds(
-                config.mpc_visualization_timer_duration())) {
+                config.mpc_visualization_timer_duration()),
+            "quad_mpc_visualization_timer",
+            common_handler_.timerExecutor("quad_mpc_visualization_timer"),
+            TimerPriority::Low) {
     // Get the party started
     common_handler_.startTimers();
     uav_controller_timer_.start();
+    common_handler_.connectUAVControllerTimer(uav_controller_timer_,
+                                              uav_system_, config, false);
     if (config.uav_system_config().visualize_mpc_trajectories()) {
       quad_mpc_visualization_timer_.start();
     }
@@ -52,6 +60,14 @@ public:
   */
   UAVSystemHandler(const UAVSystemHandler &) = delete;
 
+  /**
+  * @brief Destructor stops sensor triggers and rate changes of the uav
+  * controller timer before the timer is destroyed
+  */
+  ~UAVSystemHandler() {
+    common_handler_.disconnectUAVControllerTimer(uav_system_);
+  }
+
   /**
    * @brief Get UAV state
    * @return The UAV state
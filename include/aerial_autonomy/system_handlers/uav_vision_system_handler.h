@@ -3,6 +3,7 @@
 #include <ros/ros.h>
 
 #include <aerial_autonomy/actions_guards/base_functors.h>
+#include <aerial_autonomy/common/phase_aligned_pipeline.h>
 #include <aerial_autonomy/robot_systems/uav_vision_system.h>
 #include <aerial_autonomy/system_handlers/common_system_handler.h>
 
@@ -28,27 +29,61 @@ public:
       : uav_system_(config.uav_system_config()),
         common_handler_(config.base_config(), uav_system_,
                         state_machine_config),
+        controller_pipeline_(std::chrono::milliseconds(
+            config.uav_system_config().uav_controller_timer_duration())),
         uav_controller_timer_(
-            std::bind(&UAVVisionSystem::runActiveController,
-                      std::ref(uav_system_), ControllerGroup::UAV),
+            std::bind(&PhaseAlignedPipeline::tick,
+                      std::ref(controller_pipeline_)),
             std::chrono::milliseconds(
-                config.uav_system_config().uav_controller_timer_duration())),
+                config.uav_system_config().uav_controller_timer_duration()),
+            "uav_controller_timer",
+            common_handler_.timerExecutor("uav_controller_timer"),
+            TimerPriority::High),
         high_level_controller_timer_(
             std::bind(&UAVSystem::runActiveController, std::ref(uav_system_),
                       ControllerGroup::HighLevel),
             std::chrono::milliseconds(
                 config.uav_system_config()
                     .uav_vision_system_config()
-                    .high_level_controller_timer_duration())),
+                    .high_level_controller_timer_duration()),
+            "high_level_controller_timer",
+            common_handler_.timerExecutor("high_level_controller_timer"),
+            TimerPriority::High),
         quad_mpc_visualization_timer_(
             std::bind(&UAVSystem::visualizeQuadMPC,
                       std::ref(this->uav_system_)),
             std::chrono::milliseconds(
-                config.mpc_visualization_timer_duration())) {
+                config.mpc_visualization_timer_duration()),
+            "quad_mpc_visualization_timer",
+            common_handler_.timerExecutor("quad_mpc_visualization_timer"),
+            TimerPriority::Low) {
+    bool phase_aligned = config.phase_aligned_controllers();
+    if (phase_aligned) {
+      std::chrono::milliseconds high_level_duration(
+          config.uav_system_config()
+              .uav_vision_system_config()
+              .high_level_controller_timer_duration());
+      controller_pipeline_.addStage(
+          "high_level_controller",
+          std::bind(&UAVSystem::runActiveController, std::ref(uav_system_),
+                    ControllerGroup::HighLevel),
+          high_level_duration);
+    }
+    controller_pipeline_.addStage(
+        "uav_controller",
+        std::bind(&UAVVisionSystem::runActiveController, std::ref(uav_system_),
+                  ControllerGroup::UAV),
+        std::chrono::milliseconds(
+            config.uav_system_config().uav_controller_timer_duration()));
     // Get the party started
     common_handler_.startTimers();
     uav_controller_timer_.start();
-    high_level_controller_timer_.start();
+    common_handler_.connectUAVControllerTimer(uav_controller_timer_,
+                                              uav_system_, config,
+                                              phase_aligned);
+    if (!phase_aligned) {
+      high_level_controller_timer_.start();
+    }
     if (config.uav_system_config().visualize_mpc_trajectories()) {
       quad_mpc_visualization_timer_.start();
     }
@@ -59,6 +94,14 @@ public:
   */
   UAVVisionSystemHandler(const UAVVisionSystemHandler &) = delete;
 
+  /**
+  * @brief Destructor stops sensor triggers and rate changes of the uav
+  * controller timer before the timer is destroyed
+  */
+  ~UAVVisionSystemHandler() {
+    common_handler_.disconnectUAVControllerTimer(uav_system_);
+  }
+
   /**
    * @brief Get UAV state
    * @return The UAV state
@@ -78,6 +121,8 @@ private:
   CommonSystemHandler<LogicStateMachineT, EventManagerT, UAVVisionSystem>
       common_handler_;              ///< Common logic to create state machine
                                     ///< and associated connections.
+  PhaseAlignedPipeline controller_pipeline_; ///< Controllers run by the uav
+                                             ///< controller timer
   AsyncTimer uav_controller_timer_; ///< Timer for running uav controller
   AsyncTimer high_level_controller_timer_;  ///< Timer for running high level
   AsyncTimer quad_mpc_visualization_timer_; ///< Timer for visualizing MPC
@@ -4,6 +4,8 @@
 #include <aerial_autonomy/state_machines/base_state_machine.h>
 #include <aerial_autonomy/types/position_yaw.h>
 #include <aerial_autonomy/types/velocity_yaw.h>
+#include <functional>
+#include <string>
 #include <type_traits>
 
 /**
@@ -84,6 +86,25 @@ public:
     velocity_event_ = event;
   }
 
+  /**
+  * @brief Processes posted events immediately
+  *
+  * @tparam Event Event type
+  * @param event Event instance sent in to process
+  */
+  template <class Event> void postEvent(const Event &event) {
+    process_event(event);
+  }
+
+  /**
+  * @brief Runs posted functions immediately
+  *
+  * @param function Function to run
+  */
+  void post(const std::string &, std::function<void()> function) {
+    function();
+  }
+
   /**
   * @brief retrieve the event type_index of last processed event
   *
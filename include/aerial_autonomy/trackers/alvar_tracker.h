@@ -78,7 +78,8 @@ private:
   /**
   * @brief Stored tracking transforms
   */
-  Atomic<std::unordered_map<uint32_t, tf::Transform>> object_poses_;
+  Atomic<std::unordered_map<uint32_t, tf::Transform>> object_poses_{
+      LockName("alvar_tracker_poses")};
   /**
   * @brief Timeout for valid update
   */
@@ -1,4 +1,5 @@
 #pragma once
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/trackers/tracking_strategy.h"
 
 #include <tf/tf.h>
@@ -64,7 +65,7 @@ public:
   // with tracking vector
   virtual std::chrono::time_point<std::chrono::high_resolution_clock>
   getTrackingTime() {
-    return std::chrono::high_resolution_clock::now();
+    return Clock::instance().now();
   }
 
 private:
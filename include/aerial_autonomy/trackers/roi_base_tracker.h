@@ -180,15 +180,18 @@ protected:
   /**
    * @brief Camera info for conversion to 3D
    */
-  Atomic<sensor_msgs::CameraInfo> camera_info_;
+  Atomic<sensor_msgs::CameraInfo, atomic_policy::TripleBuffer> camera_info_{
+      LockName("roi_tracker_camera_info")};
   /**
    * @brief Current roi
    */
-  Atomic<sensor_msgs::RegionOfInterest> roi_rect_;
+  Atomic<sensor_msgs::RegionOfInterest> roi_rect_{
+      LockName("roi_tracker_roi")};
   /**
    * @brief Transform of object in camera frame (meters)
    */
-  Atomic<tf::Transform> object_pose_;
+  Atomic<tf::Transform, atomic_policy::TripleBuffer> object_pose_{
+      LockName("roi_tracker_pose")};
   /**
    * @brief Max distance of object from camera (meters)
    * \todo Make this a configurable param
@@ -1,43 +1,67 @@
 #include <aerial_autonomy/common/async_timer.h>
+#include <aerial_autonomy/log/trace.h>
 
 #include <stdexcept>
 
 AsyncTimer::AsyncTimer(std::function<void()> function,
-                       std::chrono::duration<double> timer_duration)
-    : function_(function), timer_duration_(timer_duration), running_(false) {}
+                       std::chrono::duration<double> timer_duration,
+                       std::string name,
+                       std::shared_ptr<TimerExecutor> executor,
+                       TimerPriority priority)
+    : function_(function), timer_duration_(timer_duration), running_(false),
+      name_(name), tick_name_(Tracer::instance().intern(name)),
+      executor_(executor), priority_(priority), task_id_(0),
+      statistics_(std::make_shared<TimerStatistics>(name)),
+      simulated_clock_(nullptr), simulated_timer_id_(0) {}
 
 AsyncTimer::~AsyncTimer() { stop(); }
 
 void AsyncTimer::stop() {
-  running_ = false;
-  if (timer_thread_.joinable()) {
-    timer_thread_.join();
+  if (running_.exchange(false)) {
+    if (simulated_clock_) {
+      simulated_clock_->removeTimer(simulated_timer_id_);
+    } else {
+      executor_->cancel(task_id_);
+    }
   }
 }
 
 void AsyncTimer::start() {
-  if (!running_) {
-    running_ = true;
-    timer_thread_ = std::thread(std::bind(&AsyncTimer::functionTimer, this));
-  } else {
+  if (running_) {
     throw std::logic_error("Cannot start AsyncTimer twice!");
   }
+  simulated_clock_ = dynamic_cast<SimulatedClock *>(&Clock::instance());
+  if (simulated_clock_) {
+    simulated_timer_id_ =
+        simulated_clock_->addTimer(function_, timer_duration_);
+  } else {
+    if (!executor_) {
+      executor_ = std::make_shared<TimerExecutor>(1, name_);
+    }
+    task_id_ = executor_->schedule(function_, timer_duration_, priority_,
+                                   tick_name_, statistics_);
+  }
+  // Set last so that trigger sees the scheduled task
+  running_ = true;
 }
 
-void AsyncTimer::functionTimer() {
-  while (running_) {
-    auto start = std::chrono::high_resolution_clock::now();
-    function_();
-    std::this_thread::sleep_until(start + timer_duration_);
+void AsyncTimer::trigger(std::chrono::duration<double> min_interval) {
+  if (running_ && !simulated_clock_) {
+    executor_->trigger(task_id_, min_interval);
   }
 }
 
 void AsyncTimer::setDuration(std::chrono::duration<double> duration) {
-  if (!running_) {
-    timer_duration_ = duration;
-  } else {
-    stop();
-    timer_duration_ = duration;
-    start();
+  timer_duration_ = duration;
+  if (running_) {
+    if (simulated_clock_) {
+      simulated_clock_->setPeriod(simulated_timer_id_, duration);
+    } else {
+      executor_->setPeriod(task_id_, duration);
+    }
   }
 }
+
+TimerStatistics::Summary AsyncTimer::statistics() const {
+  return statistics_->summary();
+}
@@ -0,0 +1,133 @@
+#include "aerial_autonomy/common/clock.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+/**
+* @brief Clocks that have been set as the process clock
+*/
+struct ClockRegistry {
+  ClockRegistry()
+      : system_clock(std::make_shared<SystemClock>()),
+        current(system_clock.get()) {}
+
+  std::shared_ptr<Clock> system_clock;        ///< Default clock
+  std::vector<std::shared_ptr<Clock>> clocks; ///< Keeps set clocks alive
+  std::atomic<Clock *> current;               ///< Process clock
+  std::mutex mutex;                           ///< Guards clocks
+};
+
+ClockRegistry &registry() {
+  static auto clock_registry = new ClockRegistry();
+  return *clock_registry;
+}
+}
+
+Clock &Clock::instance() { return *registry().current.load(); }
+
+void Clock::setInstance(std::shared_ptr<Clock> clock) {
+  ClockRegistry &clock_registry = registry();
+  if (!clock) {
+    clock_registry.current = clock_registry.system_clock.get();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(clock_registry.mutex);
+  clock_registry.clocks.push_back(clock);
+  clock_registry.current = clock.get();
+}
+
+Clock::time_point SystemClock::now() const {
+  return std::chrono::high_resolution_clock::now();
+}
+
+SimulatedClock::SimulatedClock(time_point start)
+    : time_(start.time_since_epoch().count()), next_id_(0), running_(false),
+      running_id_(0) {}
+
+Clock::time_point SimulatedClock::now() const {
+  return time_point(duration(time_.load()));
+}
+
+SimulatedClock::TimerId
+SimulatedClock::addTimer(std::function<void()> function,
+                         std::chrono::duration<double> period) {
+  Timer timer;
+  timer.function = function;
+  // A zero period would never let the time advance
+  timer.period = std::max(std::chrono::duration_cast<duration>(period),
+                          duration(1));
+  timer.deadline = now();
+  timer.called = false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  TimerId id = next_id_++;
+  timers_[id] = timer;
+  return id;
+}
+
+void SimulatedClock::removeTimer(TimerId id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  timers_.erase(id);
+  while (running_ && running_id_ == id &&
+         running_thread_ != std::this_thread::get_id()) {
+    done_cv_.wait(lock);
+  }
+}
+
+void SimulatedClock::setPeriod(TimerId id,
+                               std::chrono::duration<double> period) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = timers_.find(id);
+  if (it == timers_.end()) {
+    return;
+  }
+  Timer &timer = it->second;
+  duration new_period = std::max(
+      std::chrono::duration_cast<duration>(period), duration(1));
+  if (timer.called) {
+    // The deadline is one old period after the previous call
+    timer.deadline =
+        std::max(timer.deadline - timer.period + new_period, now());
+  }
+  timer.period = new_period;
+}
+
+void SimulatedClock::advance(std::chrono::duration<double> step) {
+  advanceTo(now() + std::chrono::duration_cast<duration>(step));
+}
+
+void SimulatedClock::advanceTo(time_point time) {
+  std::lock_guard<std::mutex> advance_lock(advance_mutex_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Earliest deadline first, ties in the order the timers were added
+    auto next = timers_.end();
+    for (auto it = timers_.begin(); it != timers_.end(); ++it) {
+      if (next == timers_.end() ||
+          it->second.deadline < next->second.deadline) {
+        next = it;
+      }
+    }
+    if (next == timers_.end() || next->second.deadline > time) {
+      break;
+    }
+    if (next->second.deadline > now()) {
+      time_ = next->second.deadline.time_since_epoch().count();
+    }
+    TimerId id = next->first;
+    std::function<void()> function = next->second.function;
+    next->second.deadline += next->second.period;
+    next->second.called = true;
+    running_ = true;
+    running_id_ = id;
+    running_thread_ = std::this_thread::get_id();
+    lock.unlock();
+    function();
+    lock.lock();
+    running_ = false;
+    done_cv_.notify_all();
+  }
+  if (time > now()) {
+    time_ = time.time_since_epoch().count();
+  }
+}
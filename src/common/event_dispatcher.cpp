@@ -0,0 +1,83 @@
+#include <aerial_autonomy/common/event_dispatcher.h>
+#include <aerial_autonomy/log/trace.h>
+
+#include <glog/logging.h>
+
+EventDispatcher::EventDispatcher(std::string thread_name)
+    : thread_name_(thread_name), stopping_(false), sleeping_(false) {}
+
+EventDispatcher::~EventDispatcher() { stop(); }
+
+void EventDispatcher::post(const std::string &name,
+                           std::function<void()> function) {
+  if (stopping_) {
+    VLOG(1) << "Dropping " << name << " posted after stop";
+    return;
+  }
+  std::call_once(start_flag_, [this] {
+    thread_ = std::thread(&EventDispatcher::dispatchLoop, this);
+  });
+  queue_.push(Item{name, function, Clock::now()});
+  // Either the dispatch thread sees the item before sleeping, or it is
+  // marked as sleeping here and waits on the condition variable already
+  if (sleeping_) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
+}
+
+void EventDispatcher::stop() {
+  // Prevents posts from starting the thread from now on
+  std::call_once(start_flag_, [] {});
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+std::vector<EventDispatcher::Summary> EventDispatcher::statistics() const {
+  std::vector<Summary> summaries;
+  std::lock_guard<std::mutex> lock(histograms_mutex_);
+  for (const auto &entry : histograms_) {
+    Summary summary;
+    summary.name = entry.first;
+    summary.count = entry.second->count();
+    summary.latency_p50 = entry.second->percentile(0.5) * 1e-9;
+    summary.latency_p99 = entry.second->percentile(0.99) * 1e-9;
+    summary.latency_max = entry.second->max() * 1e-9;
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+void EventDispatcher::dispatchLoop() {
+  Tracer::instance().setThreadName(thread_name_);
+  Item item;
+  while (!stopping_) {
+    if (!queue_.pop(item)) {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      sleeping_ = true;
+      wake_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      sleeping_ = false;
+      continue;
+    }
+    item.function();
+    histogram(item.name)
+        .record(std::chrono::nanoseconds(Clock::now() - item.posted).count());
+    // Release the captures of the item before waiting for the next one
+    item = Item();
+  }
+}
+
+LatencyHistogram &EventDispatcher::histogram(const std::string &name) {
+  std::lock_guard<std::mutex> lock(histograms_mutex_);
+  std::unique_ptr<LatencyHistogram> &histogram = histograms_[name];
+  if (!histogram) {
+    histogram.reset(new LatencyHistogram());
+  }
+  return *histogram;
+}
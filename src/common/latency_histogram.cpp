@@ -0,0 +1,71 @@
+#include <aerial_autonomy/common/latency_histogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() : count_(0), max_(0) {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::record(int64_t value) {
+  value = std::max<int64_t>(value, 0);
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  int64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max &&
+         !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::count() const {
+  return count_.load(std::memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::max() const {
+  return max_.load(std::memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::percentile(double fraction) const {
+  uint64_t total = 0;
+  std::array<uint64_t, kBuckets> counts;
+  for (int i = 0; i < kBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  fraction = std::min(std::max(fraction, 0.0), 1.0);
+  uint64_t rank = std::max<uint64_t>(1, std::ceil(fraction * total));
+  uint64_t cumulative = 0;
+  for (int i = 0; i < kBuckets; ++i) {
+    cumulative += counts[i];
+    if (cumulative >= rank) {
+      return std::min<int64_t>(bucketUpperBound(i), max());
+    }
+  }
+  return max();
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+  if (value < kSubBuckets) {
+    return value;
+  }
+  // Position of the leading one, at least kSubBucketBits
+  int exponent = 63 - __builtin_clzll(value);
+  int sub_bucket = (value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  int exponent = index / kSubBuckets + kSubBucketBits - 1;
+  uint64_t sub_bucket = index % kSubBuckets;
+  uint64_t lower = (uint64_t(kSubBuckets) + sub_bucket)
+                   << (exponent - kSubBucketBits);
+  return lower + (uint64_t(1) << (exponent - kSubBucketBits)) - 1;
+}
@@ -0,0 +1,39 @@
+#include <aerial_autonomy/common/phase_aligned_pipeline.h>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+
+PhaseAlignedPipeline::PhaseAlignedPipeline(
+    std::chrono::duration<double> period)
+    : period_(period), tick_(0) {
+  CHECK(period.count() > 0) << "Pipeline period should be positive";
+}
+
+void PhaseAlignedPipeline::addStage(std::string name,
+                                    std::function<void()> function,
+                                    std::chrono::duration<double> period) {
+  double ratio = period / period_;
+  uint64_t divisor = std::max(1.0, std::round(ratio));
+  if (std::abs(ratio - divisor) > 1e-6) {
+    LOG(WARNING) << "Period of " << name << " (" << period.count()
+                 << " s) is not a multiple of the pipeline period ("
+                 << period_.count() << " s). Running every " << divisor
+                 << " ticks";
+  }
+  stages_.push_back({function, divisor});
+}
+
+void PhaseAlignedPipeline::tick() {
+  for (const auto &stage : stages_) {
+    if (tick_ % stage.divisor == 0) {
+      stage.function();
+    }
+  }
+  ++tick_;
+}
+
+uint64_t PhaseAlignedPipeline::divisor(size_t index) const {
+  return stages_.at(index).divisor;
+}
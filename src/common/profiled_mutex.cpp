@@ -0,0 +1,76 @@
+#include <aerial_autonomy/common/profiled_mutex.h>
+
+#include <iomanip>
+
+LockStatistics::LockStatistics(std::string name)
+    : name_(name), contended_(0) {}
+
+void LockStatistics::recordWait(int64_t wait, bool contended) {
+  wait_.record(wait);
+  if (contended) {
+    contended_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void LockStatistics::recordHold(int64_t hold) { hold_.record(hold); }
+
+LockStatistics::Summary LockStatistics::summary() const {
+  Summary summary;
+  summary.name = name_;
+  summary.acquisitions = wait_.count();
+  summary.contended = contended_.load(std::memory_order_relaxed);
+  summary.wait_p50 = wait_.percentile(0.5) * 1e-9;
+  summary.wait_p99 = wait_.percentile(0.99) * 1e-9;
+  summary.wait_max = wait_.max() * 1e-9;
+  summary.hold_p50 = hold_.percentile(0.5) * 1e-9;
+  summary.hold_p99 = hold_.percentile(0.99) * 1e-9;
+  summary.hold_max = hold_.max() * 1e-9;
+  return summary;
+}
+
+LockProfiler &LockProfiler::instance() {
+  static LockProfiler *profiler = new LockProfiler();
+  return *profiler;
+}
+
+LockProfiler::LockProfiler() : enabled_(false) {}
+
+void LockProfiler::enable() { enabled_ = true; }
+
+void LockProfiler::disable() { enabled_ = false; }
+
+LockStatistics *LockProfiler::statistics(const std::string &name) {
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  std::unique_ptr<LockStatistics> &statistics = statistics_[name];
+  if (!statistics) {
+    statistics.reset(new LockStatistics(name));
+  }
+  return statistics.get();
+}
+
+std::vector<LockStatistics::Summary> LockProfiler::summaries() {
+  std::vector<LockStatistics::Summary> summaries;
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  for (const auto &entry : statistics_) {
+    summaries.push_back(entry.second->summary());
+  }
+  return summaries;
+}
+
+void LockProfiler::writeReport(std::ostream &os) {
+  os << std::left << std::setw(24) << "lock" << std::right << std::setw(12)
+     << "acquired" << std::setw(12) << "contended" << std::setw(10)
+     << "wait_p50" << std::setw(10) << "wait_p99" << std::setw(10)
+     << "wait_max" << std::setw(10) << "hold_p50" << std::setw(10)
+     << "hold_p99" << std::setw(10) << "hold_max" << std::endl;
+  os << std::fixed << std::setprecision(3);
+  for (const auto &summary : summaries()) {
+    os << std::left << std::setw(24) << summary.name << std::right
+       << std::setw(12) << summary.acquisitions << std::setw(12)
+       << summary.contended << std::setw(10) << summary.wait_p50 * 1e3
+       << std::setw(10) << summary.wait_p99 * 1e3 << std::setw(10)
+       << summary.wait_max * 1e3 << std::setw(10) << summary.hold_p50 * 1e3
+       << std::setw(10) << summary.hold_p99 * 1e3 << std::setw(10)
+       << summary.hold_max * 1e3 << std::endl;
+  }
+}
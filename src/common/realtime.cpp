@@ -0,0 +1,101 @@
+#include "aerial_autonomy/common/realtime.h"
+
+#include <glog/logging.h>
+
+#include <alloca.h>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace {
+/**
+* @brief Stack left untouched below the prefaulted memory for the frames of the
+* calling thread
+*/
+const size_t kStackSafetyMargin = 64 * 1024;
+}
+
+namespace realtime {
+bool lockMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    LOG(WARNING) << "Could not lock memory: " << std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+void prefaultStack(size_t bytes) {
+  if (bytes == 0) {
+    return;
+  }
+  pthread_attr_t attr;
+  int error = pthread_getattr_np(pthread_self(), &attr);
+  if (error != 0) {
+    LOG(WARNING) << "Could not get stack of thread, not prefaulting it: "
+                 << std::strerror(error);
+    return;
+  }
+  void *stack_address;
+  size_t stack_size;
+  error = pthread_attr_getstack(&attr, &stack_address, &stack_size);
+  pthread_attr_destroy(&attr);
+  if (error != 0) {
+    LOG(WARNING) << "Could not get stack of thread, not prefaulting it: "
+                 << std::strerror(error);
+    return;
+  }
+  // The stack grows down from the end of the reported range towards its
+  // lowest address, so the free stack ends at the address of a local variable
+  char top;
+  size_t free_bytes = &top - static_cast<char *>(stack_address);
+  size_t max_bytes =
+      free_bytes > kStackSafetyMargin ? free_bytes - kStackSafetyMargin : 0;
+  if (bytes > max_bytes) {
+    LOG(WARNING) << "Prefaulting " << max_bytes << " instead of " << bytes
+                 << " bytes of stack, the thread stack has " << stack_size
+                 << " bytes";
+    bytes = max_bytes;
+    if (bytes == 0) {
+      return;
+    }
+  }
+  // Write one byte per page so that every page gets mapped
+  volatile char *stack = static_cast<volatile char *>(alloca(bytes));
+  for (size_t i = 0; i < bytes; i += 4096) {
+    stack[i] = 0;
+  }
+  stack[bytes - 1] = 0;
+}
+
+bool setThreadPriority(int priority) {
+  sched_param param;
+  param.sched_priority = priority;
+  int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (error != 0) {
+    LOG(WARNING) << "Could not set SCHED_FIFO priority " << priority << ": "
+                 << std::strerror(error);
+    return false;
+  }
+  return true;
+}
+
+bool setThreadAffinity(const std::vector<int> &cpus) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      LOG(WARNING) << "Invalid CPU index " << cpu;
+      return false;
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (error != 0) {
+    LOG(WARNING) << "Could not set CPU affinity: " << std::strerror(error);
+    return false;
+  }
+  return true;
+}
+}
@@ -0,0 +1,250 @@
+#include "aerial_autonomy/common/replay_traces.h"
+#include "aerial_autonomy/common/conversions.h"
+#include "aerial_autonomy/common/math.h"
+#include "aerial_autonomy/log/stream_table.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+/**
+* @brief Data points of the connector and controller streams logged in the
+* same control step
+*/
+struct RowPair {
+  size_t input;  ///< Data point of the connector stream
+  size_t output; ///< Data point of the controller stream
+  double time;   ///< Time since the first pair in seconds
+};
+
+/**
+* @brief Pair every controller data point with the closest connector data
+* point. Pairs further apart than max_skew or not after the previous pair are
+* dropped
+*/
+std::vector<RowPair> pairRows(const StreamTable &inputs,
+                              const StreamTable &outputs, double max_skew) {
+  std::vector<RowPair> pairs;
+  int64_t skew = std::chrono::duration_cast<
+                     std::chrono::high_resolution_clock::duration>(
+                     std::chrono::duration<double>(max_skew))
+                     .count();
+  for (size_t output = 0; output < outputs.rows.size(); ++output) {
+    size_t input = inputs.nearestRow(outputs.times[output]);
+    if (input == inputs.rows.size() ||
+        std::abs(inputs.times[input] - outputs.times[output]) > skew) {
+      continue;
+    }
+    double time = 0;
+    if (!pairs.empty()) {
+      std::chrono::high_resolution_clock::duration time_diff(
+          outputs.times[output] - outputs.times[pairs.front().output]);
+      time = std::chrono::duration<double>(time_diff).count();
+      if (time - pairs.back().time < 1e-6) {
+        continue;
+      }
+    }
+    pairs.push_back(RowPair{input, output, time});
+  }
+  return pairs;
+}
+
+/**
+* @brief Find a block of consecutive columns starting at a header name
+*/
+size_t columns(const StreamTable &table, const std::string &name,
+               size_t count) {
+  size_t start = table.column(name);
+  if (start + count > table.names.size()) {
+    throw std::runtime_error("Stream header is missing columns after " +
+                             name);
+  }
+  return start;
+}
+
+/**
+* @brief Copy consecutive columns of a data point
+*/
+Eigen::VectorXd segment(const std::vector<double> &row, size_t start,
+                        size_t count) {
+  return Eigen::Map<const Eigen::VectorXd>(row.data() + start, count);
+}
+
+/**
+* @brief Reference control of a hovering quad
+*/
+Eigen::VectorXd hoverControl() {
+  Eigen::VectorXd control(4);
+  control << 1.0, 0, 0, 0;
+  return control;
+}
+
+/**
+* @brief Convert euler angle rates to body angular velocity
+*/
+Eigen::Vector3d bodyRates(const Eigen::Vector3d &rpy,
+                          const Eigen::Vector3d &rpy_dot) {
+  double sr = std::sin(rpy(0)), cr = std::cos(rpy(0));
+  double sp = std::sin(rpy(1)), cp = std::cos(rpy(1));
+  Eigen::Matrix3d euler_to_body;
+  euler_to_body << 1, 0, -sp, 0, cr, sr * cp, 0, -sr, cr * cp;
+  return euler_to_body * rpy_dot;
+}
+}
+
+namespace replay_traces {
+
+RPYTReferenceTrace
+rpytReferenceTrace(const boost::filesystem::path &log_directory,
+                   double max_skew) {
+  StreamTable inputs =
+      readStreamTable(log_directory / "rpyt_reference_connector");
+  StreamTable outputs =
+      readStreamTable(log_directory / "rpyt_reference_controller");
+  size_t kt = inputs.column("Thrust_gain");
+  size_t position = columns(inputs, "x", 3);
+  size_t yaw = inputs.column("yaw");
+  size_t velocity = columns(inputs, "vx", 3);
+  // Errorx, Errory, Errorz, Erroryaw, Errorvx, Errorvy, Errorvz
+  size_t error = columns(outputs, "Errorx", 7);
+  size_t command = columns(outputs, "Cmd_roll", 4);
+  auto reference = std::make_shared<
+      RecordedReferenceTrajectory<Eigen::VectorXd, Eigen::VectorXd>>();
+  RPYTReferenceTrace trace;
+  for (const auto &pair : pairRows(inputs, outputs, max_skew)) {
+    const std::vector<double> &input = inputs.rows[pair.input];
+    const std::vector<double> &output = outputs.rows[pair.output];
+    PositionYaw position_yaw(input[position], input[position + 1],
+                             input[position + 2], input[yaw]);
+    Velocity current_velocity(input[velocity], input[velocity + 1],
+                              input[velocity + 2]);
+    // State: position, rpy, velocity, rpydot, rpyd
+    Eigen::VectorXd state = Eigen::VectorXd::Zero(15);
+    state.segment<3>(0) =
+        segment(input, position, 3) + segment(output, error, 3);
+    state(5) = math::angleWrap(input[yaw] + output[error + 3]);
+    state.segment<3>(6) =
+        segment(input, velocity, 3) + segment(output, error + 4, 3);
+    reference->ts.push_back(pair.time);
+    reference->states.push_back(state);
+    reference->controls.push_back(hoverControl());
+    trace.sensor_data.push_back(std::make_tuple(
+        pair.time, input[kt], current_velocity, position_yaw));
+    trace.recorded_controls.push_back(segment(output, command, 4));
+  }
+  trace.goal = reference;
+  return trace;
+}
+
+QuadMPCTrace quadMPCTrace(const boost::filesystem::path &log_directory,
+                          double max_skew) {
+  StreamTable inputs =
+      readStreamTable(log_directory / "quad_mpc_state_estimator");
+  StreamTable outputs =
+      readStreamTable(log_directory / "ddp_quad_mpc_controller");
+  // x, y, z, r, p, y, vx, vy, vz, rdot, pdot, ydot, rd, pd, yd
+  size_t state = columns(inputs, "x", 15);
+  size_t kt = inputs.column("kt");
+  // x_ref, y_ref, z_ref, r_ref, p_ref, y_ref, vx_ref, vy_ref, vz_ref
+  size_t reference_state = columns(outputs, "x_ref", 9);
+  size_t command = columns(outputs, "thrust_d", 4);
+  auto reference = std::make_shared<
+      RecordedReferenceTrajectory<Eigen::VectorXd, Eigen::VectorXd>>();
+  QuadMPCTrace trace;
+  for (const auto &pair : pairRows(inputs, outputs, max_skew)) {
+    const std::vector<double> &input = inputs.rows[pair.input];
+    const std::vector<double> &output = outputs.rows[pair.output];
+    Eigen::VectorXd desired_state = Eigen::VectorXd::Zero(15);
+    desired_state.segment<9>(0) = segment(output, reference_state, 9);
+    reference->ts.push_back(pair.time);
+    reference->states.push_back(desired_state);
+    reference->controls.push_back(hoverControl());
+    MPCInputs<Eigen::VectorXd> mpc_inputs;
+    mpc_inputs.initial_state = segment(input, state, 15);
+    mpc_inputs.parameters = Eigen::VectorXd::Constant(1, input[kt]);
+    mpc_inputs.time_since_goal = pair.time;
+    trace.sensor_data.push_back(mpc_inputs);
+    trace.recorded_controls.push_back(segment(output, command, 4));
+  }
+  trace.goal = reference;
+  return trace;
+}
+
+QrotorBacksteppingTrace
+qrotorBacksteppingTrace(const boost::filesystem::path &log_directory,
+                        double max_skew) {
+  StreamTable inputs = readStreamTable(
+      log_directory / "qrotor_backstepping_controller_connector");
+  StreamTable outputs =
+      readStreamTable(log_directory / "qrotor_backstepping_controller");
+  size_t rpy = columns(inputs, "roll", 3);
+  size_t thrust = inputs.column("thrust");
+  size_t position = columns(outputs, "p_x", 3);
+  size_t desired_position = columns(outputs, "pd_x", 3);
+  size_t velocity = columns(outputs, "v_x", 3);
+  size_t desired_velocity = columns(outputs, "vd_x", 3);
+  auto reference =
+      std::make_shared<RecordedReferenceTrajectory<ParticleState, Snap>>();
+  QrotorBacksteppingTrace trace;
+  std::vector<RowPair> pairs = pairRows(inputs, outputs, max_skew);
+  Eigen::Vector3d previous_rpy, previous_acceleration;
+  Eigen::Vector3d previous_desired_velocity;
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    const std::vector<double> &input = inputs.rows[pairs[i].input];
+    const std::vector<double> &output = outputs.rows[pairs[i].output];
+    Eigen::Vector3d current_rpy = segment(input, rpy, 3);
+    Eigen::Vector3d current_desired_velocity =
+        segment(output, desired_velocity, 3);
+    QrotorBacksteppingState state;
+    tf::Transform pose;
+    conversions::transformRPYToTf(current_rpy(0), current_rpy(1),
+                                  current_rpy(2), pose);
+    pose.setOrigin(tf::Vector3(output[position], output[position + 1],
+                               output[position + 2]));
+    state.pose = pose;
+    state.v = tf::Vector3(output[velocity], output[velocity + 1],
+                          output[velocity + 2]);
+    // The connector logs the thrust after integrating the controls, so the
+    // thrust seen by the controller is the one logged in the previous step
+    const std::vector<double> &previous_input =
+        inputs.rows[pairs[i == 0 ? 0 : i - 1].input];
+    state.thrust = previous_input[thrust];
+    Eigen::Vector3d acceleration(0, 0, 0), jerk(0, 0, 0);
+    if (i > 0) {
+      double dt = pairs[i].time - pairs[i - 1].time;
+      Eigen::Vector3d rpy_dot;
+      for (int j = 0; j < 3; ++j) {
+        rpy_dot(j) = math::angleWrap(current_rpy(j) - previous_rpy(j)) / dt;
+      }
+      Eigen::Vector3d w = bodyRates(current_rpy, rpy_dot);
+      state.w = tf::Vector3(w(0), w(1), w(2));
+      if (i > 1) {
+        const std::vector<double> &older_input =
+            inputs.rows[pairs[i - 2].input];
+        state.thrust_dot = (state.thrust - older_input[thrust]) /
+                           (pairs[i - 1].time - pairs[i - 2].time);
+      }
+      acceleration =
+          (current_desired_velocity - previous_desired_velocity) / dt;
+      jerk = (acceleration - previous_acceleration) / dt;
+    }
+    reference->ts.push_back(pairs[i].time);
+    reference->states.push_back(ParticleState(
+        Position(output[desired_position], output[desired_position + 1],
+                 output[desired_position + 2]),
+        Velocity(current_desired_velocity(0), current_desired_velocity(1),
+                 current_desired_velocity(2)),
+        Acceleration(acceleration(0), acceleration(1), acceleration(2)),
+        Jerk(jerk(0), jerk(1), jerk(2))));
+    reference->controls.push_back(Snap());
+    trace.sensor_data.push_back(std::make_pair(pairs[i].time, state));
+    previous_rpy = current_rpy;
+    previous_acceleration = acceleration;
+    previous_desired_velocity = current_desired_velocity;
+  }
+  trace.goal = reference;
+  return trace;
+}
+}
@@ -0,0 +1,321 @@
+#include <aerial_autonomy/common/timer_executor.h>
+#include <aerial_autonomy/log/trace.h>
+
+#include <algorithm>
+#include <map>
+
+TimerStatistics::TimerStatistics(std::string name)
+    : name_(name), overruns_(0) {}
+
+void TimerStatistics::record(int64_t jitter, int64_t execution_time,
+                             bool overrun) {
+  jitter_.record(jitter);
+  execution_time_.record(execution_time);
+  if (overrun) {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+TimerStatistics::Summary TimerStatistics::summary() const {
+  Summary summary;
+  summary.name = name_;
+  summary.ticks = execution_time_.count();
+  summary.overruns = overruns_.load(std::memory_order_relaxed);
+  summary.jitter_p50 = jitter_.percentile(0.5) * 1e-9;
+  summary.jitter_p99 = jitter_.percentile(0.99) * 1e-9;
+  summary.jitter_max = jitter_.max() * 1e-9;
+  summary.execution_p50 = execution_time_.percentile(0.5) * 1e-9;
+  summary.execution_p99 = execution_time_.percentile(0.99) * 1e-9;
+  summary.execution_max = execution_time_.max() * 1e-9;
+  return summary;
+}
+
+TimerExecutor::TimerExecutor(size_t worker_count, std::string name,
+                             std::chrono::duration<double> resolution,
+                             std::function<void()> thread_setup)
+    : worker_count_(std::max<size_t>(worker_count, 1)), name_(name),
+      resolution_(std::max(
+          std::chrono::duration_cast<Clock::duration>(resolution),
+          Clock::duration(1))),
+      origin_(Clock::now()), thread_setup_(thread_setup), current_tick_(0),
+      next_id_(0), wheel_(kWheelSlots), busy_(0), timer_waiter_(false),
+      waiter_tick_(0), stopping_(false) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    workers_.emplace_back(&TimerExecutor::workerLoop, this, i);
+  }
+}
+
+TimerExecutor::~TimerExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+TimerExecutor::TaskId
+TimerExecutor::schedule(std::function<void()> function,
+                        std::chrono::duration<double> period,
+                        TimerPriority priority, const char *trace_name,
+                        std::shared_ptr<TimerStatistics> statistics) {
+  auto task = std::make_shared<Task>();
+  task->function = function;
+  task->period = std::chrono::duration_cast<Clock::duration>(period);
+  task->priority = priority;
+  task->trace_name = trace_name;
+  task->running = false;
+  task->cancelled = false;
+  task->trigger_pending = false;
+  task->statistics = statistics
+                         ? statistics
+                         : std::make_shared<TimerStatistics>(trace_name);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task->id = next_id_++;
+    tasks_[task->id] = task;
+    task->deadline = Clock::now();
+    insert(task, task->deadline);
+  }
+  work_cv_.notify_all();
+  return task->id;
+}
+
+void TimerExecutor::cancel(TaskId id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = tasks_.find(id);
+  if (it == tasks_.end()) {
+    return;
+  }
+  std::shared_ptr<Task> task = it->second;
+  tasks_.erase(it);
+  task->cancelled = true;
+  ready_.erase(std::remove(ready_.begin(), ready_.end(), task), ready_.end());
+  auto &slot = wheel_[task->expiry_tick % kWheelSlots];
+  slot.erase(std::remove(slot.begin(), slot.end(), task), slot.end());
+  while (task->running && task->worker != std::this_thread::get_id()) {
+    done_cv_.wait(lock);
+  }
+}
+
+void TimerExecutor::trigger(TaskId id,
+                            std::chrono::duration<double> min_interval) {
+  bool wake_waiter = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+      return;
+    }
+    std::shared_ptr<Task> task = it->second;
+    auto interval = std::chrono::duration_cast<Clock::duration>(min_interval);
+    if (task->running) {
+      task->trigger_pending = true;
+      task->trigger_min_interval = interval;
+      return;
+    }
+    Clock::time_point now = Clock::now();
+    Clock::time_point deadline = std::max(now, task->last_start + interval);
+    if (deadline >= task->deadline) {
+      // Already due by then
+      return;
+    }
+    ready_.erase(std::remove(ready_.begin(), ready_.end(), task),
+                 ready_.end());
+    auto &slot = wheel_[task->expiry_tick % kWheelSlots];
+    slot.erase(std::remove(slot.begin(), slot.end(), task), slot.end());
+    task->deadline = deadline;
+    insert(task, now);
+    // A rate capped deadline can be earlier than the one a worker waits for,
+    // and notify_one may wake another worker instead
+    wake_waiter = timer_waiter_ && task->expiry_tick < waiter_tick_;
+  }
+  if (wake_waiter) {
+    work_cv_.notify_all();
+  } else {
+    work_cv_.notify_one();
+  }
+}
+
+void TimerExecutor::setPeriod(TaskId id,
+                              std::chrono::duration<double> period) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+      return;
+    }
+    std::shared_ptr<Task> task = it->second;
+    task->period = std::chrono::duration_cast<Clock::duration>(period);
+    if (task->running) {
+      // The next deadline is computed with the new period when the call ends
+      return;
+    }
+    ready_.erase(std::remove(ready_.begin(), ready_.end(), task),
+                 ready_.end());
+    auto &slot = wheel_[task->expiry_tick % kWheelSlots];
+    slot.erase(std::remove(slot.begin(), slot.end(), task), slot.end());
+    Clock::time_point now = Clock::now();
+    task->deadline = std::max(now, task->last_start + task->period);
+    insert(task, now);
+  }
+  // The deadline may be earlier than the one a worker waits for
+  work_cv_.notify_all();
+}
+
+std::vector<TimerStatistics::Summary> TimerExecutor::statistics() {
+  std::map<TaskId, std::shared_ptr<TimerStatistics>> statistics;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &task : tasks_) {
+      statistics[task.first] = task.second->statistics;
+    }
+  }
+  std::vector<TimerStatistics::Summary> summaries;
+  for (const auto &entry : statistics) {
+    summaries.push_back(entry.second->summary());
+  }
+  return summaries;
+}
+
+size_t TimerExecutor::workerCount() const { return worker_count_; }
+
+void TimerExecutor::workerLoop(size_t index) {
+  Tracer::instance().setThreadName(
+      worker_count_ == 1 ? name_ : name_ + "_" + std::to_string(index));
+  if (thread_setup_) {
+    thread_setup_();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    advance(Clock::now());
+    std::shared_ptr<Task> task = popReady();
+    if (!task) {
+      // A single worker sleeps until the next deadline, the others until
+      // they are woken up
+      uint64_t tick;
+      if (!timer_waiter_ && nextExpiry(tick)) {
+        timer_waiter_ = true;
+        waiter_tick_ = tick;
+        work_cv_.wait_until(lock, origin_ + resolution_ * Clock::rep(tick));
+        timer_waiter_ = false;
+      } else {
+        work_cv_.wait(lock);
+      }
+      continue;
+    }
+    uint64_t tick;
+    if (!ready_.empty() || (!timer_waiter_ && nextExpiry(tick))) {
+      // Hand over the remaining work and the wait for the next deadline
+      work_cv_.notify_one();
+    }
+    task->running = true;
+    task->worker = std::this_thread::get_id();
+    ++busy_;
+    Clock::time_point deadline = task->deadline;
+    Clock::duration period = task->period;
+    lock.unlock();
+    Clock::time_point start = Clock::now();
+    {
+      TraceSpan span(task->trace_name);
+      task->function();
+    }
+    Clock::time_point now = Clock::now();
+    task->statistics->record(
+        std::chrono::nanoseconds(start - deadline).count(),
+        std::chrono::nanoseconds(now - start).count(),
+        now > deadline + period);
+    lock.lock();
+    task->running = false;
+    task->last_start = start;
+    --busy_;
+    if (!task->cancelled) {
+      // Keep the period without drift. An overrun call is followed by the
+      // next one immediately, without trying to catch up on missed calls
+      task->deadline = std::max(task->deadline + task->period, now);
+      if (task->trigger_pending) {
+        task->deadline = std::min(
+            task->deadline, std::max(now, start + task->trigger_min_interval));
+        task->trigger_pending = false;
+      }
+      insert(task, now);
+      if (timer_waiter_ && task->expiry_tick < waiter_tick_) {
+        work_cv_.notify_all();
+      }
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void TimerExecutor::insert(const std::shared_ptr<Task> &task,
+                           Clock::time_point now) {
+  task->expiry_tick = toTick(task->deadline);
+  if (task->deadline <= now || task->expiry_tick <= current_tick_) {
+    ready_.push_back(task);
+  } else {
+    wheel_[task->expiry_tick % kWheelSlots].push_back(task);
+  }
+}
+
+void TimerExecutor::advance(Clock::time_point now) {
+  uint64_t now_tick = (now - origin_) / resolution_;
+  if (now_tick <= current_tick_) {
+    return;
+  }
+  // Visit every slot at most once, even if the wheel turned several times
+  uint64_t steps = std::min<uint64_t>(now_tick - current_tick_, kWheelSlots);
+  for (uint64_t tick = now_tick - steps + 1; tick <= now_tick; ++tick) {
+    auto &slot = wheel_[tick % kWheelSlots];
+    for (size_t i = 0; i < slot.size();) {
+      if (slot[i]->expiry_tick <= now_tick) {
+        ready_.push_back(slot[i]);
+        slot[i] = slot.back();
+        slot.pop_back();
+      } else {
+        ++i;
+      }
+    }
+  }
+  current_tick_ = now_tick;
+}
+
+std::shared_ptr<TimerExecutor::Task> TimerExecutor::popReady() {
+  // Keep a worker free for higher priority work
+  bool low_allowed = worker_count_ == 1 || busy_ + 1 < worker_count_;
+  auto best = ready_.end();
+  for (auto it = ready_.begin(); it != ready_.end(); ++it) {
+    if ((*it)->priority == TimerPriority::Low && !low_allowed) {
+      continue;
+    }
+    if (best == ready_.end() || (*it)->priority > (*best)->priority ||
+        ((*it)->priority == (*best)->priority &&
+         (*it)->deadline < (*best)->deadline)) {
+      best = it;
+    }
+  }
+  if (best == ready_.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<Task> task = *best;
+  ready_.erase(best);
+  return task;
+}
+
+bool TimerExecutor::nextExpiry(uint64_t &tick) const {
+  bool found = false;
+  for (const auto &slot : wheel_) {
+    for (const auto &task : slot) {
+      if (!found || task->expiry_tick < tick) {
+        tick = task->expiry_tick;
+        found = true;
+      }
+    }
+  }
+  return found;
+}
+
+uint64_t TimerExecutor::toTick(Clock::time_point time) const {
+  return ((time - origin_) + resolution_ - Clock::duration(1)) / resolution_;
+}
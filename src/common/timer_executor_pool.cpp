@@ -0,0 +1,66 @@
+#include "aerial_autonomy/common/timer_executor_pool.h"
+#include "aerial_autonomy/common/realtime.h"
+
+#include <glog/logging.h>
+
+#include <stdexcept>
+
+TimerExecutorPool::TimerExecutorPool(size_t worker_count,
+                                     const RealtimeConfig &config)
+    : memory_locked_(config.lock_memory() && realtime::lockMemory()) {
+  // Lock memory before starting the workers so that their stacks are locked
+  if (config.lock_memory() && !memory_locked_) {
+    LOG(ERROR) << "Timers run without locked memory";
+  }
+  const size_t prefault_bytes = config.prefault_stack_bytes();
+  shared_executor_ = std::make_shared<TimerExecutor>(
+      worker_count, "timer_executor", std::chrono::microseconds(100),
+      [prefault_bytes] { realtime::prefaultStack(prefault_bytes); });
+  for (const auto &timer_config : config.timers()) {
+    if (executor(timer_config.timer()) != shared_executor_) {
+      throw std::runtime_error("Duplicate real-time config for timer: " +
+                               timer_config.timer());
+    }
+    auto thread_setup = [timer_config, prefault_bytes] {
+      realtime::prefaultStack(prefault_bytes);
+      std::vector<int> cpus(timer_config.cpus().begin(),
+                            timer_config.cpus().end());
+      if (!cpus.empty() && !realtime::setThreadAffinity(cpus)) {
+        LOG(ERROR) << timer_config.timer() << " runs without CPU affinity";
+      }
+      if (timer_config.priority() != 0 &&
+          !realtime::setThreadPriority(timer_config.priority())) {
+        LOG(ERROR) << timer_config.timer()
+                   << " runs without real-time priority";
+      }
+    };
+    realtime_executors_.emplace_back(
+        timer_config.timer(),
+        std::make_shared<TimerExecutor>(1, timer_config.timer(),
+                                        std::chrono::microseconds(100),
+                                        thread_setup));
+  }
+}
+
+std::shared_ptr<TimerExecutor>
+TimerExecutorPool::executor(const std::string &timer_name) const {
+  for (const auto &entry : realtime_executors_) {
+    if (entry.first == timer_name) {
+      return entry.second;
+    }
+  }
+  return shared_executor_;
+}
+
+std::vector<TimerStatistics::Summary> TimerExecutorPool::statistics() const {
+  std::vector<TimerStatistics::Summary> summaries =
+      shared_executor_->statistics();
+  for (const auto &entry : realtime_executors_) {
+    auto executor_summaries = entry.second->statistics();
+    summaries.insert(summaries.end(), executor_summaries.begin(),
+                     executor_summaries.end());
+  }
+  return summaries;
+}
+
+bool TimerExecutorPool::memoryLocked() const { return memory_locked_; }
@@ -4,18 +4,20 @@
 ArmSineControllerConnector::ArmSineControllerConnector(
     ArmParser &arm_hardware, ArmSineController &controller)
     : ControllerConnector(controller, ControllerGroup::Arm),
-      arm_hardware_(arm_hardware), private_ref_controller_(controller) {
+      arm_hardware_(arm_hardware), private_ref_controller_(controller),
+      log_stream_(
+          Log::current().registerStream("arm_sine_controller_connector")) {
   // \todo Add a function to get number of joints instead of calling joint
   // angles to arm parser
   std::vector<double> joint_angles = arm_hardware_.getJointAngles();
-  Log::instance()["arm_sine_controller_connector"] << DataStream::starth;
+  Log::current()["arm_sine_controller_connector"] << DataStream::starth;
   int N = joint_angles.size();
   for (int i = 0; i < N; ++i) {
     std::string ja_header = "Ja_" + std::to_string(i);
     std::string jv_header = "Jv_" + std::to_string(i);
-    Log::instance()["arm_sine_controller_connector"] << ja_header << jv_header;
+    Log::current()["arm_sine_controller_connector"] << ja_header << jv_header;
   }
-  Log::instance()["arm_sine_controller_connector"] << DataStream::endl;
+  Log::current()["arm_sine_controller_connector"] << DataStream::endl;
 }
 
 void ArmSineControllerConnector::sendControllerCommands(
@@ -28,12 +30,12 @@ void ArmSineControllerConnector::sendControllerCommands(
 bool ArmSineControllerConnector::extractSensorData(EmptySensor &) {
   std::vector<double> joint_angles = arm_hardware_.getJointAngles();
   std::vector<double> joint_velocities = arm_hardware_.getJointVelocities();
-  Log::instance()["arm_sine_controller_connector"] << DataStream::startl;
+  DataStream &data_stream = Log::current()[log_stream_];
+  data_stream << DataStream::startl;
   int N = joint_angles.size();
   for (int i = 0; i < N; ++i) {
-    Log::instance()["arm_sine_controller_connector"] << joint_angles.at(i)
-                                                     << joint_velocities.at(i);
+    data_stream << joint_angles.at(i) << joint_velocities.at(i);
   }
-  Log::instance()["arm_sine_controller_connector"] << DataStream::endl;
+  data_stream << DataStream::endl;
   return true;
 }
@@ -16,7 +16,7 @@ BaseMPCControllerQuadConnector::BaseMPCControllerQuadConnector(
       thrust_gain_estimator_(thrust_gain_estimator),
       rpydot_filter_(config.rpydot_gain()),
       delay_buffer_size_(delay_buffer_size), private_controller_(controller),
-      config_(config) {
+      config_(config), odom_sequence_(0) {
   clearCommandBuffers();
 }
 
@@ -62,6 +62,7 @@ void BaseMPCControllerQuadConnector::usePerfectTimeDiff(double time_diff) {
 void BaseMPCControllerQuadConnector::useSensor(
     SensorPtr<std::pair<tf::StampedTransform, tf::Vector3>> sensor) {
   odom_sensor_ = sensor;
+  odom_sequence_ = 0;
 }
 
 bool BaseMPCControllerQuadConnector::fillQuadStateAndParameters(
@@ -69,37 +70,41 @@ bool BaseMPCControllerQuadConnector::fillQuadStateAndParameters(
   // Get Quad data
   parsernode::common::quaddata quad_data;
   drone_hardware_.getquaddata(quad_data);
-  tf::Transform quad_pose;
+  Eigen::Vector3d p;
+  Eigen::Vector3d rpy;
   Eigen::Vector3d velocity;
   if (odom_sensor_) {
     if (odom_sensor_->getSensorStatus() != SensorStatus::VALID) {
       LOG(WARNING) << "Sensor invalid";
       return false;
     }
-    auto quad_pose_velocity_pair = odom_sensor_->getSensorData();
-    quad_pose = quad_pose_velocity_pair.first;
-    velocity = Eigen::Vector3d(quad_pose_velocity_pair.second.x(),
-                               quad_pose_velocity_pair.second.y(),
-                               quad_pose_velocity_pair.second.z());
+    auto sample = odom_sensor_->getSample();
+    // Convert the pose only once per sample
+    if (sample.sequence == 0 || sample.sequence != odom_sequence_) {
+      odom_sequence_ = sample.sequence;
+      const tf::StampedTransform &quad_pose = sample.data.first;
+      const auto &quad_position = quad_pose.getOrigin();
+      odom_position_ = Eigen::Vector3d(quad_position.x(), quad_position.y(),
+                                       quad_position.z());
+      odom_rpy_ = conversions::transformTfToRPY(quad_pose);
+      const tf::Vector3 &quad_velocity = sample.data.second;
+      odom_velocity_ = Eigen::Vector3d(quad_velocity.x(), quad_velocity.y(),
+                                       quad_velocity.z());
+    }
+    p = odom_position_;
+    rpy = odom_rpy_;
+    velocity = odom_velocity_;
   } else {
-    quad_pose = conversions::getPose(quad_data);
+    p = Eigen::Vector3d(quad_data.localpos.x, quad_data.localpos.y,
+                        quad_data.localpos.z);
+    rpy = Eigen::Vector3d(quad_data.rpydata.x, quad_data.rpydata.y,
+                          quad_data.rpydata.z);
     velocity = Eigen::Vector3d(quad_data.linvel.x, quad_data.linvel.y,
                                quad_data.linvel.z);
   }
-  // Position
-  const auto &quad_position = quad_pose.getOrigin();
-  Eigen::Vector3d p(quad_position.x(), quad_position.y(), quad_position.z());
-  Eigen::Vector3d rpy;
   Eigen::Vector3d omega(quad_data.omega.x, quad_data.omega.y,
                         quad_data.omega.z);
   Eigen::Vector2d roll_pitch_bias = thrust_gain_estimator_.getRollPitchBias();
-  // Euler angles
-  if (odom_sensor_) {
-    rpy = conversions::transformTfToRPY(quad_pose);
-  } else {
-    rpy = Eigen::Vector3d(quad_data.rpydata.x, quad_data.rpydata.y,
-                          quad_data.rpydata.z);
-  }
   rpy[0] = quad_data.rpydata.x + roll_pitch_bias[0];
   rpy[1] = quad_data.rpydata.y + roll_pitch_bias[1];
   Eigen::Vector3d filtered_rpydot =
@@ -30,50 +30,47 @@ double BaseRelativePoseVisualServoingConnector::getViewingAngle(
 }
 
 void BaseRelativePoseVisualServoingConnector::logTrackerData(
-    string stream_name, tf::Transform tracking_pose,
-    tf::Transform object_pose_cam, parsernode::common::quaddata &quad_data) {
+    tf::Transform tracking_pose, tf::Transform object_pose_cam,
+    parsernode::common::quaddata &quad_data) {
   auto tracking_origin = tracking_pose.getOrigin();
   double tracking_r, tracking_p, tracking_y;
   tracking_pose.getBasis().getRPY(tracking_r, tracking_p, tracking_y);
   auto object_origin = object_pose_cam.getOrigin();
   double object_r, object_p, object_y;
   object_pose_cam.getBasis().getRPY(object_r, object_p, object_y);
-  DATA_LOG(stream_name) << quad_data.linvel.x << quad_data.linvel.y
-                        << quad_data.linvel.z << quad_data.rpydata.x
-                        << quad_data.rpydata.y << quad_data.rpydata.z
-                        << quad_data.omega.x << quad_data.omega.y
-                        << quad_data.omega.z << tracking_origin.x()
-                        << tracking_origin.y() << tracking_origin.z()
-                        << tracking_r << tracking_p << tracking_y
-                        << object_origin.x() << object_origin.y()
-                        << object_origin.z() << object_r << object_p << object_y
-                        << getViewingAngle(object_pose_cam)
-                        << tracking_origin.length() << DataStream::endl;
+  DATA_LOG(tracker_log_stream_)
+      << quad_data.linvel.x << quad_data.linvel.y << quad_data.linvel.z
+      << quad_data.rpydata.x << quad_data.rpydata.y << quad_data.rpydata.z
+      << quad_data.omega.x << quad_data.omega.y << quad_data.omega.z
+      << tracking_origin.x() << tracking_origin.y() << tracking_origin.z()
+      << tracking_r << tracking_p << tracking_y << object_origin.x()
+      << object_origin.y() << object_origin.z() << object_r << object_p
+      << object_y << getViewingAngle(object_pose_cam)
+      << tracking_origin.length() << DataStream::endl;
 }
 
-void BaseRelativePoseVisualServoingConnector::logTrackerHeader(
-    string stream_name) {
-  DATA_HEADER(stream_name) << "vel_x"
-                           << "vel_y"
-                           << "vel_z"
-                           << "roll"
-                           << "pitch"
-                           << "yaw"
-                           << "omega_x"
-                           << "omega_y"
-                           << "omega_z"
-                           << "tracking_x"
-                           << "tracking_y"
-                           << "tracking_z"
-                           << "tracking_r"
-                           << "tracking_p"
-                           << "tracking_y"
-                           << "object_x"
-                           << "object_y"
-                           << "object_z"
-                           << "object_r"
-                           << "object_p"
-                           << "object_y"
-                           << "Viewing_angle"
-                           << "Tracking_length" << DataStream::endl;
+void BaseRelativePoseVisualServoingConnector::logTrackerHeader() {
+  DATA_HEADER(tracker_log_stream_) << "vel_x"
+                                   << "vel_y"
+                                   << "vel_z"
+                                   << "roll"
+                                   << "pitch"
+                                   << "yaw"
+                                   << "omega_x"
+                                   << "omega_y"
+                                   << "omega_z"
+                                   << "tracking_x"
+                                   << "tracking_y"
+                                   << "tracking_z"
+                                   << "tracking_r"
+                                   << "tracking_p"
+                                   << "tracking_y"
+                                   << "object_x"
+                                   << "object_y"
+                                   << "object_z"
+                                   << "object_r"
+                                   << "object_p"
+                                   << "object_y"
+                                   << "Viewing_angle"
+                                   << "Tracking_length" << DataStream::endl;
 }
@@ -1,3 +1,4 @@
+#include <aerial_autonomy/common/clock.h>
 #include <aerial_autonomy/common/conversions.h>
 #include <aerial_autonomy/common/math.h>
 #include <aerial_autonomy/controller_connectors/mpc_controller_airm_connector.h>
@@ -17,7 +18,8 @@ MPCControllerAirmConnector::MPCControllerAirmConnector(
                                      config, odom_sensor, constraint_generator),
       arm_hardware_(arm_hardware), joint_angle_commands_(2),
       joint_velocity_filter_(config.joint_velocity_exp_gain()),
-      previous_joint_measurements_initialized_(false) {
+      previous_joint_measurements_initialized_(false),
+      log_stream_(Log::current().registerStream("airm_mpc_state_estimator")) {
   clearJointCommandBuffers();
   // clang-format off
   DATA_HEADER("airm_mpc_state_estimator") << "x" << "y" << "z"
@@ -34,7 +36,7 @@ MPCControllerAirmConnector::MPCControllerAirmConnector(
 }
 
 void MPCControllerAirmConnector::initialize() {
-  previous_measurement_time_ = std::chrono::high_resolution_clock::now();
+  previous_measurement_time_ = Clock::instance().now();
   previous_joint_measurements_initialized_ = false;
   joint_velocity_filter_.reset();
   clearJointCommandBuffers();
@@ -64,7 +66,7 @@ void MPCControllerAirmConnector::sendControllerCommands(ControlType control) {
 
 double MPCControllerAirmConnector::getTimeDiff() {
   // Timing logic
-  auto current_time = std::chrono::high_resolution_clock::now();
+  auto current_time = Clock::instance().now();
   double dt =
       std::chrono::duration<double>(current_time - previous_measurement_time_)
           .count();
@@ -106,7 +108,7 @@ bool MPCControllerAirmConnector::estimateStateAndParameters(
   // Fill Quad stuff
   bool result = fillQuadStateAndParameters(current_state, params);
   if (result) {
-    DATA_LOG("airm_mpc_state_estimator")
+    DATA_LOG(log_stream_)
         << current_state << params[0]
         << thrust_gain_estimator_.getRollPitchBias() << DataStream::endl;
   }
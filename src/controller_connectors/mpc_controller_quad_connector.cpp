@@ -14,7 +14,8 @@ MPCControllerQuadConnector::MPCControllerQuadConnector(
     AbstractConstraintGeneratorPtr constraint_generator)
     : BaseMPCControllerQuadConnector(
           drone_hardware, controller, thrust_gain_estimator, delay_buffer_size,
-          config, odom_sensor, constraint_generator) {
+          config, odom_sensor, constraint_generator),
+      log_stream_(Log::current().registerStream("quad_mpc_state_estimator")) {
   // clang-format off
   DATA_HEADER("quad_mpc_state_estimator") << "x" << "y" << "z"
                                           << "r" << "p" << "y"
@@ -34,7 +35,7 @@ bool MPCControllerQuadConnector::estimateStateAndParameters(
   current_state.resize(state_size_);
   bool result = fillQuadStateAndParameters(current_state, params);
   if (result) {
-    DATA_LOG("quad_mpc_state_estimator")
+    DATA_LOG(log_stream_)
         << current_state << params[0]
         << thrust_gain_estimator_.getRollPitchBias() << DataStream::endl;
   }
@@ -8,7 +8,7 @@ bool QrotorBacksteppingControllerConnector::extractSensorData(
 
   std::chrono::duration<double> time_duration =
       std::chrono::duration_cast<std::chrono::duration<double>>(
-          std::chrono::high_resolution_clock::now() - t_0_);
+          Clock::instance().now() - t_0_);
   double current_time = time_duration.count();
   parsernode::common::quaddata data;
   drone_hardware_.getquaddata(data);
@@ -65,8 +65,7 @@ void QrotorBacksteppingControllerConnector::sendControllerCommands(
       config_.jyy(), config_.jyz(), config_.jzx(), config_.jzy(), config_.jzz();
   double Thrust_ddot = control.thrust_ddot;
   tf::Vector3 Torque = control.torque;
-  std::chrono::time_point<std::chrono::high_resolution_clock> current_time =
-      std::chrono::high_resolution_clock::now();
+  Clock::time_point current_time = Clock::instance().now();
   std::chrono::duration<double> dt_duration =
       std::chrono::duration_cast<std::chrono::duration<double>>(current_time -
                                                                 previous_time_);
@@ -99,7 +98,7 @@ void QrotorBacksteppingControllerConnector::sendControllerCommands(
   drone_hardware_.cmdrpyawratethrust(rpyt_message_);
   thrust_gain_estimator_.addThrustCommand(rpyt_message_.w);
 
-  DATA_LOG("qrotor_backstepping_controller_connector")
+  DATA_LOG(log_stream_)
       << current_rpy_(0) << current_rpy_(1) << current_rpy_(2)
       << rpyt_message_.x << rpyt_message_.y << rpyt_message_.z << thrust_
       << DataStream::endl;
@@ -108,8 +107,8 @@ void QrotorBacksteppingControllerConnector::sendControllerCommands(
 void QrotorBacksteppingControllerConnector::setGoal(
     std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> goal) {
   BaseClass::setGoal(goal);
-  t_0_ = std::chrono::high_resolution_clock::now();
-  previous_time_ = std::chrono::high_resolution_clock::now();
+  t_0_ = Clock::instance().now();
+  previous_time_ = Clock::instance().now();
   // Initial state
   thrust_ = m_ * g_;
   thrust_dot_ = 0;
@@ -14,8 +14,7 @@ bool RelativePoseVisualServoingControllerDroneConnector::extractSensorData(
   tf::Transform tracking_pose =
       getTrackingTransformRotationCompensatedQuadFrame(object_pose_cam,
                                                        body_frame_rotation);
-  logTrackerData("relative_pose_visual_servoing_controller_drone_connector",
-                 tracking_pose, object_pose_cam, quad_data);
+  logTrackerData(tracking_pose, object_pose_cam, quad_data);
   // giving transform in rotation-compensated quad frame
   sensor_data = std::make_tuple(body_frame_rotation, tracking_pose);
   return true;
@@ -15,8 +15,7 @@ bool RPYTRelativePoseVisualServoingConnector::extractSensorData(
   tf::Transform tracking_pose =
       getTrackingTransformRotationCompensatedQuadFrame(object_pose_cam,
                                                        body_frame_rotation);
-  logTrackerData("rpyt_relative_pose_visual_servoing_connector", tracking_pose,
-                 object_pose_cam, quad_data);
+  logTrackerData(tracking_pose, object_pose_cam, quad_data);
   // giving transform in rotation-compensated quad frame
   sensor_data =
       std::make_tuple(body_frame_rotation, tracking_pose,
@@ -30,7 +29,7 @@ bool RPYTRelativePoseVisualServoingConnector::extractSensorData(
                                        body_acc);
   acceleration_bias_estimator_.addSensorData(quad_data.rpydata.x,
                                              quad_data.rpydata.y, body_acc_eig);
-  DATA_LOG("acceleration_bias_estimator")
+  DATA_LOG(acceleration_bias_log_stream_)
       << acceleration_bias_estimator_.getAccelerationBias()
       << quad_data.rpydata.x << quad_data.rpydata.y << quad_data.rpydata.z
       << body_acc_eig << DataStream::endl;
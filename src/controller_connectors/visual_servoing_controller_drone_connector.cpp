@@ -10,7 +10,7 @@ bool VisualServoingControllerDroneConnector::extractSensorData(
     VLOG(1) << "Cannot Find tracking vector of ROI";
     return false;
   }
-  DATA_LOG("visual_servoing_controller_drone_connector")
+  DATA_LOG(log_stream_)
       << quad_data.linvel.x << quad_data.linvel.y << quad_data.linvel.z
       << quad_data.rpydata.x << quad_data.rpydata.y << quad_data.rpydata.z
       << quad_data.omega.x << quad_data.omega.y << quad_data.omega.z
@@ -0,0 +1,197 @@
+#include <aerial_autonomy/common/proto_utils.h>
+#include <aerial_autonomy/common/replay_traces.h>
+#include <aerial_autonomy/controllers/ddp_quad_mpc_controller.h>
+#include <aerial_autonomy/controllers/qrotor_backstepping_controller.h>
+#include <aerial_autonomy/controllers/rpyt_based_reference_controller.h>
+
+#include <glog/logging.h>
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/**
+* @brief Print usage of controller_replay
+* @param program Program name
+*/
+void printUsage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " [-j threads] [-s max_skew] [-t controller_duration]"
+               " rpyt_reference|quad_mpc|qrotor_backstepping log_directory"
+               " config.pbtxt [config.pbtxt ...]"
+            << std::endl;
+}
+
+/**
+* @brief Load the controller configs given on the command line
+* @param paths Paths of the text proto configs
+* @param configs Output, configs named by their path
+* @return False if a config cannot be loaded
+*/
+template <class ConfigT>
+bool loadConfigs(const std::vector<std::string> &paths,
+                 std::vector<std::pair<std::string, ConfigT>> &configs) {
+  for (const auto &path : paths) {
+    ConfigT config;
+    if (!proto_utils::loadProtoText(path, config)) {
+      LOG(ERROR) << "Cannot load proto file for the controller: " << path;
+      return false;
+    }
+    configs.emplace_back(path, config);
+  }
+  return true;
+}
+
+/**
+* @brief Print the replay results as a table
+* @param results Replay results
+* @param baseline Whether the deviation is relative to the first config
+* instead of the recorded controls
+*/
+void printResults(const std::vector<ReplayResult> &results, bool baseline) {
+  std::cout << "config,steps,failures,mean_solve_ms,max_solve_ms,"
+            << (baseline ? "rms_deviation_from_baseline"
+                         : "rms_deviation_from_log")
+            << std::endl;
+  for (const auto &result : results) {
+    std::cout << result.name << ",";
+    if (!result.error.empty()) {
+      std::cout << "error: " << result.error << std::endl;
+      continue;
+    }
+    std::cout << result.steps << "," << result.failures << ","
+              << std::setprecision(4) << 1e3 * result.mean_solve_time << ","
+              << 1e3 * result.max_solve_time << ",";
+    for (int i = 0; i < result.rms_deviation.size(); ++i) {
+      std::cout << (i > 0 ? " " : "") << result.rms_deviation(i);
+    }
+    std::cout << std::endl;
+  }
+}
+
+/**
+* @brief Replay the configs and print the results
+*/
+template <class SensorDataT, class GoalT, class ControlT, class ConfigT>
+int replay(ReplayTrace<SensorDataT, GoalT> trace,
+           const std::vector<std::string> &config_paths,
+           typename ControllerReplay<SensorDataT, GoalT, ControlT,
+                                     ConfigT>::Factory factory,
+           typename ControllerReplay<SensorDataT, GoalT, ControlT,
+                                     ConfigT>::ControlToVector to_vector,
+           unsigned threads) {
+  using Replay = ControllerReplay<SensorDataT, GoalT, ControlT, ConfigT>;
+  std::vector<typename Replay::NamedConfig> configs;
+  if (!loadConfigs(config_paths, configs)) {
+    return 1;
+  }
+  if (trace.sensor_data.empty()) {
+    LOG(ERROR) << "No controller steps could be reconstructed from the logs";
+    return 1;
+  }
+  LOG(INFO) << "Replaying " << trace.sensor_data.size() << " steps with "
+            << configs.size() << " configs";
+  bool baseline = trace.recorded_controls.empty();
+  Replay controller_replay(std::move(trace), factory, to_vector);
+  printResults(controller_replay.replay(configs, threads), baseline);
+  return 0;
+}
+
+/**
+* @brief Replay logged controller inputs with alternate controller configs.
+*
+* Reconstructs the sensor data and reference of a recorded run from the
+* DataStream files of a controller and its connector in log_directory (see
+* replay_traces), runs one controller per config on the recorded inputs in
+* parallel and prints, per config, the time spent in the controller and the RMS
+* deviation of its controls from the logged controls. Passing the config that
+* was flown shows how closely the run could be reconstructed.
+*/
+int main(int argc, char **argv) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+  google::InitGoogleLogging(argv[0]);
+  unsigned threads = 0;
+  double max_skew = 5e-3;
+  double controller_duration = 0.02;
+  int option;
+  while ((option = getopt(argc, argv, "j:s:t:")) != -1) {
+    switch (option) {
+    case 'j':
+      threads = std::stoul(optarg);
+      break;
+    case 's':
+      max_skew = std::stod(optarg);
+      break;
+    case 't':
+      controller_duration = std::stod(optarg);
+      break;
+    default:
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (optind + 3 > argc) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  std::string controller(argv[optind]);
+  std::string log_directory(argv[optind + 1]);
+  std::vector<std::string> config_paths(argv + optind + 2, argv + argc);
+  try {
+    if (controller == "rpyt_reference") {
+      using SensorDataT = std::tuple<double, double, Velocity, PositionYaw>;
+      using GoalT = ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd>;
+      return replay<SensorDataT, GoalT, RollPitchYawRateThrust,
+                    RPYTBasedPositionControllerConfig>(
+          replay_traces::rpytReferenceTrace(log_directory, max_skew),
+          config_paths,
+          [](const RPYTBasedPositionControllerConfig &config) {
+            return std::unique_ptr<Controller<SensorDataT, GoalT,
+                                              RollPitchYawRateThrust>>(
+                new RPYTBasedReferenceControllerEigen(config));
+          },
+          [](const RollPitchYawRateThrust &control) {
+            return Eigen::Vector4d(control.r, control.p, control.y, control.t);
+          },
+          threads);
+    } else if (controller == "quad_mpc") {
+      using SensorDataT = MPCInputs<Eigen::VectorXd>;
+      using GoalT = ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd>;
+      return replay<SensorDataT, GoalT, Eigen::VectorXd,
+                    QuadMPCControllerConfig>(
+          replay_traces::quadMPCTrace(log_directory, max_skew), config_paths,
+          [controller_duration](const QuadMPCControllerConfig &config) {
+            return std::unique_ptr<
+                Controller<SensorDataT, GoalT, Eigen::VectorXd>>(
+                new DDPQuadMPCController(
+                    config,
+                    std::chrono::duration<double>(controller_duration)));
+          },
+          [](const Eigen::VectorXd &control) { return control; }, threads);
+    } else if (controller == "qrotor_backstepping") {
+      using SensorDataT = std::pair<double, QrotorBacksteppingState>;
+      using GoalT = std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>>;
+      return replay<SensorDataT, GoalT, QrotorBacksteppingControl,
+                    QrotorBacksteppingControllerConfig>(
+          replay_traces::qrotorBacksteppingTrace(log_directory, max_skew),
+          config_paths,
+          [](const QrotorBacksteppingControllerConfig &config) {
+            return std::unique_ptr<Controller<SensorDataT, GoalT,
+                                              QrotorBacksteppingControl>>(
+                new QrotorBacksteppingController(config));
+          },
+          [](const QrotorBacksteppingControl &control) {
+            return Eigen::Vector4d(control.thrust_ddot, control.torque.x(),
+                                   control.torque.y(), control.torque.z());
+          },
+          threads);
+    }
+  } catch (const std::exception &e) {
+    LOG(ERROR) << e.what();
+    return 1;
+  }
+  printUsage(argv[0]);
+  return 1;
+}
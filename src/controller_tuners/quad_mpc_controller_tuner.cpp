@@ -1,3 +1,4 @@
+#include <aerial_autonomy/common/clock.h>
 #include <aerial_autonomy/common/conversions.h>
 #include <aerial_autonomy/common/mpc_trajectory_visualizer.h>
 #include <aerial_autonomy/common/proto_utils.h>
@@ -64,6 +65,10 @@ int main(int argc, char **argv) {
   google::InitGoogleLogging("quad_mpc_control_tuning");
   ros::init(argc, argv, "quad_mpc_control_tuning");
   ros::NodeHandle nh;
+  // The simulation steps the reference time along with the simulated quad
+  // instead of following the wall clock
+  auto clock = std::make_shared<SimulatedClock>(Clock::instance().now());
+  Clock::setInstance(clock);
   LogConfig log_config;
   log_config.set_directory(std::string(PROJECT_SOURCE_DIR) + "/logs/data");
   auto data_stream_config = log_config.add_data_stream_configs();
@@ -126,6 +131,7 @@ int main(int argc, char **argv) {
              ControllerStatus::Status::Critical) {
 
     controller_connector.run();
+    clock->advance(std::chrono::milliseconds(20));
     if (++count == 4) {
       visualizer.publishTrajectory(controller_connector);
       count = 0;
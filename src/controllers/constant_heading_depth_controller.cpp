@@ -4,7 +4,7 @@
 #include <glog/logging.h>
 
 bool ConstantHeadingDepthController::runImplementation(
-    PositionYaw sensor_data, Position goal, VelocityYawRate &control) {
+    PositionYaw sensor_data, const Position &goal, VelocityYawRate &control) {
   tf::Vector3 current_tracking_vector(sensor_data.x, sensor_data.y,
                                       sensor_data.z);
   tf::Vector3 desired_tracking_vector(goal.x, goal.y, goal.z);
@@ -36,7 +36,7 @@ bool ConstantHeadingDepthController::runImplementation(
                   config_.max_yaw_rate());
   control = VelocityYawRate(desired_vel_tf.getX(), desired_vel_tf.getY(),
                             desired_vel_tf.getZ(), yaw_rate);
-  DATA_LOG("constant_heading_depth_controller")
+  DATA_LOG(log_stream_)
       << tracking_error.getX() << tracking_error.getY() << tracking_error.getZ()
       << error_yaw << sensor_data.x << sensor_data.y << sensor_data.z
       << sensor_data.yaw << control.x << control.y << control.z
@@ -45,7 +45,7 @@ bool ConstantHeadingDepthController::runImplementation(
 }
 
 ControllerStatus ConstantHeadingDepthController::isConvergedImplementation(
-    PositionYaw sensor_data, Position goal) {
+    PositionYaw sensor_data, const Position &goal) {
   double error_yaw =
       math::angleWrap(std::atan2(goal.y, goal.x) - sensor_data.yaw);
   Position error = Position(sensor_data.x, sensor_data.y, sensor_data.z) - goal;
@@ -32,7 +32,8 @@ DDPAirmMPCController::DDPAirmMPCController(
     AirmMPCControllerConfig config,
     std::chrono::duration<double> controller_duration)
     : DDPCasadiMPCController(config.ddp_config(), controller_duration),
-      config_(config) {
+      config_(config),
+      log_stream_(Log::current().registerStream("ddp_airm_mpc_controller")) {
   // Instantiate system
   std::string folder_path =
       std::string(PROJECT_SOURCE_DIR) + "/" + config.weights_folder();
@@ -119,12 +120,12 @@ DDPAirmMPCController::ControlType DDPAirmMPCController::stationaryControl() {
 }
 
 ControllerStatus DDPAirmMPCController::isConvergedImplementation(
-    MPCInputs<StateType> sensor_data, GoalType goal) {
+    MPCInputs<StateType> sensor_data, const GoalType &goal) {
   if (!controller_config_status_) {
     LOG(WARNING) << "Controller config invalid!";
     return ControllerStatus(ControllerStatus::Critical);
   }
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   ControllerStatus controller_status = ControllerStatus::Active;
   if (xds_.at(0).rows() < state_size_) {
     double t = sensor_data.time_since_goal;
@@ -158,7 +159,7 @@ ControllerStatus DDPAirmMPCController::isConvergedImplementation(
 }
 
 void DDPAirmMPCController::setConfig(AirmMPCControllerConfig config) {
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   config_ = config;
   ddp_config_ = config.ddp_config();
 }
@@ -180,7 +181,7 @@ void DDPAirmMPCController::logData(MPCInputs<StateType> &sensor_data,
       sensor_data.initial_state.segment<3>(0) - xds_.at(0).segment<3>(0);
   Eigen::Vector2d error_ja =
       sensor_data.initial_state.segment<2>(15) - xds_.at(0).segment<2>(15);
-  DATA_LOG("ddp_airm_mpc_controller")
+  DATA_LOG(log_stream_)
       << error_position << error_ja << control << (ddp_->J)
       << loop_timer_.average_loop_period() << DataStream::endl;
 }
@@ -1,4 +1,5 @@
 #include "aerial_autonomy/controllers/ddp_casadi_mpc_controller.h"
+#include "aerial_autonomy/log/trace.h"
 
 DDPCasadiMPCController::DDPCasadiMPCController(
     DDPMPCControllerConfig ddp_config,
@@ -72,25 +73,34 @@ void DDPCasadiMPCController::rotateControls(unsigned int shift_length) {
 }
 
 bool DDPCasadiMPCController::runImplementation(MPCInputs<StateType> sensor_data,
-                                               GoalType goal,
+                                               const GoalType &goal,
                                                ControlType &control) {
   if (!controller_config_status_) {
     LOG(WARNING) << "Controller config invalid!";
     return false;
   }
+  TRACE_SPAN("ddp_mpc_run");
   bool result = true;
   loop_timer_.loop_start();
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::unique_lock<ProfiledMutex> lock(copy_mutex_, std::defer_lock);
+  {
+    // Blocked while the trajectory is copied out for visualization
+    TRACE_SPAN("ddp_mpc_lock");
+    lock.lock();
+  }
   unsigned int N = ddp_config_.n();
   double h = ddp_config_.h();
   double t0 = sensor_data.time_since_goal;
   // Get MPC Reference from high level reference trajectory
-  for (unsigned int i = 0; i <= N; ++i) {
-    double t = t0 + i * h;
-    std::pair<StateType, ControlType> state_control_pair = goal->atTime(t);
-    xds_.at(i) = state_control_pair.first;
-    if (i < N) {
-      uds_.at(i) = state_control_pair.second;
+  {
+    TRACE_SPAN("ddp_mpc_reference");
+    for (unsigned int i = 0; i <= N; ++i) {
+      double t = t0 + i * h;
+      std::pair<StateType, ControlType> state_control_pair = goal->atTime(t);
+      xds_.at(i) = state_control_pair.first;
+      if (i < N) {
+        uds_.at(i) = state_control_pair.second;
+      }
     }
   }
   // Start state
@@ -98,18 +108,21 @@ bool DDPCasadiMPCController::runImplementation(MPCInputs<StateType> sensor_data,
   // Parameters
   kt_[0] = sensor_data.parameters[0]; // copy kt
   rotateControls(control_timer_shift_);
-  // Update states based on controls
-  ddp_->Update();
-  double J = 1e6; // Assume start cost is some large value
-  // Run MPC Iterations
-  for (unsigned int i = 0; i < max_iters_; ++i) {
-    ddp_->Iterate();
-    // Check for convergence
-    if (std::abs(ddp_->J - J) < ddp_config_.min_cost_decrease()) {
-      VLOG(5) << "Converged";
-      break;
+  {
+    TRACE_SPAN("ddp_mpc_iterate");
+    // Update states based on controls
+    ddp_->Update();
+    double J = 1e6; // Assume start cost is some large value
+    // Run MPC Iterations
+    for (unsigned int i = 0; i < max_iters_; ++i) {
+      ddp_->Iterate();
+      // Check for convergence
+      if (std::abs(ddp_->J - J) < ddp_config_.min_cost_decrease()) {
+        VLOG(5) << "Converged";
+        break;
+      }
+      J = ddp_->J;
     }
-    J = ddp_->J;
   }
   if (ddp_->J > ddp_config_.max_cost()) {
     LOG(WARNING) << "Failed to get a reasonable trajectory using Ddp. J: "
@@ -128,20 +141,21 @@ bool DDPCasadiMPCController::runImplementation(MPCInputs<StateType> sensor_data,
   VLOG(5) << "xd: " << xds_.back().transpose();
   VLOG(5) << "u: " << control.transpose();
 
+  TRACE_SPAN("ddp_mpc_log");
   logData(sensor_data, control);
   return result;
 }
 
 void DDPCasadiMPCController::getTrajectory(std::vector<StateType> &xs,
                                            std::vector<ControlType> &us) const {
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   xs = xs_;
   us = us_;
 }
 
 void DDPCasadiMPCController::getDesiredTrajectory(
     std::vector<StateType> &xds, std::vector<ControlType> &uds) const {
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   xds = xds_;
   uds = uds_;
 }
@@ -19,7 +19,8 @@ DDPQuadMPCController::DDPQuadMPCController(
     QuadMPCControllerConfig config,
     std::chrono::duration<double> controller_duration)
     : DDPCasadiMPCController(config.ddp_config(), controller_duration),
-      config_(config) {
+      config_(config),
+      log_stream_(Log::current().registerStream("ddp_quad_mpc_controller")) {
   // Instantiate system
   Eigen::Vector3d kp_rpy, kd_rpy;
   loadQuadParameters(kp_rpy, kd_rpy, kt_, config);
@@ -105,12 +106,12 @@ DDPQuadMPCController::ControlType DDPQuadMPCController::stationaryControl() {
 }
 
 ControllerStatus DDPQuadMPCController::isConvergedImplementation(
-    MPCInputs<StateType> sensor_data, GoalType goal) {
+    MPCInputs<StateType> sensor_data, const GoalType &goal) {
   if (!controller_config_status_) {
     LOG(WARNING) << "Controller config invalid!";
     return ControllerStatus(ControllerStatus::Critical);
   }
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   ControllerStatus controller_status = ControllerStatus::Active;
   double t0 = sensor_data.time_since_goal;
   Eigen::VectorXd end_goal = goal->goal(t0);
@@ -135,7 +136,7 @@ ControllerStatus DDPQuadMPCController::isConvergedImplementation(
 }
 
 void DDPQuadMPCController::setConfig(QuadMPCControllerConfig config) {
-  boost::mutex::scoped_lock lock(copy_mutex_);
+  std::lock_guard<ProfiledMutex> lock(copy_mutex_);
   config_ = config;
   ddp_config_ = config.ddp_config();
 }
@@ -155,7 +156,7 @@ void DDPQuadMPCController::logData(MPCInputs<StateType> &sensor_data,
       sensor_data.initial_state.segment<3>(0) - xds_.at(0).segment<3>(0);
   Eigen::Vector3d error_velocity =
       sensor_data.initial_state.segment<3>(6) - xds_.at(0).segment<3>(6);
-  DATA_LOG("ddp_quad_mpc_controller")
+  DATA_LOG(log_stream_)
       << error_position << error_velocity << control << (ddp_->J)
       << Eigen::VectorXd(xds_.at(0).segment<9>(0))
       << loop_timer_.average_loop_period() << DataStream::endl;
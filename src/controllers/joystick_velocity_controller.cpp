@@ -2,8 +2,8 @@
 #include "aerial_autonomy/common/math.h"
 
 bool JoystickVelocityController::runImplementation(
-    std::tuple<Joystick, VelocityYawRate, double> sensor_data, EmptyGoal goal,
-    RollPitchYawRateThrust &control) {
+    std::tuple<Joystick, VelocityYawRate, double> sensor_data,
+    const EmptyGoal &goal, RollPitchYawRateThrust &control) {
 
   VelocityYawRate vel_goal =
       convertJoystickToVelocityYawRate(std::get<0>(sensor_data));
@@ -16,7 +16,8 @@ bool JoystickVelocityController::runImplementation(
 }
 
 ControllerStatus JoystickVelocityController::isConvergedImplementation(
-    std::tuple<Joystick, VelocityYawRate, double> sensor_data, EmptyGoal) {
+    std::tuple<Joystick, VelocityYawRate, double> sensor_data,
+    const EmptyGoal &) {
   auto vel_sensor_data =
       std::make_tuple(std::get<1>(sensor_data), std::get<2>(sensor_data));
   return rpyt_velocity_controller_.isConverged(vel_sensor_data);
@@ -2,7 +2,8 @@
 #include "aerial_autonomy/common/math.h"
 #include "aerial_autonomy/log/log.h"
 
-ManualRPYTController::ManualRPYTController() {
+ManualRPYTController::ManualRPYTController()
+    : log_stream_(Log::current().registerStream("manual_rpyt_controller")) {
   DATA_HEADER("manual_rpyt_controller") << "Roll_cmd"
                                         << "Pitch_cmd"
                                         << "Yaw_cmd"
@@ -10,7 +11,7 @@ ManualRPYTController::ManualRPYTController() {
 }
 
 bool ManualRPYTController::runImplementation(Joystick sensor_data,
-                                             EmptyGoal goal,
+                                             const EmptyGoal &goal,
                                              RollPitchYawRateThrust &control) {
   /// \todo(matt): need to pass RC mapping as parameter
   control.r =
@@ -21,8 +22,8 @@ bool ManualRPYTController::runImplementation(Joystick sensor_data,
 
   control.y = -1 * math::map(sensor_data.channel4, -10000, 10000, -M_PI, M_PI);
 
-  DATA_LOG("manual_rpyt_controller") << control.r << control.p << control.y
-                                     << control.t << DataStream::endl;
+  DATA_LOG(log_stream_) << control.r << control.p << control.y << control.t
+                        << DataStream::endl;
 
   return true;
 }
@@ -13,7 +13,7 @@ QrotorBacksteppingController::getGoalFromReference(
 
 bool QrotorBacksteppingController::runImplementation(
     std::pair<double, QrotorBacksteppingState> sensor_data,
-    std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> goal,
+    const std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> &goal,
     QrotorBacksteppingControl &control) {
   QrotorBacksteppingState current_state = std::get<1>(sensor_data);
   double current_time = std::get<0>(sensor_data);
@@ -96,7 +96,7 @@ bool QrotorBacksteppingController::runImplementation(
     control.torque = tf::Vector3(0, 0, 0);
   }
   control.thrust_ddot = e_.dot(snap_cmd);
-  DATA_LOG("qrotor_backstepping_controller")
+  DATA_LOG(log_stream_)
       << p(0) << p(1) << p(2) << p_d(0) << p_d(1) << p_d(2) << v(0) << v(1)
       << v(2) << v_d(0) << v_d(1) << v_d(2) << DataStream::endl;
   return true;
@@ -104,7 +104,7 @@ bool QrotorBacksteppingController::runImplementation(
 
 ControllerStatus QrotorBacksteppingController::isConvergedImplementation(
     std::pair<double, QrotorBacksteppingState> sensor_data,
-    std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> goal) {
+    const std::shared_ptr<ReferenceTrajectory<ParticleState, Snap>> &goal) {
   ControllerStatus controller_status = ControllerStatus::Active;
   QrotorBacksteppingState current_state = std::get<1>(sensor_data);
   ParticleState end_goal = goal->goal(sensor_data.first);
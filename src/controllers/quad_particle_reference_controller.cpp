@@ -8,7 +8,8 @@ QuadParticleReferenceController::QuadParticleReferenceController(
     : config_(config) {}
 
 bool QuadParticleReferenceController::runImplementation(
-    std::pair<PositionYaw, tf::Transform> sensor_data, PositionYaw goal,
+    std::pair<PositionYaw, tf::Transform> sensor_data,
+    const PositionYaw &goal,
     ReferenceTrajectoryPtr<Eigen::VectorXd, Eigen::VectorXd> &control) {
   tf::Transform goal_tf;
   conversions::positionYawToTf(goal, goal_tf);
@@ -3,14 +3,15 @@
 #include <glog/logging.h>
 
 bool RelativePoseController::runImplementation(
-    std::tuple<tf::Transform, tf::Transform> sensor_data, tf::Transform goal,
-    tf::Transform &control) {
+    std::tuple<tf::Transform, tf::Transform> sensor_data,
+    const tf::Transform &goal, tf::Transform &control) {
   control = std::get<1>(sensor_data) * goal;
   return true;
 }
 
 ControllerStatus RelativePoseController::isConvergedImplementation(
-    std::tuple<tf::Transform, tf::Transform> sensor_data, tf::Transform goal) {
+    std::tuple<tf::Transform, tf::Transform> sensor_data,
+    const tf::Transform &goal) {
   tf::Transform current_pose = std::get<0>(sensor_data);
   tf::Transform tracked_pose = std::get<1>(sensor_data);
 
@@ -30,7 +31,7 @@ ControllerStatus RelativePoseController::isConvergedImplementation(
   const tf::Vector3 &current_trans = current_pose.getOrigin();
   const tf::Quaternion &tracked_rot = tracked_pose.getRotation();
   const tf::Vector3 &tracked_trans = tracked_pose.getOrigin();
-  DATA_LOG("relative_pose_controller")
+  DATA_LOG(log_stream_)
       << error_position.x() << error_position.y() << error_position.z()
       << rot_diff << current_trans.x() << current_trans.y() << current_trans.z()
       << current_rot.w() << current_rot.x() << current_rot.y()
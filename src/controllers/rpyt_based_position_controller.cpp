@@ -1,7 +1,7 @@
 #include "aerial_autonomy/controllers/rpyt_based_position_controller.h"
 bool RPYTBasedPositionController::runImplementation(
-    std::tuple<VelocityYawRate, PositionYaw> sensor_data, PositionYaw goal,
-    RollPitchYawRateThrust &control) {
+    std::tuple<VelocityYawRate, PositionYaw> sensor_data,
+    const PositionYaw &goal, RollPitchYawRateThrust &control) {
   auto velocity = std::get<0>(sensor_data);
   auto position = std::get<1>(sensor_data);
 
@@ -16,7 +16,8 @@ bool RPYTBasedPositionController::runImplementation(
   return control_success;
 }
 ControllerStatus RPYTBasedPositionController::isConvergedImplementation(
-    std::tuple<VelocityYawRate, PositionYaw> sensor_data, PositionYaw goal) {
+    std::tuple<VelocityYawRate, PositionYaw> sensor_data,
+    const PositionYaw &goal) {
   auto velocity = std::get<0>(sensor_data);
   auto position = std::get<1>(sensor_data);
   ControllerStatus controller_status(ControllerStatus::Completed);
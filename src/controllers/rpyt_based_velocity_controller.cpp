@@ -5,8 +5,8 @@
 #include <glog/logging.h>
 
 bool RPYTBasedVelocityController::runImplementation(
-    std::tuple<VelocityYawRate, double> sensor_data, VelocityYawRate goal,
-    RollPitchYawRateThrust &control) {
+    std::tuple<VelocityYawRate, double> sensor_data,
+    const VelocityYawRate &goal, RollPitchYawRateThrust &control) {
   double yaw = std::get<1>(sensor_data);
   VelocityYawRate velocity_yawrate = std::get<0>(sensor_data);
   VelocityYawRate velocity_yawrate_diff = goal - velocity_yawrate;
@@ -64,7 +64,7 @@ bool RPYTBasedVelocityController::runImplementation(
   control.p = math::clamp(control.p, -config.max_rp(), config.max_rp());
 
   control.y = goal.yaw_rate;
-  DATA_LOG("rpyt_based_velocity_controller")
+  DATA_LOG(log_stream_)
       << velocity_yawrate_diff.x << velocity_yawrate_diff.y
       << velocity_yawrate_diff.z << velocity_yawrate_diff.yaw_rate
       << velocity_yawrate.x << velocity_yawrate.y << velocity_yawrate.z
@@ -76,7 +76,8 @@ bool RPYTBasedVelocityController::runImplementation(
 }
 
 ControllerStatus RPYTBasedVelocityController::isConvergedImplementation(
-    std::tuple<VelocityYawRate, double> sensor_data, VelocityYawRate goal) {
+    std::tuple<VelocityYawRate, double> sensor_data,
+    const VelocityYawRate &goal) {
   ControllerStatus status = ControllerStatus::Active;
   VelocityYawRate velocity_yawrate = std::get<0>(sensor_data);
   VelocityYawRate velocity_yawrate_diff = goal - velocity_yawrate;
@@ -31,7 +31,8 @@ void VelocityBasedPositionController::setGoal(PositionYaw goal, bool reset) {
 }
 
 bool VelocityBasedPositionController::runImplementation(
-    PositionYaw sensor_data, PositionYaw goal, VelocityYawRate &control) {
+    PositionYaw sensor_data, const PositionYaw &goal,
+    VelocityYawRate &control) {
   PositionYaw position_diff = goal - sensor_data;
   PositionYaw p_position_diff(position_diff.x * config_.position_gain(),
                               position_diff.y * config_.position_gain(),
@@ -58,7 +59,7 @@ bool VelocityBasedPositionController::runImplementation(
       backCalculate(cumulative_error_.yaw, p_position_diff.yaw,
                     config_.max_yaw_rate(), config_.yaw_saturation_value());
 
-  DATA_LOG("velocity_based_position_controller")
+  DATA_LOG(log_stream_)
       << position_diff.x << position_diff.y << position_diff.z
       << position_diff.yaw << goal.x << goal.y << goal.z << goal.yaw
       << cumulative_error_.x << cumulative_error_.y << cumulative_error_.z
@@ -68,7 +69,7 @@ bool VelocityBasedPositionController::runImplementation(
 }
 
 ControllerStatus VelocityBasedPositionController::isConvergedImplementation(
-    PositionYaw sensor_data, PositionYaw goal) {
+    PositionYaw sensor_data, const PositionYaw &goal) {
   PositionYaw position_diff = goal - sensor_data;
   ControllerStatus status(ControllerStatus::Active);
   status << "Error Position, Yaw: " << position_diff.x << position_diff.y
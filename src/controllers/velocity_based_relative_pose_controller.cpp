@@ -5,8 +5,8 @@
 #include <glog/logging.h>
 
 bool VelocityBasedRelativePoseController::runImplementation(
-    std::tuple<tf::Transform, tf::Transform> sensor_data, PositionYaw goal,
-    VelocityYawRate &control) {
+    std::tuple<tf::Transform, tf::Transform> sensor_data,
+    const PositionYaw &goal, VelocityYawRate &control) {
   tf::Transform goal_tf;
   conversions::positionYawToTf(goal, goal_tf);
   tf::Transform current_pose = std::get<0>(sensor_data);
@@ -24,7 +24,7 @@ bool VelocityBasedRelativePoseController::runImplementation(
   position_controller_.setGoal(desired_position_yaw, false);
 
   auto status = position_controller_.run(current_position_yaw, control);
-  DATA_LOG("velocity_based_relative_pose_controller")
+  DATA_LOG(log_stream_)
       << desired_pose.getOrigin().getX() << desired_pose.getOrigin().getY()
       << desired_pose.getOrigin().getZ() << desired_yaw
       << current_pose.getOrigin().getX() << current_pose.getOrigin().getY()
@@ -34,7 +34,8 @@ bool VelocityBasedRelativePoseController::runImplementation(
 }
 
 ControllerStatus VelocityBasedRelativePoseController::isConvergedImplementation(
-    std::tuple<tf::Transform, tf::Transform> sensor_data, PositionYaw goal) {
+    std::tuple<tf::Transform, tf::Transform> sensor_data,
+    const PositionYaw &goal) {
   tf::Transform goal_tf;
   conversions::positionYawToTf(goal, goal_tf);
   tf::Transform current_pose = std::get<0>(sensor_data);
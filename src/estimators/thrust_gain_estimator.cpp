@@ -16,7 +16,8 @@ ThrustGainEstimator::ThrustGainEstimator(
       gravity_magnitude_(9.81), thrust_command_tolerance_(1e-2),
       max_thrust_gain_(max_thrust_gain), min_thrust_gain_(min_thrust_gain),
       max_roll_pitch_bias_(max_roll_pitch_bias),
-      init_roll_bias_(init_roll_bias), init_pitch_bias_(init_pitch_bias) {
+      init_roll_bias_(init_roll_bias), init_pitch_bias_(init_pitch_bias),
+      log_stream_(Log::current().registerStream("thrust_gain_estimator")) {
   CHECK_GE(delay_buffer_size_, 1) << "Buffer size should be atleast 1";
   CHECK_GE(mixing_gain_, 0) << "Mixing gain should be between 0 and 1";
   CHECK_LE(mixing_gain_, 1) << "Mixing gain should be between 0 and 1";
@@ -90,7 +91,7 @@ void ThrustGainEstimator::addSensorData(double roll, double pitch,
         roll_pitch_bias_[0], -max_roll_pitch_bias_, max_roll_pitch_bias_);
     roll_pitch_bias_[1] = math::clamp(
         roll_pitch_bias_[1], -max_roll_pitch_bias_, max_roll_pitch_bias_);
-    DATA_LOG("thrust_gain_estimator")
+    DATA_LOG(log_stream_)
         << roll << pitch << body_acc[0] << body_acc[1] << body_acc[2]
         << thrust_command_queue_.front() << thrust_gain_ << roll_pitch_bias_
         << DataStream::endl;
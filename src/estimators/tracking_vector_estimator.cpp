@@ -1,3 +1,4 @@
+#include <aerial_autonomy/common/clock.h>
 #include <aerial_autonomy/estimators/tracking_vector_estimator.h>
 #include <aerial_autonomy/log/log.h>
 #include <glog/logging.h>
@@ -6,7 +7,8 @@ TrackingVectorEstimator::TrackingVectorEstimator(
     TrackingVectorEstimatorConfig config,
     std::chrono::duration<double> propagation_step)
     : config_(config), filter_(3, 3, 3, CV_64F), zero_tolerance_(1e-6),
-      initial_state_initialized_(false) {
+      initial_state_initialized_(false),
+      log_stream_(Log::current().registerStream("tracking_vector_estimator")) {
   // Assuming x = [Marker direction] and u = [velocity]
   // Transition matrix
   filter_.transitionMatrix = cv::Mat_<double>::eye(3, 3);
@@ -65,9 +67,9 @@ void TrackingVectorEstimator::setMeasurementCovariance(
     cv::Mat &covariance_mat,
     std::chrono::time_point<std::chrono::high_resolution_clock>
         marker_time_stamp) {
-  double dt = std::chrono::duration<double>(
-                  std::chrono::high_resolution_clock::now() - marker_time_stamp)
-                  .count();
+  double dt =
+      std::chrono::duration<double>(Clock::instance().now() - marker_time_stamp)
+          .count();
   if (dt < 0) {
     LOG(WARNING) << "dt negative: " << dt;
     dt = 0;
@@ -96,7 +98,7 @@ void TrackingVectorEstimator::correct(
   // Log data
   tf::Vector3 marker_noise = getMarkerNoise();
   auto state = filter_.statePost;
-  auto &data_stream = Log::instance()["tracking_vector_estimator"];
+  auto &data_stream = Log::current()[log_stream_];
   data_stream << DataStream::startl;
   for (int i = 0; i < 3; ++i) {
     data_stream << measurement.at<double>(i);
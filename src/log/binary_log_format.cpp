@@ -0,0 +1,266 @@
+#include "aerial_autonomy/log/binary_log_format.h"
+#include "aerial_autonomy/log/gorilla_codec.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace binary_log {
+
+namespace {
+/**
+* @brief Magic bytes identifying a binary stream file
+*/
+const char kMagic[4] = {'A', 'A', 'B', 'L'};
+
+/**
+* @brief Append a fixed size value to a byte string
+*/
+template <class T> void append(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+* @brief Append a length prefixed string to a byte string
+*/
+void appendString(std::string &out, const std::string &str) {
+  append(out, uint32_t(str.size()));
+  out.append(str);
+}
+
+/**
+* @brief Read a fixed size value from a stream
+*/
+template <class T> bool read(std::istream &in, T &value) {
+  in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return size_t(in.gcount()) == sizeof(T);
+}
+
+/**
+* @brief Read a length prefixed string from a stream
+*/
+bool readString(std::istream &in, std::string &str) {
+  uint32_t size;
+  if (!read(in, size)) {
+    return false;
+  }
+  str.resize(size);
+  in.read(&str[0], size);
+  return size_t(in.gcount()) == size;
+}
+}
+
+size_t columnWidth(ColumnType type) {
+  switch (type) {
+  case ColumnType::Int64:
+    return sizeof(int64_t);
+  case ColumnType::Double:
+    return sizeof(double);
+  }
+  throw std::logic_error("Unknown column type");
+}
+
+size_t Schema::recordSize() const {
+  size_t size = 0;
+  for (auto type : types) {
+    size += columnWidth(type);
+  }
+  return size;
+}
+
+std::string encodeSchema(const Schema &schema) {
+  std::string out(kMagic, sizeof(kMagic));
+  append(out, kFormatVersion);
+  append(out, uint8_t(schema.encoding));
+  appendString(out, schema.delimiter);
+  append(out, uint32_t(schema.names.size()));
+  for (const auto &name : schema.names) {
+    appendString(out, name);
+  }
+  append(out, uint32_t(schema.types.size()));
+  for (auto type : schema.types) {
+    append(out, uint8_t(type));
+  }
+  return out;
+}
+
+bool isBinaryLog(const boost::filesystem::path &path) {
+  std::ifstream fs(path.string(), std::ifstream::in | std::ifstream::binary);
+  char magic[sizeof(kMagic)];
+  return fs.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool readSchema(std::istream &in, Schema &schema) {
+  char magic[sizeof(kMagic)];
+  in.read(magic, sizeof(magic));
+  if (in.gcount() == 0) {
+    return false;
+  }
+  uint32_t version;
+  if (size_t(in.gcount()) != sizeof(magic) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !read(in, version)) {
+    throw std::runtime_error("Not a binary stream");
+  }
+  if (version == 0 || version > kFormatVersion) {
+    throw std::runtime_error("Unsupported binary stream version " +
+                             std::to_string(version));
+  }
+  bool status = true;
+  uint8_t encoding = 0;
+  if (version >= 2) {
+    status = read(in, encoding) && encoding <= uint8_t(Encoding::Compressed);
+  }
+  schema.encoding = Encoding(encoding);
+  uint32_t names_size;
+  status = status && readString(in, schema.delimiter) && read(in, names_size);
+  schema.names.resize(status ? names_size : 0);
+  for (auto &name : schema.names) {
+    status = status && readString(in, name);
+  }
+  uint32_t types_size;
+  status = status && read(in, types_size);
+  schema.types.resize(status ? types_size : 0);
+  for (auto &type : schema.types) {
+    uint8_t type_id = 0;
+    status = status && read(in, type_id) &&
+             type_id <= uint8_t(ColumnType::Double);
+    type = ColumnType(type_id);
+  }
+  if (!status) {
+    throw std::runtime_error("Corrupt binary stream schema");
+  }
+  return true;
+}
+
+bool decodeSchema(const std::string &bytes, Schema &schema) {
+  std::istringstream in(bytes);
+  return readSchema(in, schema);
+}
+
+BinaryLogReader::BinaryLogReader(boost::filesystem::path path)
+    : fs_(path.string(), std::ifstream::in | std::ifstream::binary),
+      has_schema_(false) {
+  if (!fs_.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  try {
+    has_schema_ = readSchema(fs_, schema_);
+  } catch (const std::runtime_error &e) {
+    throw std::runtime_error(std::string(e.what()) + ": " + path.string());
+  }
+  if (!has_schema_) {
+    // Empty stream
+    return;
+  }
+  size_t offset = 0;
+  for (auto type : schema_.types) {
+    offsets_.push_back(offset);
+    offset += columnWidth(type);
+  }
+  record_.resize(offset);
+  if (schema_.encoding == Encoding::Compressed) {
+    decoder_.reset(new BlockDecoder(schema_.types));
+  }
+}
+
+BinaryLogReader::~BinaryLogReader() {}
+
+bool BinaryLogReader::hasSchema() const { return has_schema_; }
+
+const Schema &BinaryLogReader::schema() const { return schema_; }
+
+bool BinaryLogReader::next() {
+  if (!has_schema_) {
+    return false;
+  }
+  if (!decoder_) {
+    return read(record_.data(), record_.size());
+  }
+  while (!decoder_->next(record_.data())) {
+    if (!readBlock()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t BinaryLogReader::getInt64(size_t column) const {
+  if (schema_.types.at(column) == ColumnType::Double) {
+    return int64_t(getDouble(column));
+  }
+  int64_t value;
+  std::memcpy(&value, &record_[offsets_[column]], sizeof(value));
+  return value;
+}
+
+double BinaryLogReader::getDouble(size_t column) const {
+  if (schema_.types.at(column) == ColumnType::Int64) {
+    return double(getInt64(column));
+  }
+  double value;
+  std::memcpy(&value, &record_[offsets_[column]], sizeof(value));
+  return value;
+}
+
+std::string BinaryLogReader::formatHeader() const {
+  std::stringstream ss;
+  for (size_t i = 0; i < schema_.names.size(); ++i) {
+    if (i > 0) {
+      ss << schema_.delimiter;
+    }
+    ss << schema_.names[i];
+  }
+  return ss.str();
+}
+
+void BinaryLogReader::seek(uint64_t offset) {
+  fs_.clear();
+  fs_.seekg(offset);
+  if (decoder_) {
+    // Drop the rest of the current block
+    decoder_->reset(nullptr, 0, 0);
+  }
+}
+
+std::string BinaryLogReader::formatRecord() const {
+  std::stringstream ss;
+  for (size_t i = 0; i < schema_.types.size(); ++i) {
+    if (i > 0) {
+      ss << schema_.delimiter;
+    }
+    ss << formatColumn(i);
+  }
+  return ss.str();
+}
+
+std::string BinaryLogReader::formatColumn(size_t column) const {
+  std::stringstream ss;
+  if (schema_.types.at(column) == ColumnType::Int64) {
+    ss << getInt64(column);
+  } else {
+    ss << getDouble(column);
+  }
+  return ss.str();
+}
+
+bool BinaryLogReader::read(char *data, size_t size) {
+  fs_.read(data, size);
+  return size_t(fs_.gcount()) == size;
+}
+
+bool BinaryLogReader::readBlock() {
+  uint32_t record_count;
+  uint32_t size;
+  if (!read(reinterpret_cast<char *>(&record_count), sizeof(record_count)) ||
+      !read(reinterpret_cast<char *>(&size), sizeof(size))) {
+    return false;
+  }
+  block_.resize(size);
+  if (!read(&block_[0], size)) {
+    return false;
+  }
+  decoder_->reset(block_.data(), block_.size(), record_count);
+  return true;
+}
+}
@@ -1,47 +1,262 @@
 #include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/common/clock.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
 
-DataStream::DataStream(boost::filesystem::path path, DataStreamConfig config)
-    : config_(config), path_(path), streaming_(false) {
-  fs_.open(path.string(), std::fstream::out);
-  if (!fs_.is_open()) {
-    throw std::runtime_error("Could not open file: " + path.string());
+namespace {
+/**
+* @brief Tag stored in the first byte of data point records in the ring buffer
+*/
+const char kDataRecord = 'D';
+/**
+* @brief Tag stored in the first byte of header records in the ring buffer
+*/
+const char kHeaderRecord = 'H';
+/**
+* @brief Maximum number of data points in a compressed block. Bounds the size
+* of a block so that it fits in a log segment
+*/
+const uint32_t kMaxBlockRecords = 1024;
+}
+
+DataStream::DataStream(boost::filesystem::path path, DataStreamConfig config,
+                       uint64_t segment_size,
+                       std::shared_ptr<DiskBudget> disk_budget)
+    : config_(config), path_(path), streaming_(false),
+      file_data_point_(false), data_point_time_(0),
+      ring_(new RecordRingBuffer(config.buffer_size())),
+      binary_(config.format() != DataStreamConfig::TEXT),
+      streaming_header_(false), binary_data_point_valid_(true),
+      schema_written_(false), file_offset_(0), block_time_(0),
+      dropped_data_points_(0), overflow_data_points_(0), writer_epoch_(0) {
+  if (segment_size > 0) {
+    segment_writer_.reset(
+        new SegmentedFileWriter(path, segment_size, disk_budget));
+  } else {
+    fs_.open(path.string(), binary_ ? std::fstream::out | std::fstream::binary
+                                    : std::fstream::out);
+    if (!fs_.is_open()) {
+      throw std::runtime_error("Could not open file: " + path.string());
+    }
+    openIndex();
+  }
+  if (config_.log_data() && !config_.telemetry_name().empty()) {
+    telemetry_tap_.reset(new TelemetryTap(
+        config_.telemetry_name(), config_.telemetry_slots(),
+        config_.telemetry_slot_size(), binary_, config_.delimiter()));
+  }
+  if (config_.log_data() && config_.recorder_duration() > 0) {
+    recorder_.reset(new FlightRecorder(config_.recorder_buffer_size(),
+                                       config_.recorder_duration()));
+  }
+  schema_.delimiter = config_.delimiter();
+  if (config_.format() == DataStreamConfig::COMPRESSED) {
+    schema_.encoding = binary_log::Encoding::Compressed;
   }
 }
 
-DataStream::DataStream(DataStream &&o) {
+DataStream::DataStream(DataStream &&o)
+    : segment_writer_(std::move(o.segment_writer_)), ring_(std::move(o.ring_)),
+      block_encoder_(std::move(o.block_encoder_)), file_offset_(0),
+      block_time_(o.block_time_),
+      telemetry_tap_(std::move(o.telemetry_tap_)),
+      recorder_(std::move(o.recorder_)), dropped_data_points_(0),
+      overflow_data_points_(0), writer_epoch_(0) {
   config_ = o.config_;
   last_write_time_ = o.last_write_time_;
   path_ = o.path_;
+  binary_ = o.binary_;
+  header_names_ = o.header_names_;
+  schema_ = o.schema_;
+  streaming_ = false;
+  file_data_point_ = false;
+  data_point_time_ = 0;
+  streaming_header_ = false;
+  binary_data_point_valid_ = true;
+  if (segment_writer_) {
+    schema_written_ = o.schema_written_;
+    return;
+  }
   o.fs_.close();
+  o.index_writer_.reset();
 
-  fs_.open(path_.string(), std::fstream::out);
+  fs_.open(path_.string(), binary_ ? std::fstream::out | std::fstream::binary
+                                   : std::fstream::out);
   if (!fs_.is_open()) {
     throw std::runtime_error("Could not open file: " + path_.string());
   }
-  streaming_ = false;
+  // The file is truncated on reopening
+  schema_written_ = false;
+  block_encoder_.reset();
+  openIndex();
+}
+
+void DataStream::openIndex() {
+  if (config_.log_data() && config_.index_interval() > 0) {
+    index_writer_.reset(new TimeIndexWriter(
+        TimeIndexWriter::indexPath(path_), config_.index_interval()));
+  }
 }
 
 void DataStream::write() {
-  boost::mutex::scoped_lock lock(buffer_mutex_);
+  bool written = false;
+  bool compressed = schema_.encoding == binary_log::Encoding::Compressed;
+  while (ring_->pop(write_buffer_)) {
+    bool header = write_buffer_[0] == kHeaderRecord;
+    if (telemetry_tap_) {
+      // Records are mirrored before compression
+      if (header) {
+        telemetry_tap_->publishHeader(write_buffer_.data() + 1,
+                                      write_buffer_.size() - 1);
+      } else {
+        telemetry_tap_->publish(write_buffer_.data() + 1,
+                                write_buffer_.size() - 1);
+      }
+    }
+    if (compressed && !header) {
+      if (block_encoder_->recordCount() == 0) {
+        block_time_ = recordTime(write_buffer_);
+      }
+      block_encoder_->add(write_buffer_.data() + 1);
+      if (block_encoder_->recordCount() >= kMaxBlockRecords) {
+        written |= writeBlock();
+      }
+      continue;
+    }
+    if (compressed) {
+      // The schema is popped before its data points and its column types do
+      // not change once it is pushed
+      written |= writeBlock();
+      block_encoder_.reset(new binary_log::BlockEncoder(schema_.types));
+    }
+    if (!header) {
+      indexRecord(recordTime(write_buffer_), 1);
+    }
+    written |= writeRecord(header, write_buffer_.data() + 1,
+                           write_buffer_.size() - 1);
+  }
+  written |= writeBlock();
+  if (written) {
+    fs_.flush();
+    if (index_writer_) {
+      index_writer_->flush();
+    }
+  }
+}
+
+void DataStream::close() {
+  // Segment files are truncated to their contents when the writer is
+  // destroyed
+  segment_writer_.reset();
+  index_writer_.reset();
+  fs_.close();
+  // Releases the tap name for the stream replacing this one
+  telemetry_tap_.reset();
+}
+
+bool DataStream::writeRecord(bool header, const char *data, size_t size) {
+  if (!segment_writer_) {
+    fs_.write(data, size);
+    file_offset_ += size;
+    return true;
+  }
+  // The segment writer logs records it has to drop
+  if (header) {
+    segment_writer_->writeHeader(data, size);
+  } else {
+    segment_writer_->write(data, size);
+  }
+  return false;
+}
+
+bool DataStream::writeBlock() {
+  if (!block_encoder_ || block_encoder_->recordCount() == 0) {
+    return false;
+  }
+  indexRecord(block_time_, block_encoder_->recordCount());
+  std::string block = block_encoder_->finish();
+  return writeRecord(false, block.data(), block.size());
+}
+
+void DataStream::indexRecord(int64_t time, uint32_t data_points) {
+  if (index_writer_) {
+    index_writer_->add(time, file_offset_, data_points);
+  }
+}
 
-  fs_ << buffer_.str();
-  fs_.flush();
-  resetStringstream(buffer_);
+int64_t DataStream::recordTime(const std::string &record) const {
+  // The time is the first column of every data point (see startl)
+  if (!binary_) {
+    return std::strtoll(record.c_str() + 1, nullptr, 10);
+  }
+  int64_t time = 0;
+  if (record.size() >= 1 + sizeof(time)) {
+    std::memcpy(&time, record.data() + 1, sizeof(time));
+  }
+  return time;
 }
 
 const DataStreamConfig &DataStream::configuration() { return config_; }
 
 boost::filesystem::path DataStream::path() { return path_; }
 
+uint64_t DataStream::droppedDataPoints() const { return dropped_data_points_; }
+
+uint64_t DataStream::overflowDataPoints() const {
+  return overflow_data_points_;
+}
+
+uint64_t DataStream::writerEpoch() const { return writer_epoch_; }
+
+size_t DataStream::dumpRecorder(boost::filesystem::path path) {
+  if (!recorder_) {
+    return 0;
+  }
+  std::string header, data;
+  size_t data_points = recorder_->snapshot(header, data);
+  if (data_points == 0) {
+    return 0;
+  }
+  std::ofstream file(path.string(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  file.write(header.data(), header.size());
+  file.write(data.data(), data.size());
+  return data_points;
+}
+
 DataStream &DataStream::operator<<(DataStream &(*func)(DataStream &)) {
   return func(*this);
 }
 
-void DataStream::resetStringstream(std::stringstream &ss) {
-  ss.str(std::string());
-  ss.clear();
+void DataStream::appendDouble(double value) {
+  char str[32];
+  int size = std::snprintf(str, sizeof(str), "%g", value);
+  data_point_.append(str, size);
+}
+
+void DataStream::appendInteger(long long value) {
+  char str[32];
+  int size = std::snprintf(str, sizeof(str), "%lld", value);
+  data_point_.append(str, size);
+}
+
+void DataStream::appendUnsigned(unsigned long long value) {
+  char str[32];
+  int size = std::snprintf(str, sizeof(str), "%llu", value);
+  data_point_.append(str, size);
+}
+
+bool DataStream::pushRecord(const std::string &record) {
+  if (!ring_->push(record.data(), record.size())) {
+    ++overflow_data_points_;
+    return false;
+  }
+  return true;
 }
 
 DataStream &DataStream::startl(DataStream &ds) {
@@ -50,12 +265,21 @@ DataStream &DataStream::startl(DataStream &ds) {
   if (ds.streaming_) {
     throw std::logic_error("startl called on streaming DataStream");
   }
+  ++ds.writer_epoch_;
   if (ds.config_.log_data()) {
-    auto now = std::chrono::high_resolution_clock::now();
+    auto now = Clock::instance().now();
     std::chrono::duration<double> time_diff = now - ds.last_write_time_;
-    ds.streaming_ = time_diff.count() > 1. / ds.config_.log_rate();
+    ds.file_data_point_ = time_diff.count() > 1. / ds.config_.log_rate();
+    // The flight recorder keeps every data point
+    ds.streaming_ = ds.file_data_point_ || ds.recorder_;
     if (ds.streaming_) {
-      ds.data_point_ << now.time_since_epoch().count();
+      ds.data_point_time_ = now.time_since_epoch().count();
+      ds.data_point_.push_back(kDataRecord);
+      if (ds.binary_) {
+        ds.appendBinary(binary_log::ColumnType::Int64, ds.data_point_time_);
+      } else {
+        ds.appendInteger(ds.data_point_time_);
+      }
     }
   }
   return ds;
@@ -65,24 +289,99 @@ DataStream &DataStream::starth(DataStream &ds) {
   if (ds.streaming_) {
     throw std::logic_error("starth called on streaming DataStream");
   }
+  ++ds.writer_epoch_;
   if (ds.config_.log_data()) {
     ds.streaming_ = true;
-    ds.data_point_ << "#Time";
+    ds.file_data_point_ = true;
+    if (ds.binary_) {
+      ds.streaming_header_ = true;
+      ds.header_names_.clear();
+      ds.header_names_.push_back("#Time");
+    } else {
+      ds.data_point_.push_back(kHeaderRecord);
+      ds.data_point_.append("#Time");
+    }
   }
   return ds;
 }
 
 DataStream &DataStream::endl(DataStream &ds) {
-  // \todo Matt Make this stuff a public "flush" function for DataStream that
-  // gets called by DataStream::endl
   if (ds.streaming_) {
-    {
-      boost::mutex::scoped_lock(buffer_mutex_);
-      ds.buffer_ << ds.data_point_.str() << std::endl;
+    if (!ds.binary_) {
+      ds.data_point_.push_back('\n');
+      if (ds.file_data_point_) {
+        ds.pushRecord(ds.data_point_);
+      }
+      ds.recordDataPoint();
+    } else if (ds.streaming_header_) {
+      // Header names are written with the schema on the first data point
+      if (!ds.schema_written_) {
+        ds.schema_.names = ds.header_names_;
+        ds.updateRecorderHeader();
+      }
+      ds.streaming_header_ = false;
+    } else {
+      ds.bufferBinaryDataPoint();
     }
-    ds.last_write_time_ = std::chrono::high_resolution_clock::now();
-    resetStringstream(ds.data_point_);
+    if (ds.file_data_point_) {
+      ds.last_write_time_ = Clock::instance().now();
+    }
+    ds.data_point_.clear();
     ds.streaming_ = false;
   }
+  // The epoch is only read by other threads, so the producer can load it
+  // without synchronization
+  if (ds.writer_epoch_.load(std::memory_order_relaxed) % 2 == 1) {
+    ++ds.writer_epoch_;
+  }
   return ds;
 }
+
+void DataStream::bufferBinaryDataPoint() {
+  // The column types are fixed by the first valid data point
+  if (!binary_data_point_valid_ ||
+      (!schema_.types.empty() && binary_data_point_types_ != schema_.types)) {
+    ++dropped_data_points_;
+  } else {
+    if (schema_.types.empty()) {
+      schema_.types = binary_data_point_types_;
+      updateRecorderHeader();
+    }
+    if (file_data_point_) {
+      if (!schema_written_) {
+        schema_written_ = pushRecord(kHeaderRecord +
+                                     binary_log::encodeSchema(schema_));
+      }
+      if (schema_written_) {
+        pushRecord(data_point_);
+      }
+    }
+    recordDataPoint();
+  }
+  binary_data_point_types_.clear();
+  binary_data_point_valid_ = true;
+}
+
+void DataStream::recordDataPoint() {
+  if (!recorder_) {
+    return;
+  }
+  // Records are stored without their tag, as they are written to file
+  if (data_point_[0] == kHeaderRecord) {
+    recorder_->setHeader(data_point_.data() + 1, data_point_.size() - 1);
+  } else {
+    recorder_->record(data_point_time_, data_point_.data() + 1,
+                      data_point_.size() - 1);
+  }
+}
+
+void DataStream::updateRecorderHeader() {
+  if (!recorder_ || schema_.types.empty()) {
+    return;
+  }
+  // Dumps are small, so they are not compressed
+  binary_log::Schema schema = schema_;
+  schema.encoding = binary_log::Encoding::Fixed;
+  std::string header = binary_log::encodeSchema(schema);
+  recorder_->setHeader(header.data(), header.size());
+}
@@ -0,0 +1,85 @@
+#include "aerial_autonomy/log/flight_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+FlightRecorder::FlightRecorder(size_t capacity, double duration)
+    : capacity_(capacity),
+      duration_(std::chrono::duration_cast<
+                    std::chrono::high_resolution_clock::duration>(
+                    std::chrono::duration<double>(duration))
+                    .count()),
+      ring_(new char[capacity]), head_(0), tail_(0), newest_time_(0) {}
+
+void FlightRecorder::setHeader(const char *data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  header_.assign(data, size);
+}
+
+void FlightRecorder::record(int64_t time, const char *data, size_t size) {
+  const size_t required = kEntryHeaderSize + size;
+  if (required > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (required > capacity_ - (head_ - tail_)) {
+    uint32_t oldest_size;
+    copyOut(tail_ + sizeof(int64_t), reinterpret_cast<char *>(&oldest_size),
+            sizeof(uint32_t));
+    tail_ += kEntryHeaderSize + oldest_size;
+  }
+  uint32_t entry_size = size;
+  copyIn(head_, reinterpret_cast<const char *>(&time), sizeof(int64_t));
+  copyIn(head_ + sizeof(int64_t), reinterpret_cast<const char *>(&entry_size),
+         sizeof(uint32_t));
+  copyIn(head_ + kEntryHeaderSize, data, size);
+  head_ += required;
+  newest_time_ = time;
+}
+
+size_t FlightRecorder::snapshot(std::string &header, std::string &data) const {
+  std::string ring;
+  int64_t start_time;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    header = header_;
+    start_time = newest_time_ - duration_;
+    // Copy out the whole ring so that recording is blocked as briefly as
+    // possible
+    ring.resize(head_ - tail_);
+    copyOut(tail_, &ring[0], ring.size());
+  }
+  data.clear();
+  size_t data_points = 0;
+  for (size_t offset = 0; offset < ring.size();) {
+    int64_t time;
+    uint32_t size;
+    std::memcpy(&time, &ring[offset], sizeof(int64_t));
+    std::memcpy(&size, &ring[offset + sizeof(int64_t)], sizeof(uint32_t));
+    offset += kEntryHeaderSize;
+    if (time >= start_time) {
+      data.append(&ring[offset], size);
+      ++data_points;
+    }
+    offset += size;
+  }
+  return data_points;
+}
+
+size_t FlightRecorder::capacity() const { return capacity_; }
+
+void FlightRecorder::copyIn(uint64_t position, const char *data, size_t size) {
+  size_t offset = position % capacity_;
+  size_t first = std::min(size, capacity_ - offset);
+  std::memcpy(&ring_[offset], data, first);
+  std::memcpy(&ring_[0], data + first, size - first);
+}
+
+void FlightRecorder::copyOut(uint64_t position, char *data,
+                             size_t size) const {
+  size_t offset = position % capacity_;
+  size_t first = std::min(size, capacity_ - offset);
+  std::memcpy(data, &ring_[offset], first);
+  std::memcpy(data + first, &ring_[0], size - first);
+}
@@ -0,0 +1,290 @@
+#include "aerial_autonomy/log/gorilla_codec.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace binary_log {
+
+namespace {
+/**
+* @brief Leading zeros of a column without a XOR window. Never matches a XOR
+*/
+const unsigned kNoWindow = 65;
+
+/**
+* @brief Maximum leading zeros stored for a XOR (5 bits)
+*/
+const unsigned kMaxLeading = 31;
+
+/**
+* @brief Bit widths of the delta-of-delta buckets. Bucket i is prefixed by i
+* one bits and a zero bit. The last bucket stores the full 64 bit value and
+* is prefixed by one bits only
+*/
+const unsigned kDeltaOfDeltaBits[] = {0, 7, 9, 12, 32, 64};
+
+/**
+* @brief Number of delta-of-delta buckets
+*/
+const unsigned kDeltaOfDeltaBuckets =
+    sizeof(kDeltaOfDeltaBits) / sizeof(kDeltaOfDeltaBits[0]);
+
+/**
+* @brief Mask of the lowest bits of a 64 bit value
+*/
+uint64_t lowMask(unsigned count) {
+  return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+}
+
+/**
+* @brief Map a signed value stored in two's complement to an unsigned value
+* with small magnitude for small positive and negative values
+*/
+uint64_t zigzagEncode(uint64_t value) {
+  return (value << 1) ^ (0 - (value >> 63));
+}
+
+/**
+* @brief Inverse of zigzagEncode
+*/
+uint64_t zigzagDecode(uint64_t value) {
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+/**
+* @brief Append a fixed size value to a byte string
+*/
+void append(std::string &out, uint32_t value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+}
+
+BitWriter::BitWriter() : free_bits_(0) {}
+
+void BitWriter::write(uint64_t value, unsigned count) {
+  value &= lowMask(count);
+  while (count > 0) {
+    if (free_bits_ == 0) {
+      bytes_.push_back(0);
+      free_bits_ = 8;
+    }
+    unsigned bits = count < free_bits_ ? count : free_bits_;
+    uint8_t chunk = (value >> (count - bits)) & lowMask(bits);
+    bytes_.back() |= char(chunk << (free_bits_ - bits));
+    free_bits_ -= bits;
+    count -= bits;
+  }
+}
+
+const std::string &BitWriter::bytes() const { return bytes_; }
+
+void BitWriter::clear() {
+  bytes_.clear();
+  free_bits_ = 0;
+}
+
+BitReader::BitReader(const char *data, size_t size)
+    : data_(reinterpret_cast<const uint8_t *>(data)), size_(size),
+      position_(0) {}
+
+bool BitReader::read(unsigned count, uint64_t &value) {
+  if (position_ + count > size_ * 8) {
+    return false;
+  }
+  value = 0;
+  while (count > 0) {
+    unsigned available = 8 - position_ % 8;
+    unsigned bits = count < available ? count : available;
+    uint8_t chunk = data_[position_ / 8] >> (available - bits);
+    value = (value << bits) | (chunk & lowMask(bits));
+    position_ += bits;
+    count -= bits;
+  }
+  return true;
+}
+
+ColumnState::ColumnState()
+    : previous(0), previous_delta(0), leading(kNoWindow), trailing(0) {}
+
+BlockEncoder::BlockEncoder(std::vector<ColumnType> types)
+    : types_(types), columns_(types.size()), record_count_(0) {}
+
+void BlockEncoder::add(const char *record) {
+  // Both column types are 64 bits wide
+  for (size_t i = 0; i < types_.size(); ++i) {
+    uint64_t value;
+    std::memcpy(&value, record + i * sizeof(value), sizeof(value));
+    if (types_[i] == ColumnType::Double) {
+      writeDouble(columns_[i], value);
+    } else if (i == 0) {
+      writeTimestamp(columns_[i], value);
+    } else {
+      writeInteger(columns_[i], value);
+    }
+    columns_[i].previous = value;
+  }
+  ++record_count_;
+}
+
+uint32_t BlockEncoder::recordCount() const { return record_count_; }
+
+std::string BlockEncoder::finish() {
+  std::string block;
+  if (record_count_ > 0) {
+    append(block, record_count_);
+    append(block, uint32_t(writer_.bytes().size()));
+    block.append(writer_.bytes());
+  }
+  writer_.clear();
+  columns_.assign(types_.size(), ColumnState());
+  record_count_ = 0;
+  return block;
+}
+
+void BlockEncoder::writeTimestamp(ColumnState &column, uint64_t value) {
+  uint64_t delta = value - column.previous;
+  int64_t delta_of_delta = int64_t(delta - column.previous_delta);
+  column.previous_delta = delta;
+  for (unsigned bucket = 0; bucket < kDeltaOfDeltaBuckets; ++bucket) {
+    unsigned bits = kDeltaOfDeltaBits[bucket];
+    bool last = bucket + 1 == kDeltaOfDeltaBuckets;
+    if (last || (bits == 0 && delta_of_delta == 0) ||
+        (bits > 0 && delta_of_delta >= -(int64_t(1) << (bits - 1)) &&
+         delta_of_delta < (int64_t(1) << (bits - 1)))) {
+      // Prefix of ones terminated by a zero except for the last bucket
+      if (last) {
+        writer_.write(lowMask(bucket), bucket);
+      } else {
+        writer_.write(lowMask(bucket) << 1, bucket + 1);
+      }
+      writer_.write(uint64_t(delta_of_delta), bits);
+      return;
+    }
+  }
+}
+
+void BlockEncoder::writeInteger(ColumnState &column, uint64_t value) {
+  uint64_t encoded = zigzagEncode(value - column.previous);
+  do {
+    uint64_t group = encoded & 0x7f;
+    encoded >>= 7;
+    writer_.write((encoded != 0 ? 0x80 : 0) | group, 8);
+  } while (encoded != 0);
+}
+
+void BlockEncoder::writeDouble(ColumnState &column, uint64_t value) {
+  uint64_t xor_value = value ^ column.previous;
+  if (xor_value == 0) {
+    writer_.write(0, 1);
+    return;
+  }
+  unsigned leading = __builtin_clzll(xor_value);
+  unsigned trailing = __builtin_ctzll(xor_value);
+  if (leading > kMaxLeading) {
+    leading = kMaxLeading;
+  }
+  if (leading >= column.leading && trailing >= column.trailing) {
+    // Meaningful bits fit in the previous window
+    writer_.write(0x2, 2);
+    writer_.write(xor_value >> column.trailing,
+                  64 - column.leading - column.trailing);
+  } else {
+    unsigned meaningful = 64 - leading - trailing;
+    writer_.write(0x3, 2);
+    writer_.write(leading, 5);
+    writer_.write(meaningful - 1, 6);
+    writer_.write(xor_value >> trailing, meaningful);
+    column.leading = leading;
+    column.trailing = trailing;
+  }
+}
+
+BlockDecoder::BlockDecoder(std::vector<ColumnType> types)
+    : types_(types), reader_(nullptr, 0), record_count_(0),
+      record_index_(0) {}
+
+void BlockDecoder::reset(const char *data, size_t size,
+                         uint32_t record_count) {
+  columns_.assign(types_.size(), ColumnState());
+  reader_ = BitReader(data, size);
+  record_count_ = record_count;
+  record_index_ = 0;
+}
+
+bool BlockDecoder::next(char *record) {
+  if (record_index_ >= record_count_) {
+    return false;
+  }
+  for (size_t i = 0; i < types_.size(); ++i) {
+    uint64_t value;
+    if (types_[i] == ColumnType::Double) {
+      value = readDouble(columns_[i]);
+    } else if (i == 0) {
+      value = readTimestamp(columns_[i]);
+    } else {
+      value = readInteger(columns_[i]);
+    }
+    columns_[i].previous = value;
+    std::memcpy(record + i * sizeof(value), &value, sizeof(value));
+  }
+  ++record_index_;
+  return true;
+}
+
+uint64_t BlockDecoder::read(unsigned count) {
+  uint64_t value;
+  if (!reader_.read(count, value)) {
+    throw std::runtime_error("Corrupt compressed block");
+  }
+  return value;
+}
+
+uint64_t BlockDecoder::readTimestamp(ColumnState &column) {
+  unsigned bucket = 0;
+  while (bucket + 1 < kDeltaOfDeltaBuckets && read(1) == 1) {
+    ++bucket;
+  }
+  unsigned bits = kDeltaOfDeltaBits[bucket];
+  uint64_t delta_of_delta = bits > 0 ? read(bits) : 0;
+  if (bits > 0 && bits < 64 && (delta_of_delta >> (bits - 1)) != 0) {
+    // Sign extend
+    delta_of_delta |= ~lowMask(bits);
+  }
+  column.previous_delta += delta_of_delta;
+  return column.previous + column.previous_delta;
+}
+
+uint64_t BlockDecoder::readInteger(ColumnState &column) {
+  uint64_t encoded = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    if (shift >= 64) {
+      throw std::runtime_error("Corrupt compressed block");
+    }
+    uint64_t group = read(8);
+    encoded |= (group & 0x7f) << shift;
+    if ((group & 0x80) == 0) {
+      break;
+    }
+  }
+  return column.previous + zigzagDecode(encoded);
+}
+
+uint64_t BlockDecoder::readDouble(ColumnState &column) {
+  if (read(1) == 0) {
+    return column.previous;
+  }
+  if (read(1) == 1) {
+    unsigned leading = read(5);
+    unsigned meaningful = read(6) + 1;
+    if (leading + meaningful > 64) {
+      throw std::runtime_error("Corrupt compressed block");
+    }
+    column.leading = leading;
+    column.trailing = 64 - leading - meaningful;
+  } else if (column.leading == kNoWindow) {
+    throw std::runtime_error("Corrupt compressed block");
+  }
+  uint64_t meaningful = read(64 - column.leading - column.trailing);
+  return column.previous ^ (meaningful << column.trailing);
+}
+}
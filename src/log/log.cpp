@@ -1,32 +1,177 @@
 #include "aerial_autonomy/log/log.h"
 #include "aerial_autonomy/common/string_utils.h"
+#include "aerial_autonomy/log/trace.h"
 
 #include <boost/filesystem.hpp>
 #include <glog/logging.h>
 
+#include <fstream>
+#include <map>
+
+thread_local Log *Log::current_log_ = nullptr;
+
+namespace {
+/**
+* @brief Log directories in use and the logs using them. Never destroyed since
+* the default Log releases its directory during static destruction
+*/
+std::map<boost::filesystem::path, Log *> &directoryOwners() {
+  static auto owners = new std::map<boost::filesystem::path, Log *>();
+  return *owners;
+}
+
+/**
+* @brief Guards directoryOwners
+*/
+std::mutex &directoryOwnersMutex() {
+  static auto mutex = new std::mutex();
+  return *mutex;
+}
+
+/**
+* @brief Time after which no thread is assumed to be between loading a stream
+* from a handle and starting a data point on it
+*/
+const std::chrono::seconds kRetiredStreamsGracePeriod(1);
+}
+
 Log::~Log() {
-  log_timer_.stop();
+  stopWriter();
   writeStreams(); // Make sure all data is out of the stream buffers
+  if (config_.lock_profile_period() > 0 && !directory_.empty()) {
+    writeLockReport();
+  }
+  if (config_.trace_events_per_thread() > 0 && !directory_.empty()) {
+    try {
+      Tracer::instance().writeChromeTrace(directory_ / "trace.json");
+    } catch (const std::exception &e) {
+      LOG(ERROR) << e.what();
+    }
+  }
+  claimDirectory(boost::filesystem::path());
+}
+
+bool Log::claimDirectory(const boost::filesystem::path &directory) {
+  std::lock_guard<std::mutex> lock(directoryOwnersMutex());
+  auto &owners = directoryOwners();
+  if (!directory.empty()) {
+    auto owner = owners.find(directory);
+    if (owner != owners.end() && owner->second != this) {
+      return false;
+    }
+  }
+  auto previous = owners.find(directory_);
+  if (previous != owners.end() && previous->second == this) {
+    owners.erase(previous);
+  }
+  if (!directory.empty()) {
+    owners[directory] = this;
+  }
+  return true;
 }
 
 void Log::configure(LogConfig config) {
+  // The writer thread reads the config and the directory
+  stopWriter();
   config_ = config;
+  last_lock_report_ = std::chrono::steady_clock::now();
 
   // \todo Matt Add git commit tag to log file
-  directory_ = config_.directory() + string_utils::currentDateTimeString();
-  if (!boost::filesystem::exists(directory_)) {
-    if (!boost::filesystem::create_directory(directory_)) {
-      throw std::runtime_error("Could not create Log directory: " +
-                               directory_.string());
+  boost::filesystem::path directory =
+      config_.directory() + string_utils::currentDateTimeString();
+  try {
+    // Logs writing the same stream ids into one directory would overwrite
+    // each other's files
+    if (!claimDirectory(directory)) {
+      throw std::runtime_error("Log directory used by another Log: " +
+                               directory.string());
     }
+    directory_ = directory;
+    if (!boost::filesystem::exists(directory_)) {
+      if (!boost::filesystem::create_directory(directory_)) {
+        throw std::runtime_error("Could not create Log directory: " +
+                                 directory_.string());
+      }
+    }
+  } catch (...) {
+    // Keep draining the current streams
+    startWriter();
+    throw;
   }
   configureStreams(config_);
+  if (config_.trace_events_per_thread() > 0) {
+    Tracer::instance().enable(config_.trace_events_per_thread());
+  }
+  if (config_.lock_profile_period() > 0) {
+    LockProfiler::instance().enable();
+  }
 }
 
 boost::filesystem::path Log::directory() { return directory_; }
 
+void Log::requestRecorderDump(std::string reason) {
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> since_last_dump = now - last_dump_request_;
+    if (!writer_running_ || dump_requested_ ||
+        (dump_count_ > 0 &&
+         since_last_dump.count() < config_.recorder_dump_interval())) {
+      return;
+    }
+    dump_requested_ = true;
+    dump_reason_ = reason;
+    last_dump_request_ = now;
+    ++dump_count_;
+  }
+  writer_cv_.notify_all();
+}
+
+boost::filesystem::path Log::dumpRecorders(std::string reason) {
+  std::vector<DataStream *> streams;
+  {
+    std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
+    for (auto &stream : streams_) {
+      streams.push_back(&stream.second);
+    }
+  }
+  boost::filesystem::path dump_directory =
+      directory_ / ("recorder_" + std::to_string(recorder_dumps_++));
+  size_t data_points = 0;
+  for (auto stream : streams) {
+    if (stream->configuration().recorder_duration() <= 0) {
+      continue;
+    }
+    try {
+      boost::filesystem::create_directories(dump_directory);
+      data_points += stream->dumpRecorder(
+          dump_directory / stream->configuration().stream_id());
+    } catch (const std::exception &e) {
+      LOG(ERROR) << "Flight recorder dump of "
+                 << stream->configuration().stream_id()
+                 << " failed: " << e.what();
+    }
+  }
+  if (data_points > 0 && config_.trace_events_per_thread() > 0) {
+    try {
+      Tracer::instance().writeChromeTrace(dump_directory / "trace.json");
+    } catch (const std::exception &e) {
+      LOG(ERROR) << e.what();
+    }
+  }
+  if (data_points == 0) {
+    boost::system::error_code error;
+    boost::filesystem::remove(dump_directory, error);
+    return boost::filesystem::path();
+  }
+  LOG(WARNING) << "Flight recorder dumped " << data_points
+               << " data points to " << dump_directory.string() << " ("
+               << reason << ")";
+  return dump_directory;
+}
+
 DataStream &Log::operator[](std::string id) {
-  boost::recursive_mutex::scoped_lock(streams_mutex_);
+  std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
   auto stream = streams_.find(id);
   if (stream == streams_.end()) {
     // \todo Matt Find a better way to deal with this...
@@ -35,46 +180,207 @@ DataStream &Log::operator[](std::string id) {
     // Return a disabled stream if stream does not exist
     LOG_EVERY_N(WARNING, 20) << "DataStream with id \"" << id
                              << "\" does not exist! Returning disabled stream";
-    std::string empty_name("empty");
-    auto empty_stream = streams_.find(empty_name);
-    if (empty_stream == streams_.end()) {
-      DataStreamConfig config;
-      config.set_stream_id(empty_name);
-      config.set_log_data(false);
-      addDataStream(config);
-      empty_stream = streams_.find(empty_name);
-    }
-    return empty_stream->second;
+    return emptyStream();
   }
   return stream->second;
 }
 
+StreamHandle Log::registerStream(std::string id) {
+  std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
+  auto slot = handle_slots_.find(id);
+  if (slot == handle_slots_.end()) {
+    auto stream = streams_.find(id);
+    DataStream *stream_ptr =
+        stream == streams_.end() ? &emptyStream() : &stream->second;
+    slot = handle_slots_
+               .emplace(id, std::unique_ptr<std::atomic<DataStream *>>(
+                                new std::atomic<DataStream *>(stream_ptr)))
+               .first;
+  }
+  return StreamHandle(slot->second.get());
+}
+
+DataStream &Log::emptyStream() {
+  if (!empty_stream_) {
+    DataStreamConfig config;
+    config.set_stream_id("empty");
+    config.set_log_data(false);
+    empty_stream_.reset(new DataStream("/dev/null", config, 0, nullptr));
+  }
+  return *empty_stream_;
+}
+
+void Log::rebindHandles() {
+  for (auto &slot : handle_slots_) {
+    auto stream = streams_.find(slot.first);
+    DataStream *stream_ptr =
+        stream == streams_.end() ? &emptyStream() : &stream->second;
+    slot.second->store(stream_ptr, std::memory_order_release);
+  }
+}
+
 void Log::addDataStream(DataStreamConfig stream_config) {
-  boost::recursive_mutex::scoped_lock(streams_mutex_);
+  std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
   if (streams_.find(stream_config.stream_id()) != streams_.end()) {
     throw std::runtime_error("Stream ID not unique: " +
                              stream_config.stream_id());
   }
-  streams_.emplace(
+  // Disabled streams never write, so they do not need preallocated segments
+  uint64_t segment_size = 0;
+  if (config_.backend() == LogConfig::MMAP_SEGMENTS &&
+      stream_config.log_data()) {
+    segment_size = config_.segment_size();
+  }
+  auto stream = streams_.emplace(
       stream_config.stream_id(),
-      DataStream(directory_ / stream_config.stream_id(), stream_config));
+      DataStream(directory_ / stream_config.stream_id(), stream_config,
+                 segment_size, disk_budget_));
+  auto slot = handle_slots_.find(stream_config.stream_id());
+  if (slot != handle_slots_.end()) {
+    slot->second->store(&stream.first->second, std::memory_order_release);
+  }
 }
 
 void Log::configureStreams(LogConfig config) {
-  boost::recursive_mutex::scoped_lock(streams_mutex_);
-  log_timer_.stop(); // \todo Matt With locking, we should not have to stop the
-                     // timer... but for some reason it does not write otherwise
-  streams_.clear();  // streams are closed in destructor
-  for (auto stream_config : config_.data_stream_configs()) {
-    addDataStream(stream_config);
+  // The writer drains streams without holding the streams lock, so it has to
+  // be stopped before streams are removed
+  stopWriter();
+  {
+    std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
+    // Handles are read without the lock, so they have to point to the
+    // disabled stream while the streams are replaced
+    DataStream &empty_stream = emptyStream();
+    for (auto &slot : handle_slots_) {
+      slot.second->store(&empty_stream, std::memory_order_release);
+    }
+    // A thread may still be writing to a stream it got from a handle before,
+    // so the replaced streams are closed but only destroyed once the threads
+    // are done with them
+    for (auto &stream : streams_) {
+      stream.second.close();
+    }
+    freeRetiredStreams();
+    if (!streams_.empty()) {
+      retired_streams_.push_back(RetiredStreams());
+      retired_streams_.back().streams = std::move(streams_);
+      retired_streams_.back().time = std::chrono::steady_clock::now();
+      streams_.clear();
+    }
+    disk_budget_ = std::make_shared<DiskBudget>(config_.disk_budget());
+    try {
+      for (auto stream_config : config_.data_stream_configs()) {
+        addDataStream(stream_config);
+      }
+    } catch (...) {
+      // Keep draining the streams added before the failure
+      rebindHandles();
+      startWriter();
+      throw;
+    }
+    rebindHandles();
   }
-  log_timer_.setDuration(std::chrono::milliseconds(config_.write_duration()));
-  log_timer_.start();
+  startWriter();
 }
 
 void Log::writeStreams() {
-  boost::recursive_mutex::scoped_lock(streams_mutex_);
-  for (auto &stream : instance().streams_) {
-    stream.second.write();
+  // Streams are only removed while the writer is stopped and unordered_map
+  // insertions do not invalidate element references, so the streams can be
+  // drained without blocking stream lookups
+  std::vector<DataStream *> streams;
+  {
+    std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
+    streams.reserve(streams_.size());
+    for (auto &stream : streams_) {
+      streams.push_back(&stream.second);
+    }
+  }
+  for (auto stream : streams) {
+    stream->write();
+  }
+}
+
+void Log::freeRetiredStreams() {
+  auto now = std::chrono::steady_clock::now();
+  for (auto retired = retired_streams_.begin();
+       retired != retired_streams_.end();) {
+    bool quiescent = now - retired->time >= kRetiredStreamsGracePeriod;
+    for (auto &stream : retired->streams) {
+      quiescent = quiescent && stream.second.writerEpoch() % 2 == 0;
+    }
+    if (quiescent) {
+      retired = retired_streams_.erase(retired);
+    } else {
+      ++retired;
+    }
+  }
+}
+
+size_t Log::retiredStreams() {
+  std::lock_guard<ProfiledRecursiveMutex> lock(streams_mutex_);
+  return retired_streams_.size();
+}
+
+void Log::startWriter() {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  writer_running_ = true;
+  writer_thread_ = std::thread(std::bind(&Log::writerLoop, this));
+}
+
+void Log::stopWriter() {
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    writer_running_ = false;
+  }
+  writer_cv_.notify_all();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+}
+
+void Log::writerLoop() {
+  std::unique_lock<std::mutex> lock(writer_mutex_);
+  while (writer_running_) {
+    auto next_write = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(config_.write_duration());
+    bool dump = dump_requested_;
+    std::string dump_reason = dump_reason_;
+    dump_requested_ = false;
+    lock.unlock();
+    if (dump) {
+      dumpRecorders(dump_reason);
+    }
+    writeStreams();
+    {
+      std::lock_guard<ProfiledRecursiveMutex> streams_lock(streams_mutex_);
+      freeRetiredStreams();
+    }
+    if (config_.lock_profile_period() > 0) {
+      std::chrono::duration<double> since_last_report =
+          std::chrono::steady_clock::now() - last_lock_report_;
+      if (since_last_report.count() >= config_.lock_profile_period()) {
+        writeLockReport();
+      }
+    }
+    lock.lock();
+    writer_cv_.wait_until(lock, next_write, [this] {
+      return !writer_running_ || dump_requested_;
+    });
+  }
+  // Streams may be removed once the writer stops
+  if (dump_requested_) {
+    dump_requested_ = false;
+    std::string dump_reason = dump_reason_;
+    lock.unlock();
+    dumpRecorders(dump_reason);
+  }
+}
+
+void Log::writeLockReport() {
+  last_lock_report_ = std::chrono::steady_clock::now();
+  std::ofstream report((directory_ / "lock_profile.txt").string());
+  if (!report) {
+    LOG(ERROR) << "Could not write lock profile to " << directory_.string();
+    return;
   }
+  LockProfiler::instance().writeReport(report);
 }
@@ -1,7 +1,9 @@
 #include <aerial_autonomy/log/log.h>
 #include <aerial_autonomy/log/mocap_logger.h>
 
-MocapLogger::MocapLogger() : nh_("mocap_log") {
+MocapLogger::MocapLogger()
+    : nh_("mocap_log"),
+      log_stream_(Log::current().registerStream("mocap_logger")) {
   mocap_sub_ = nh_.subscribe("quad_pose_mocap", 1, &MocapLogger::logData, this);
   DATA_HEADER("mocap_logger") << "X"
                               << "Y"
@@ -14,8 +16,8 @@ MocapLogger::MocapLogger() : nh_("mocap_log") {
 
 void MocapLogger::logData(const geometry_msgs::TransformStampedConstPtr data) {
   auto &transform = data->transform;
-  DATA_LOG("mocap_logger") << transform.translation.x << transform.translation.y
-                           << transform.translation.z << transform.rotation.x
-                           << transform.rotation.y << transform.rotation.z
-                           << transform.rotation.w << DataStream::endl;
+  DATA_LOG(log_stream_) << transform.translation.x << transform.translation.y
+                        << transform.translation.z << transform.rotation.x
+                        << transform.rotation.y << transform.rotation.z
+                        << transform.rotation.w << DataStream::endl;
 }
@@ -0,0 +1,53 @@
+#include "aerial_autonomy/log/record_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+RecordRingBuffer::RecordRingBuffer(size_t capacity)
+    : capacity_(capacity), ring_(new char[capacity]), head_(0), tail_(0) {}
+
+bool RecordRingBuffer::push(const char *data, size_t size) {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  const size_t required = sizeof(uint32_t) + size;
+  if (required > capacity_ - (head - tail)) {
+    return false;
+  }
+  uint32_t record_size = size;
+  copyIn(head, reinterpret_cast<const char *>(&record_size), sizeof(uint32_t));
+  copyIn(head + sizeof(uint32_t), data, size);
+  head_.store(head + required, std::memory_order_release);
+  return true;
+}
+
+bool RecordRingBuffer::pop(std::string &record) {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  if (head == tail) {
+    return false;
+  }
+  uint32_t record_size;
+  copyOut(tail, reinterpret_cast<char *>(&record_size), sizeof(uint32_t));
+  record.resize(record_size);
+  copyOut(tail + sizeof(uint32_t), &record[0], record_size);
+  tail_.store(tail + sizeof(uint32_t) + record_size, std::memory_order_release);
+  return true;
+}
+
+size_t RecordRingBuffer::capacity() const { return capacity_; }
+
+void RecordRingBuffer::copyIn(uint64_t position, const char *data,
+                              size_t size) {
+  size_t offset = position % capacity_;
+  size_t first = std::min(size, capacity_ - offset);
+  std::memcpy(&ring_[offset], data, first);
+  std::memcpy(&ring_[0], data + first, size - first);
+}
+
+void RecordRingBuffer::copyOut(uint64_t position, char *data,
+                               size_t size) const {
+  size_t offset = position % capacity_;
+  size_t first = std::min(size, capacity_ - offset);
+  std::memcpy(data, &ring_[offset], first);
+  std::memcpy(data + first, &ring_[0], size - first);
+}
@@ -0,0 +1,182 @@
+#include "aerial_autonomy/log/segmented_file_writer.h"
+
+#include <glog/logging.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+DiskBudget::DiskBudget(uint64_t budget) : budget_(budget), usage_(0) {}
+
+void DiskBudget::openSegment(const boost::filesystem::path &path,
+                             uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  segments_.push_back(Segment{path, size, true});
+  usage_ += size;
+  retireSegments();
+}
+
+void DiskBudget::closeSegment(const boost::filesystem::path &path,
+                              uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &segment : segments_) {
+    if (segment.path == path) {
+      usage_ = usage_ - segment.size + size;
+      segment.size = size;
+      segment.open = false;
+      break;
+    }
+  }
+  retireSegments();
+}
+
+uint64_t DiskBudget::usage() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return usage_;
+}
+
+void DiskBudget::retireSegments() {
+  if (budget_ == 0) {
+    return;
+  }
+  auto it = segments_.begin();
+  while (usage_ > budget_ && it != segments_.end()) {
+    if (it->open) {
+      ++it;
+      continue;
+    }
+    boost::system::error_code error;
+    boost::filesystem::remove(it->path, error);
+    if (error) {
+      LOG(WARNING) << "Could not remove log segment " << it->path << ": "
+                   << error.message();
+    } else {
+      VLOG(1) << "Retired log segment " << it->path;
+    }
+    usage_ -= it->size;
+    it = segments_.erase(it);
+  }
+}
+
+SegmentedFileWriter::SegmentedFileWriter(
+    boost::filesystem::path path, uint64_t segment_size,
+    std::shared_ptr<DiskBudget> disk_budget)
+    : path_(path), segment_size_(segment_size), disk_budget_(disk_budget),
+      fd_(-1), map_(nullptr), offset_(0), segment_count_(0) {
+  if (segment_size_ == 0) {
+    throw std::runtime_error("Segment size must be positive");
+  }
+  if (!openSegment()) {
+    throw std::runtime_error("Could not open segment: " +
+                             segmentPath(path_, 0).string());
+  }
+}
+
+SegmentedFileWriter::~SegmentedFileWriter() { closeSegment(); }
+
+bool SegmentedFileWriter::write(const char *data, size_t size) {
+  if (segment_header_.size() + size > segment_size_) {
+    LOG_EVERY_N(WARNING, 100) << "Record of " << size
+                              << " bytes does not fit in a segment of "
+                              << path_;
+    return false;
+  }
+  if (map_ == nullptr || offset_ + size > segment_size_) {
+    closeSegment();
+    if (!openSegment()) {
+      return false;
+    }
+  }
+  std::memcpy(map_ + offset_, data, size);
+  offset_ += size;
+  return true;
+}
+
+bool SegmentedFileWriter::writeHeader(const char *data, size_t size) {
+  if (size > segment_size_) {
+    LOG_EVERY_N(WARNING, 100) << "Header of " << size
+                              << " bytes does not fit in a segment of "
+                              << path_;
+    return false;
+  }
+  segment_header_.assign(data, size);
+  if (map_ == nullptr || offset_ + size > segment_size_) {
+    // The new segment starts with the header
+    closeSegment();
+    return openSegment();
+  }
+  std::memcpy(map_ + offset_, data, size);
+  offset_ += size;
+  return true;
+}
+
+unsigned SegmentedFileWriter::segmentCount() const { return segment_count_; }
+
+boost::filesystem::path
+SegmentedFileWriter::segmentPath(const boost::filesystem::path &path,
+                                 unsigned index) {
+  char suffix[16];
+  std::snprintf(suffix, sizeof(suffix), ".%06u", index);
+  return boost::filesystem::path(path.string() + suffix);
+}
+
+bool SegmentedFileWriter::openSegment() {
+  boost::filesystem::path segment_path = segmentPath(path_, segment_count_);
+  int fd = ::open(segment_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG_EVERY_N(ERROR, 100) << "Could not open segment " << segment_path
+                            << ": " << std::strerror(errno);
+    return false;
+  }
+  int error = ::posix_fallocate(fd, 0, segment_size_);
+  if (error != 0) {
+    LOG_EVERY_N(ERROR, 100) << "Could not preallocate segment " << segment_path
+                            << ": " << std::strerror(error);
+    ::close(fd);
+    ::unlink(segment_path.c_str());
+    return false;
+  }
+  void *map =
+      ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    LOG_EVERY_N(ERROR, 100) << "Could not map segment " << segment_path << ": "
+                            << std::strerror(errno);
+    ::close(fd);
+    ::unlink(segment_path.c_str());
+    return false;
+  }
+  fd_ = fd;
+  map_ = static_cast<char *>(map);
+  offset_ = 0;
+  ++segment_count_;
+  if (disk_budget_) {
+    disk_budget_->openSegment(segment_path, segment_size_);
+  }
+  std::memcpy(map_, segment_header_.data(), segment_header_.size());
+  offset_ = segment_header_.size();
+  return true;
+}
+
+void SegmentedFileWriter::closeSegment() {
+  if (map_ == nullptr) {
+    return;
+  }
+  boost::filesystem::path segment_path =
+      segmentPath(path_, segment_count_ - 1);
+  ::munmap(map_, segment_size_);
+  if (::ftruncate(fd_, offset_) != 0) {
+    LOG(WARNING) << "Could not truncate segment " << segment_path << ": "
+                 << std::strerror(errno);
+  }
+  ::close(fd_);
+  map_ = nullptr;
+  fd_ = -1;
+  if (disk_budget_) {
+    disk_budget_->closeSegment(segment_path, offset_);
+  }
+}
@@ -0,0 +1,182 @@
+#include "aerial_autonomy/log/stream_query.h"
+#include "aerial_autonomy/log/binary_log_format.h"
+#include "aerial_autonomy/log/time_index.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+/**
+* @brief Split a line at a delimiter
+*/
+std::vector<std::string> split(const std::string &line,
+                               const std::string &delimiter) {
+  std::vector<std::string> fields;
+  size_t start = 0;
+  while (true) {
+    size_t end = line.find(delimiter, start);
+    if (end == std::string::npos || delimiter.empty()) {
+      fields.push_back(line.substr(start));
+      return fields;
+    }
+    fields.push_back(line.substr(start, end - start));
+    start = end + delimiter.size();
+  }
+}
+
+/**
+* @brief Find the indices of the queried columns in the header names. Empty
+* if all columns are queried
+*/
+std::vector<size_t> columnIndices(const StreamQuery &query,
+                                  const std::vector<std::string> &names) {
+  std::vector<size_t> indices;
+  for (const auto &column : query.columns) {
+    auto it = std::find(names.begin(), names.end(), column);
+    if (it == names.end()) {
+      throw std::runtime_error("Column not in stream header: " + column);
+    }
+    indices.push_back(it - names.begin());
+  }
+  return indices;
+}
+
+/**
+* @brief Write the selected fields of a data point or header
+*/
+template <class Format>
+void writeFields(std::ostream &out, const std::vector<size_t> &indices,
+                 size_t size, const std::string &delimiter, Format format) {
+  size_t count = indices.empty() ? size : indices.size();
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      out << delimiter;
+    }
+    out << format(indices.empty() ? i : indices[i]);
+  }
+  out << '\n';
+}
+
+/**
+* @brief Look up the offset to start reading from in the time index of a
+* stream file
+*/
+bool seekIndex(const boost::filesystem::path &path, int64_t time,
+               uint64_t &offset) {
+  boost::filesystem::path index_path = TimeIndexWriter::indexPath(path);
+  if (!boost::filesystem::exists(index_path)) {
+    return false;
+  }
+  try {
+    return TimeIndex(index_path).seek(time, offset);
+  } catch (const std::runtime_error &e) {
+    LOG(WARNING) << "Ignoring time index: " << e.what();
+    return false;
+  }
+}
+
+/**
+* @brief Query a delimiter separated text stream file
+*/
+uint64_t queryText(const boost::filesystem::path &path,
+                   const StreamQuery &query, std::ostream &out) {
+  std::ifstream fs(path.string());
+  if (!fs.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  std::string line;
+  std::vector<std::string> names;
+  if (std::getline(fs, line) && !line.empty() && line[0] == '#') {
+    names = split(line, query.delimiter);
+  }
+  std::vector<size_t> indices = columnIndices(query, names);
+  if (!names.empty()) {
+    writeFields(out, indices, names.size(), query.delimiter,
+                [&names](size_t i) { return names[i]; });
+  }
+  uint64_t offset = 0;
+  seekIndex(path, query.start, offset);
+  fs.clear();
+  fs.seekg(offset);
+  uint64_t count = 0;
+  while (std::getline(fs, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    int64_t time = std::strtoll(line.c_str(), nullptr, 10);
+    if (time < query.start) {
+      continue;
+    }
+    if (time > query.end) {
+      break;
+    }
+    std::vector<std::string> fields = split(line, query.delimiter);
+    for (auto index : indices) {
+      if (index >= fields.size()) {
+        throw std::runtime_error("Data point has fewer columns than header");
+      }
+    }
+    writeFields(out, indices, fields.size(), query.delimiter,
+                [&fields](size_t i) { return fields[i]; });
+    ++count;
+  }
+  return count;
+}
+
+/**
+* @brief Query a binary or compressed stream file
+*/
+uint64_t queryBinary(const boost::filesystem::path &path,
+                     const StreamQuery &query, std::ostream &out) {
+  binary_log::BinaryLogReader reader(path);
+  if (!reader.hasSchema()) {
+    return 0;
+  }
+  const binary_log::Schema &schema = reader.schema();
+  std::vector<size_t> indices = columnIndices(query, schema.names);
+  for (auto index : indices) {
+    if (index >= schema.types.size()) {
+      throw std::runtime_error("Header has more columns than data points");
+    }
+  }
+  if (!schema.names.empty()) {
+    writeFields(out, indices, schema.names.size(), schema.delimiter,
+                [&schema](size_t i) { return schema.names[i]; });
+  }
+  uint64_t offset;
+  if (seekIndex(path, query.start, offset)) {
+    reader.seek(offset);
+  }
+  uint64_t count = 0;
+  while (reader.next()) {
+    int64_t time = reader.getInt64(0);
+    if (time < query.start) {
+      continue;
+    }
+    if (time > query.end) {
+      break;
+    }
+    writeFields(out, indices, schema.types.size(), schema.delimiter,
+                [&reader](size_t i) { return reader.formatColumn(i); });
+    ++count;
+  }
+  return count;
+}
+}
+
+StreamQuery::StreamQuery()
+    : start(std::numeric_limits<int64_t>::min()),
+      end(std::numeric_limits<int64_t>::max()), delimiter(",") {}
+
+uint64_t queryStream(const boost::filesystem::path &path,
+                     const StreamQuery &query, std::ostream &out) {
+  if (binary_log::isBinaryLog(path)) {
+    return queryBinary(path, query, out);
+  }
+  return queryText(path, query, out);
+}
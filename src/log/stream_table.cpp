@@ -0,0 +1,159 @@
+#include "aerial_autonomy/log/stream_table.h"
+#include "aerial_autonomy/log/binary_log_format.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+/**
+* @brief Split a line at a delimiter
+*/
+std::vector<std::string> split(const std::string &line,
+                               const std::string &delimiter) {
+  std::vector<std::string> fields;
+  size_t start = 0;
+  while (true) {
+    size_t end = line.find(delimiter, start);
+    if (end == std::string::npos || delimiter.empty()) {
+      fields.push_back(line.substr(start));
+      return fields;
+    }
+    fields.push_back(line.substr(start, end - start));
+    start = end + delimiter.size();
+  }
+}
+
+/**
+* @brief Append the data points of a delimiter separated text stream file
+*/
+void readText(const boost::filesystem::path &path, const std::string &delimiter,
+              StreamTable &table) {
+  std::ifstream fs(path.string());
+  if (!fs.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields = split(line, delimiter);
+    if (line[0] == '#') {
+      table.names = fields;
+      continue;
+    }
+    if (fields.size() < table.names.size()) {
+      continue;
+    }
+    std::vector<double> row(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+      row[i] = std::strtod(fields[i].c_str(), nullptr);
+    }
+    table.times.push_back(std::strtoll(fields[0].c_str(), nullptr, 10));
+    table.rows.push_back(std::move(row));
+  }
+}
+
+/**
+* @brief Append the data points of a binary or compressed stream file
+*/
+void readBinary(const boost::filesystem::path &path, StreamTable &table) {
+  binary_log::BinaryLogReader reader(path);
+  if (!reader.hasSchema()) {
+    return;
+  }
+  const binary_log::Schema &schema = reader.schema();
+  table.names = schema.names;
+  if (schema.types.size() < schema.names.size()) {
+    return;
+  }
+  while (reader.next()) {
+    std::vector<double> row(schema.types.size());
+    for (size_t i = 0; i < row.size(); ++i) {
+      row[i] = schema.types[i] == binary_log::ColumnType::Int64
+                   ? reader.getInt64(i)
+                   : reader.getDouble(i);
+    }
+    table.times.push_back(reader.getInt64(0));
+    table.rows.push_back(std::move(row));
+  }
+}
+
+/**
+* @brief Find the segments of a stream file that are left on disk, in order
+*/
+std::vector<boost::filesystem::path>
+findSegments(const boost::filesystem::path &path) {
+  std::vector<boost::filesystem::path> segments;
+  boost::filesystem::path directory = path.parent_path();
+  if (directory.empty()) {
+    directory = ".";
+  }
+  if (!boost::filesystem::is_directory(directory)) {
+    return segments;
+  }
+  std::string prefix = path.filename().string() + ".";
+  for (boost::filesystem::directory_iterator it(directory), end; it != end;
+       ++it) {
+    std::string name = it->path().filename().string();
+    if (name.size() == prefix.size() + 6 &&
+        name.compare(0, prefix.size(), prefix) == 0 &&
+        std::all_of(name.begin() + prefix.size(), name.end(), ::isdigit)) {
+      segments.push_back(it->path());
+    }
+  }
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+}
+
+size_t StreamTable::column(const std::string &name) const {
+  auto it = std::find(names.begin(), names.end(), name);
+  if (it == names.end()) {
+    throw std::runtime_error("Column not in stream header: " + name);
+  }
+  return it - names.begin();
+}
+
+double StreamTable::seconds(size_t row) const {
+  std::chrono::high_resolution_clock::duration time_diff(times.at(row) -
+                                                         times.front());
+  return std::chrono::duration<double>(time_diff).count();
+}
+
+size_t StreamTable::nearestRow(int64_t time) const {
+  auto it = std::lower_bound(times.begin(), times.end(), time);
+  if (it == times.end()) {
+    return it == times.begin() ? rows.size() : rows.size() - 1;
+  }
+  if (it != times.begin() && time - *(it - 1) < *it - time) {
+    --it;
+  }
+  return it - times.begin();
+}
+
+StreamTable readStreamTable(const boost::filesystem::path &path,
+                            const std::string &delimiter) {
+  std::vector<boost::filesystem::path> files;
+  if (boost::filesystem::exists(path)) {
+    files.push_back(path);
+  } else {
+    files = findSegments(path);
+  }
+  if (files.empty()) {
+    throw std::runtime_error("No stream file or segments: " + path.string());
+  }
+  StreamTable table;
+  for (const auto &file : files) {
+    if (binary_log::isBinaryLog(file)) {
+      readBinary(file, table);
+    } else {
+      readText(file, delimiter, table);
+    }
+  }
+  return table;
+}
@@ -0,0 +1,174 @@
+#include "aerial_autonomy/log/telemetry_reader.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TelemetryReader::TelemetryReader(std::string name)
+    : size_(0), map_(nullptr), ring_(nullptr), next_(0), lost_records_(0),
+      header_sequence_(0) {
+  std::string shm_name = telemetry::shmName(name);
+  int fd = ::shm_open(shm_name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open shared memory " + shm_name +
+                             ": " + std::strerror(errno));
+  }
+  struct stat status;
+  void *map = MAP_FAILED;
+  if (::fstat(fd, &status) == 0 &&
+      size_t(status.st_size) >= sizeof(telemetry::RingHeader)) {
+    size_ = status.st_size;
+    map = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    throw std::runtime_error("Could not map shared memory " + shm_name);
+  }
+  map_ = static_cast<const char *>(map);
+  ring_ = reinterpret_cast<const telemetry::RingHeader *>(map_);
+  if (std::memcmp(ring_->magic, telemetry::kMagic,
+                  sizeof(telemetry::kMagic)) != 0 ||
+      ring_->version != telemetry::kVersion || ring_->slot_count == 0 ||
+      telemetry::slotOffset(ring_->slot_size, ring_->slot_count) != size_) {
+    ::munmap(const_cast<char *>(map_), size_);
+    throw std::runtime_error("Not a telemetry ring: " + shm_name);
+  }
+  next_ = ring_->head.load(std::memory_order_acquire);
+}
+
+TelemetryReader::~TelemetryReader() {
+  ::munmap(const_cast<char *>(map_), size_);
+}
+
+bool TelemetryReader::binary() const { return ring_->binary != 0; }
+
+bool TelemetryReader::closed() const {
+  return ring_->open.load(std::memory_order_acquire) == 0;
+}
+
+std::vector<std::string> TelemetryReader::names() {
+  updateHeader();
+  if (binary()) {
+    return schema_.names;
+  }
+  std::vector<std::string> names;
+  std::string header = header_.substr(0, header_.find('\n'));
+  std::string delimiter(ring_->delimiter);
+  size_t start = 0;
+  while (!header.empty()) {
+    size_t end = header.find(delimiter, start);
+    if (end == std::string::npos || delimiter.empty()) {
+      names.push_back(header.substr(start));
+      break;
+    }
+    names.push_back(header.substr(start, end - start));
+    start = end + delimiter.size();
+  }
+  return names;
+}
+
+bool TelemetryReader::next(std::string &record) {
+  while (true) {
+    uint64_t head = ring_->head.load(std::memory_order_acquire);
+    if (next_ >= head) {
+      return false;
+    }
+    if (head - next_ > ring_->slot_count) {
+      // Already overwritten
+      lost_records_ += head - ring_->slot_count - next_;
+      next_ = head - ring_->slot_count;
+    }
+    auto slot = reinterpret_cast<const telemetry::Slot *>(
+        map_ + telemetry::slotOffset(ring_->slot_size,
+                                     next_ % ring_->slot_count));
+    uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    uint32_t size = slot->size;
+    if (sequence == 2 * next_ + 2 && size <= ring_->slot_size) {
+      record.assign(reinterpret_cast<const char *>(slot + 1), size);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot->sequence.load(std::memory_order_relaxed) == sequence) {
+        ++next_;
+        return true;
+      }
+    }
+    // The writer lapped the reader while it was copying
+    ++lost_records_;
+    ++next_;
+  }
+}
+
+bool TelemetryReader::next(std::vector<double> &values) {
+  std::string record;
+  if (!next(record)) {
+    return false;
+  }
+  values.clear();
+  if (!binary()) {
+    const char *position = record.c_str();
+    const char *end = position + record.size();
+    size_t delimiter_size = std::strlen(ring_->delimiter);
+    while (position < end && *position != '\n') {
+      char *parsed;
+      values.push_back(std::strtod(position, &parsed));
+      position = std::strstr(parsed, ring_->delimiter);
+      if (position == nullptr || delimiter_size == 0) {
+        break;
+      }
+      position += delimiter_size;
+    }
+    return true;
+  }
+  updateHeader();
+  if (schema_.types.size() * sizeof(int64_t) != record.size()) {
+    // Data point does not match the schema
+    return true;
+  }
+  for (size_t i = 0; i < schema_.types.size(); ++i) {
+    if (schema_.types[i] == binary_log::ColumnType::Int64) {
+      int64_t value;
+      std::memcpy(&value, &record[i * sizeof(value)], sizeof(value));
+      values.push_back(value);
+    } else {
+      double value;
+      std::memcpy(&value, &record[i * sizeof(value)], sizeof(value));
+      values.push_back(value);
+    }
+  }
+  return true;
+}
+
+uint64_t TelemetryReader::lostRecords() const { return lost_records_; }
+
+bool TelemetryReader::updateHeader() {
+  uint64_t sequence = ring_->header_sequence.load(std::memory_order_acquire);
+  if (sequence == header_sequence_) {
+    return true;
+  }
+  uint32_t size = ring_->header_size;
+  if (sequence % 2 == 1 || size > ring_->slot_size) {
+    return false;
+  }
+  std::string header(map_ + telemetry::headerOffset(), size);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (ring_->header_sequence.load(std::memory_order_relaxed) != sequence) {
+    return false;
+  }
+  binary_log::Schema schema;
+  if (binary()) {
+    try {
+      binary_log::decodeSchema(header, schema);
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+  }
+  header_ = header;
+  schema_ = schema;
+  header_sequence_ = sequence;
+  return true;
+}
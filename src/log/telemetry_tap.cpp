@@ -0,0 +1,125 @@
+#include "aerial_autonomy/log/telemetry_tap.h"
+
+#include <glog/logging.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace telemetry {
+
+namespace {
+/**
+* @brief Round a size up to a multiple of 8 bytes
+*/
+size_t align8(size_t size) { return (size + 7) & ~size_t(7); }
+}
+
+size_t headerOffset() { return align8(sizeof(RingHeader)); }
+
+size_t slotOffset(uint32_t slot_size, uint64_t index) {
+  size_t stride = align8(sizeof(Slot) + slot_size);
+  return headerOffset() + align8(slot_size) + index * stride;
+}
+
+std::string shmName(const std::string &name) {
+  return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+}
+
+TelemetryTap::TelemetryTap(std::string name, uint32_t slot_count,
+                           uint32_t slot_size, bool binary,
+                           std::string delimiter)
+    : shm_name_(telemetry::shmName(name)),
+      size_(telemetry::slotOffset(slot_size, slot_count)), map_(nullptr),
+      ring_(nullptr), head_(0) {
+  if (slot_count == 0) {
+    throw std::runtime_error("Telemetry ring needs at least one slot");
+  }
+  // Two taps writing one ring would overwrite each other's records and remove
+  // each other's shared memory object
+  int fd = ::shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0 && errno == EEXIST) {
+    throw std::runtime_error("Telemetry tap name already in use: " +
+                             shm_name_);
+  }
+  if (fd < 0) {
+    throw std::runtime_error("Could not open shared memory " + shm_name_ +
+                             ": " + std::strerror(errno));
+  }
+  void *map = MAP_FAILED;
+  if (::ftruncate(fd, size_) == 0) {
+    map = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  int error = errno;
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    ::shm_unlink(shm_name_.c_str());
+    throw std::runtime_error("Could not map shared memory " + shm_name_ +
+                             ": " + std::strerror(error));
+  }
+  map_ = static_cast<char *>(map);
+  // The new object is zero filled, so all sequence numbers start at 0
+  ring_ = new (map_) telemetry::RingHeader();
+  std::memcpy(ring_->magic, telemetry::kMagic, sizeof(telemetry::kMagic));
+  ring_->version = telemetry::kVersion;
+  ring_->slot_count = slot_count;
+  ring_->slot_size = slot_size;
+  ring_->binary = binary;
+  std::strncpy(ring_->delimiter, delimiter.c_str(),
+               telemetry::kMaxDelimiterSize);
+  ring_->header_size = 0;
+  ring_->head.store(0, std::memory_order_relaxed);
+  ring_->header_sequence.store(0, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < slot_count; ++i) {
+    new (map_ + telemetry::slotOffset(slot_size, i)) telemetry::Slot();
+  }
+  ring_->open.store(1, std::memory_order_release);
+}
+
+TelemetryTap::~TelemetryTap() {
+  ring_->open.store(0, std::memory_order_release);
+  ::munmap(map_, size_);
+  ::shm_unlink(shm_name_.c_str());
+}
+
+bool TelemetryTap::publish(const char *data, size_t size) {
+  if (size > ring_->slot_size) {
+    LOG_EVERY_N(WARNING, 100) << "Record of " << size
+                              << " bytes does not fit in telemetry slot of "
+                              << shm_name_;
+    return false;
+  }
+  auto slot = reinterpret_cast<telemetry::Slot *>(
+      map_ + telemetry::slotOffset(ring_->slot_size,
+                                   head_ % ring_->slot_count));
+  // Readers copying the slot concurrently detect the odd sequence number
+  slot->sequence.store(2 * head_ + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->size = size;
+  std::memcpy(reinterpret_cast<char *>(slot + 1), data, size);
+  slot->sequence.store(2 * head_ + 2, std::memory_order_release);
+  ++head_;
+  ring_->head.store(head_, std::memory_order_release);
+  return true;
+}
+
+bool TelemetryTap::publishHeader(const char *data, size_t size) {
+  if (size > ring_->slot_size) {
+    LOG(WARNING) << "Header of " << size
+                 << " bytes does not fit in telemetry slot of " << shm_name_;
+    return false;
+  }
+  uint64_t sequence = ring_->header_sequence.load(std::memory_order_relaxed);
+  ring_->header_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  ring_->header_size = size;
+  std::memcpy(map_ + telemetry::headerOffset(), data, size);
+  ring_->header_sequence.store(sequence + 2, std::memory_order_release);
+  return true;
+}
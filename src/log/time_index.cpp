@@ -0,0 +1,87 @@
+#include "aerial_autonomy/log/time_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+/**
+* @brief Magic bytes identifying a time index file
+*/
+const char kIndexMagic[4] = {'A', 'A', 'T', 'I'};
+
+/**
+* @brief Version of the index format
+*/
+const uint32_t kIndexVersion = 1;
+}
+
+TimeIndexWriter::TimeIndexWriter(boost::filesystem::path path,
+                                 unsigned interval)
+    : fs_(path.string(), std::ofstream::out | std::ofstream::binary),
+      interval_(interval > 0 ? interval : 1), since_entry_(0) {
+  if (!fs_.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  fs_.write(kIndexMagic, sizeof(kIndexMagic));
+  fs_.write(reinterpret_cast<const char *>(&kIndexVersion),
+            sizeof(kIndexVersion));
+}
+
+void TimeIndexWriter::add(int64_t time, uint64_t offset,
+                          uint32_t data_points) {
+  if (since_entry_ == 0) {
+    fs_.write(reinterpret_cast<const char *>(&time), sizeof(time));
+    fs_.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  }
+  since_entry_ += data_points;
+  if (since_entry_ >= interval_) {
+    since_entry_ = 0;
+  }
+}
+
+void TimeIndexWriter::flush() { fs_.flush(); }
+
+boost::filesystem::path
+TimeIndexWriter::indexPath(const boost::filesystem::path &stream_path) {
+  return boost::filesystem::path(stream_path.string() + ".idx");
+}
+
+TimeIndex::TimeIndex(boost::filesystem::path path) {
+  std::ifstream fs(path.string(), std::ifstream::in | std::ifstream::binary);
+  if (!fs.is_open()) {
+    throw std::runtime_error("Could not open file: " + path.string());
+  }
+  char magic[sizeof(kIndexMagic)];
+  uint32_t version = 0;
+  fs.read(magic, sizeof(magic));
+  fs.read(reinterpret_cast<char *>(&version), sizeof(version));
+  if (!fs || std::memcmp(magic, kIndexMagic, sizeof(kIndexMagic)) != 0) {
+    throw std::runtime_error("Not a time index file: " + path.string());
+  }
+  if (version != kIndexVersion) {
+    throw std::runtime_error("Unsupported time index version: " +
+                             std::to_string(version));
+  }
+  Entry entry;
+  // A partially written last entry is ignored
+  while (fs.read(reinterpret_cast<char *>(&entry.time), sizeof(entry.time)) &&
+         fs.read(reinterpret_cast<char *>(&entry.offset),
+                 sizeof(entry.offset))) {
+    entries_.push_back(entry);
+  }
+}
+
+bool TimeIndex::seek(int64_t time, uint64_t &offset) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), time,
+      [](const Entry &entry, int64_t t) { return entry.time < t; });
+  if (it == entries_.begin()) {
+    return false;
+  }
+  offset = std::prev(it)->offset;
+  return true;
+}
+
+size_t TimeIndex::size() const { return entries_.size(); }
@@ -0,0 +1,215 @@
+#include "aerial_autonomy/log/trace.h"
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <unistd.h>
+
+struct Tracer::Ring {
+  /**
+  * @brief A recorded span. Fields are atomic since export reads them while
+  * the owning thread may overwrite them
+  */
+  struct Event {
+    std::atomic<const char *> name; ///< Span name
+    std::atomic<int64_t> start;     ///< Start time
+    std::atomic<int64_t> end;       ///< End time
+  };
+
+  /**
+  * @brief Constructor
+  * @param capacity Number of events in the ring
+  * @param id Thread id in exported traces
+  */
+  Ring(size_t capacity, int id)
+      : events(new Event[capacity]), capacity(capacity), id(id), writing(0),
+        head(0), retired(false) {}
+
+  std::unique_ptr<Event[]> events; ///< Ring storage
+  const size_t capacity;           ///< Number of events in the ring
+  const int id;                    ///< Thread id in exported traces
+  /**
+  * @brief Number of events whose write has started. Published before the
+  * event is written so that export can detect overwritten events
+  */
+  std::atomic<uint64_t> writing;
+  std::atomic<uint64_t> head; ///< Number of events written
+  std::atomic<bool> retired;  ///< True once the thread has exited
+  std::string thread_name;    ///< Thread name, guarded by the tracer mutex
+};
+
+struct Tracer::ThreadState {
+  /**
+  * @brief Destructor marks the ring of the exiting thread as retired
+  */
+  ~ThreadState() {
+    if (ring) {
+      ring->retired = true;
+    }
+  }
+
+  std::shared_ptr<Ring> ring; ///< Ring of the thread, created lazily
+  std::string name;           ///< Name set before the ring was created
+};
+
+thread_local Tracer::ThreadState Tracer::thread_state_;
+
+namespace {
+/**
+* @brief Write a string as a quoted JSON string
+*/
+void writeJsonString(std::ostream &os, const std::string &value) {
+  os << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}
+
+Tracer &Tracer::instance() {
+  static auto tracer = new Tracer();
+  return *tracer;
+}
+
+Tracer::Tracer()
+    : enabled_(false), origin_(0), events_per_thread_(16384),
+      next_thread_id_(1) {}
+
+void Tracer::enable(size_t events_per_thread) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_per_thread_ = std::max<size_t>(events_per_thread, 1);
+  }
+  int64_t unset = 0;
+  origin_.compare_exchange_strong(unset, now());
+  enabled_ = true;
+}
+
+void Tracer::disable() { enabled_ = false; }
+
+const char *Tracer::intern(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return names_.insert(name).first->c_str();
+}
+
+void Tracer::setThreadName(const std::string &name) {
+  thread_state_.name = name;
+  if (thread_state_.ring) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_state_.ring->thread_name = name;
+  }
+}
+
+Tracer::Ring &Tracer::threadRing() {
+  if (!thread_state_.ring) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Drop the oldest rings of exited threads, e.g. of restarted timers
+    size_t retired = std::count_if(
+        rings_.begin(), rings_.end(),
+        [](const std::shared_ptr<Ring> &ring) { return ring->retired.load(); });
+    for (auto it = rings_.begin();
+         it != rings_.end() && retired >= kMaxRetiredRings;) {
+      if ((*it)->retired) {
+        it = rings_.erase(it);
+        --retired;
+      } else {
+        ++it;
+      }
+    }
+    auto ring = std::make_shared<Ring>(events_per_thread_, next_thread_id_++);
+    ring->thread_name = thread_state_.name.empty()
+                            ? "thread " + std::to_string(ring->id)
+                            : thread_state_.name;
+    rings_.push_back(ring);
+    thread_state_.ring = ring;
+  }
+  return *thread_state_.ring;
+}
+
+void Tracer::record(const char *name, int64_t start, int64_t end) {
+  if (!enabled()) {
+    return;
+  }
+  Ring &ring = threadRing();
+  // Only this thread writes to the ring
+  uint64_t index = ring.head.load(std::memory_order_relaxed);
+  ring.writing.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Ring::Event &event = ring.events[index % ring.capacity];
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(start, std::memory_order_relaxed);
+  event.end.store(end, std::memory_order_relaxed);
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+size_t Tracer::writeChromeTrace(std::ostream &os) {
+  std::vector<std::pair<std::shared_ptr<Ring>, std::string>> rings;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &ring : rings_) {
+      rings.emplace_back(ring, ring->thread_name);
+    }
+  }
+  const int pid = ::getpid();
+  const int64_t origin = origin_.load();
+  size_t span_count = 0;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &entry : rings) {
+    const Ring &ring = *entry.first;
+    os << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\","
+       << "\"pid\":" << pid << ",\"tid\":" << ring.id
+       << ",\"args\":{\"name\":";
+    writeJsonString(os, entry.second);
+    os << "}}";
+    first = false;
+    // Copy the ring while its thread keeps recording
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t begin = head > ring.capacity ? head - ring.capacity : 0;
+    std::vector<std::tuple<const char *, int64_t, int64_t>> events;
+    events.reserve(head - begin);
+    for (uint64_t i = begin; i < head; ++i) {
+      const Ring::Event &event = ring.events[i % ring.capacity];
+      events.emplace_back(event.name.load(std::memory_order_relaxed),
+                          event.start.load(std::memory_order_relaxed),
+                          event.end.load(std::memory_order_relaxed));
+    }
+    // Events whose slot was rewritten during the copy may be torn
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t writing = ring.writing.load(std::memory_order_relaxed);
+    uint64_t valid = writing > ring.capacity ? writing - ring.capacity : 0;
+    os << std::fixed << std::setprecision(3);
+    for (uint64_t i = std::max(begin, valid); i < head; ++i) {
+      const auto &event = events[i - begin];
+      os << ",\n{\"name\":";
+      writeJsonString(os, std::get<0>(event));
+      os << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << ring.id
+         << ",\"ts\":" << (std::get<1>(event) - origin) / 1e3
+         << ",\"dur\":" << (std::get<2>(event) - std::get<1>(event)) / 1e3
+         << "}";
+      ++span_count;
+    }
+  }
+  os << "\n]}\n";
+  return span_count;
+}
+
+size_t Tracer::writeChromeTrace(const boost::filesystem::path &file) {
+  boost::filesystem::ofstream os(file);
+  if (!os) {
+    throw std::runtime_error("Could not open trace file: " + file.string());
+  }
+  return writeChromeTrace(os);
+}
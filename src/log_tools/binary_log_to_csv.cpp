@@ -0,0 +1,46 @@
+#include <aerial_autonomy/log/binary_log_format.h>
+
+#include <glog/logging.h>
+
+#include <fstream>
+#include <iostream>
+
+/**
+* @brief Convert a binary or compressed DataStream file into the delimiter
+* separated text written by a text DataStream so that it can be loaded by the
+* analysis scripts
+*
+* Usage: binary_log_to_csv input_file [output_file]
+* The output file defaults to input_file.csv
+*/
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " input_file [output_file]"
+              << std::endl;
+    return 1;
+  }
+  std::string input_file(argv[1]);
+  std::string output_file = argc == 3 ? argv[2] : input_file + ".csv";
+  try {
+    binary_log::BinaryLogReader reader(input_file);
+    std::ofstream out(output_file);
+    if (!out.is_open()) {
+      LOG(ERROR) << "Could not open file: " << output_file;
+      return 1;
+    }
+    if (!reader.schema().names.empty()) {
+      out << reader.formatHeader() << std::endl;
+    }
+    unsigned long count = 0;
+    while (reader.next()) {
+      out << reader.formatRecord() << std::endl;
+      ++count;
+    }
+    LOG(INFO) << "Wrote " << count << " data points to " << output_file;
+  } catch (const std::runtime_error &e) {
+    LOG(ERROR) << e.what();
+    return 1;
+  }
+  return 0;
+}
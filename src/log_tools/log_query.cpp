@@ -0,0 +1,84 @@
+#include <aerial_autonomy/log/stream_query.h>
+
+#include <glog/logging.h>
+
+#include <getopt.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+* @brief Print usage of log_query
+* @param program Program name
+*/
+void printUsage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " [-s start_time] [-e end_time] [-c column1,column2,...]"
+               " [-d delimiter] [-o output_file] stream_file"
+            << std::endl;
+}
+
+/**
+* @brief Extract a time window and a subset of columns from a DataStream file
+* (text, binary or compressed) as delimiter separated text. Uses the time index
+* written next to the stream file to seek to the start of the window.
+*
+* Times are in the units of the #Time column. The columns are header names and
+* the delimiter is the one of text stream files (default ","). The output
+* defaults to stdout.
+*/
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  StreamQuery query;
+  std::string output_file;
+  int option;
+  while ((option = getopt(argc, argv, "s:e:c:d:o:")) != -1) {
+    switch (option) {
+    case 's':
+      query.start = std::stoll(optarg);
+      break;
+    case 'e':
+      query.end = std::stoll(optarg);
+      break;
+    case 'c': {
+      std::stringstream ss(optarg);
+      std::string column;
+      while (std::getline(ss, column, ',')) {
+        query.columns.push_back(column);
+      }
+      break;
+    }
+    case 'd':
+      query.delimiter = optarg;
+      break;
+    case 'o':
+      output_file = optarg;
+      break;
+    default:
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (optind + 1 != argc) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  try {
+    std::ofstream file;
+    if (!output_file.empty()) {
+      file.open(output_file);
+      if (!file.is_open()) {
+        LOG(ERROR) << "Could not open file: " << output_file;
+        return 1;
+      }
+    }
+    std::ostream &out = output_file.empty() ? std::cout : file;
+    uint64_t count = queryStream(argv[optind], query, out);
+    LOG(INFO) << "Extracted " << count << " data points";
+  } catch (const std::exception &e) {
+    LOG(ERROR) << e.what();
+    return 1;
+  }
+  return 0;
+}
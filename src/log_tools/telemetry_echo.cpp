@@ -0,0 +1,50 @@
+#include <aerial_autonomy/log/telemetry_reader.h>
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/**
+* @brief Print the data points of a live DataStream telemetry tap as comma
+* separated values until the tap is closed
+*
+* Usage: telemetry_echo tap_name
+*/
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " tap_name" << std::endl;
+    return 1;
+  }
+  try {
+    TelemetryReader reader(argv[1]);
+    bool header_printed = false;
+    std::vector<double> values;
+    while (!reader.closed()) {
+      if (!reader.next(values)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      if (!header_printed) {
+        std::vector<std::string> names = reader.names();
+        for (size_t i = 0; i < names.size(); ++i) {
+          std::cout << (i > 0 ? "," : "") << names[i];
+        }
+        std::cout << std::endl;
+        header_printed = true;
+      }
+      for (size_t i = 0; i < values.size(); ++i) {
+        std::cout << (i > 0 ? "," : "") << values[i];
+      }
+      std::cout << std::endl;
+    }
+    LOG(INFO) << "Telemetry tap closed. Lost " << reader.lostRecords()
+              << " data points";
+  } catch (const std::runtime_error &e) {
+    LOG(ERROR) << e.what();
+    return 1;
+  }
+  return 0;
+}
@@ -12,14 +12,15 @@ OdomFromPoseSensor::OdomFromPoseSensor(OdomSensorConfig config)
 
 std::pair<tf::StampedTransform, tf::Vector3>
 OdomFromPoseSensor::getSensorData() {
-  return std::make_pair(tf::StampedTransform(pose_), tf::Vector3(velocity_));
+  return latestSample().data;
 }
 
 void OdomFromPoseSensor::poseCallback(
     const geometry_msgs::TransformStampedConstPtr &pose_input) {
   tf::StampedTransform pose_out;
   tf::transformStampedMsgToTF(*pose_input, pose_out);
-  tf::StampedTransform previous_pose = pose_;
+  tf::StampedTransform previous_pose = latestSample().data.first;
+  tf::Vector3 velocity(0, 0, 0);
   // Velocity
   if (pose_initialized_) {
     double tdiff = (pose_out.stamp_ - previous_pose.stamp_).toSec();
@@ -29,18 +30,16 @@ void OdomFromPoseSensor::poseCallback(
     if (tdiff >= 0.05) {
       LOG(WARNING) << "Tdiff too big: " << tdiff;
     }
-    tf::Vector3 velocity =
-        (pose_out.getOrigin() - previous_pose.getOrigin()) / tdiff;
-    velocity_ = velocity_filter_.addAndFilter(velocity);
+    velocity = velocity_filter_.addAndFilter(
+        (pose_out.getOrigin() - previous_pose.getOrigin()) / tdiff);
   } else {
-    velocity_ = tf::Vector3(0, 0, 0);
     pose_initialized_ = true;
   }
-  pose_ = pose_out;
+  publishSample(std::make_pair(pose_out, velocity));
 }
 
 SensorStatus OdomFromPoseSensor::getSensorStatus() {
-  tf::StampedTransform pose = pose_;
+  tf::StampedTransform pose = latestSample().data.first;
   ros::Duration duration_since_last_message = (ros::Time::now() - pose.stamp_);
   if (duration_since_last_message.toSec() >
       config_.ros_sensor_config().timeout()) {
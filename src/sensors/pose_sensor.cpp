@@ -8,18 +8,18 @@ PoseSensor::PoseSensor(std::string pose_topic, ros::Duration validity_buffer,
       validity_buffer_(validity_buffer) {}
 
 tf::StampedTransform PoseSensor::getSensorData() {
-  return tf::StampedTransform(pose_);
+  return latestSample().data;
 }
 
 void PoseSensor::poseCallback(
     const geometry_msgs::TransformStampedConstPtr &pose_input) {
   tf::StampedTransform pose_out;
   tf::transformStampedMsgToTF(*pose_input, pose_out);
-  pose_ = pose_out;
+  publishSample(pose_out);
 }
 
 SensorStatus PoseSensor::getSensorStatus() {
-  tf::StampedTransform pose = pose_;
+  tf::StampedTransform pose = latestSample().data;
   ros::Duration duration_since_last_message = (ros::Time::now() - pose.stamp_);
   if (duration_since_last_message > validity_buffer_) {
     return SensorStatus::INVALID;
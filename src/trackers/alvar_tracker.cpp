@@ -25,7 +25,7 @@ void AlvarTracker::markerCallback(
   if (marker_msg.markers.size() == 0)
     return;
   last_valid_time_ = ros::Time::now();
-  last_tracking_time_ = std::chrono::high_resolution_clock::now();
+  last_tracking_time_ = Clock::instance().now();
   std::unordered_map<uint32_t, tf::Transform> object_poses;
   for (unsigned int i = 0; i < marker_msg.markers.size(); i++) {
     auto marker_pose = marker_msg.markers[i].pose.pose;
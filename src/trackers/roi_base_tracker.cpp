@@ -16,7 +16,7 @@ RoiBaseTracker::getTrackingTime() {
 
 void RoiBaseTracker::roiCallback(const sensor_msgs::RegionOfInterest &roi_msg) {
   last_roi_update_time_ = ros::Time::now();
-  last_tracking_time_ = std::chrono::high_resolution_clock::now();
+  last_tracking_time_ = Clock::instance().now();
   roi_rect_ = roi_msg;
 }
 
@@ -51,6 +51,53 @@ TEST_F(AsyncTimerTests, Timing) {
   ASSERT_LE(this->x, 76);
 }
 
+TEST_F(AsyncTimerTests, SharedExecutor) {
+  auto executor = std::make_shared<TimerExecutor>(1);
+  AsyncTimer timer1(std::bind(&AsyncTimerTests::counterFunction, this),
+                    std::chrono::milliseconds(20), "timer1", executor);
+  AsyncTimer timer2(std::bind(&AsyncTimerTests::counterFunction, this),
+                    std::chrono::milliseconds(20), "timer2", executor,
+                    TimerPriority::High);
+  timer1.start();
+  timer2.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  timer1.stop();
+  timer2.stop();
+  ASSERT_GE(this->x, 98);
+  ASSERT_LE(this->x, 102);
+}
+
+TEST_F(AsyncTimerTests, Statistics) {
+  AsyncTimer timer(
+      [] { std::this_thread::sleep_for(std::chrono::milliseconds(15)); },
+      std::chrono::milliseconds(10), "overrun_timer");
+  timer.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  timer.stop();
+  TimerStatistics::Summary statistics = timer.statistics();
+  ASSERT_EQ(statistics.name, "overrun_timer");
+  ASSERT_GT(statistics.ticks, 5u);
+  ASSERT_EQ(statistics.overruns, statistics.ticks);
+  ASSERT_GE(statistics.execution_p50, 0.015);
+  // Statistics are kept across restarts
+  timer.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  timer.stop();
+  ASSERT_GT(timer.statistics().ticks, statistics.ticks);
+}
+
+TEST_F(AsyncTimerTests, Trigger) {
+  AsyncTimer timer(std::bind(&AsyncTimerTests::counterFunction, this),
+                   std::chrono::seconds(10));
+  // Ignored while stopped
+  timer.trigger(std::chrono::milliseconds(0));
+  timer.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  timer.trigger(std::chrono::milliseconds(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(2, this->x);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "aerial_autonomy/common/atomic.h"
 
@@ -65,6 +68,113 @@ TEST_F(AtomicThreadTest, ThreadSafe) {
   t2.join();
 }
 
+/**
+* @brief Trivially copyable value whose fields are always written equal
+*/
+struct Sample {
+  Sample() : a(0), b(0), c(0), d(0) {}
+  Sample(int64_t value) : a(value), b(value), c(value), d(value) {}
+  int64_t a, b, c, d;
+  bool consistent() const { return a == b && b == c && c == d; }
+};
+
+/**
+* @brief Write values with equal fields while several threads read them
+* @param a Value to hammer
+* @param make Create a value from a counter
+* @param consistent Check that a value read is not torn
+* @return True if every value read was consistent
+*/
+template <class AtomicT, class MakeT, class CheckT>
+bool concurrentReadsConsistent(AtomicT &a, MakeT make, CheckT consistent) {
+  std::atomic<bool> done(false);
+  std::atomic<bool> ok(true);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        if (!consistent(a.get())) {
+          ok = false;
+        }
+      }
+    });
+  }
+  for (int i = 1; i <= 100000; ++i) {
+    a.set(make(i));
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  return ok;
+}
+
+TEST(AtomicTests, SeqLockSetGet) {
+  Atomic<Sample, atomic_policy::SeqLock> a;
+  ASSERT_EQ(a.get().a, 0);
+  a = Sample(3);
+  ASSERT_TRUE(a.get().consistent());
+  ASSERT_EQ(a.get().d, 3);
+  Atomic<Sample, atomic_policy::SeqLock> b(a);
+  ASSERT_EQ(b.get().a, 3);
+  Atomic<double, atomic_policy::SeqLock> c(2.5);
+  double value = c;
+  ASSERT_EQ(value, 2.5);
+}
+
+TEST(AtomicTests, SeqLockConcurrent) {
+  Atomic<Sample, atomic_policy::SeqLock> a;
+  ASSERT_TRUE(concurrentReadsConsistent(
+      a, [](int i) { return Sample(i); },
+      [](const Sample &sample) { return sample.consistent(); }));
+  ASSERT_EQ(a.get().a, 100000);
+}
+
+TEST(AtomicTests, TripleBufferSetGet) {
+  Atomic<std::string, atomic_policy::TripleBuffer> a;
+  ASSERT_EQ(a.get(), "");
+  for (int i = 0; i < 5; ++i) {
+    a = std::to_string(i);
+    ASSERT_EQ(a.get(), std::to_string(i));
+  }
+  Atomic<std::string, atomic_policy::TripleBuffer> b(a);
+  ASSERT_EQ(b.get(), "4");
+  b = Atomic<std::string, atomic_policy::TripleBuffer>("copied");
+  ASSERT_EQ(b.get(), "copied");
+}
+
+TEST(AtomicTests, TripleBufferConcurrent) {
+  Atomic<std::vector<int>, atomic_policy::TripleBuffer> a;
+  ASSERT_TRUE(concurrentReadsConsistent(
+      a, [](int i) { return std::vector<int>(i % 64 + 1, i); },
+      [](const std::vector<int> &values) {
+        for (int value : values) {
+          if (value != values[0] || int(values.size()) != value % 64 + 1) {
+            return false;
+          }
+        }
+        return true;
+      }));
+  ASSERT_EQ(a.get(), std::vector<int>(100000 % 64 + 1, 100000));
+}
+
+#ifndef AERIAL_AUTONOMY_NO_LOCK_PROFILING
+TEST(AtomicTests, LockName) {
+  Atomic<int> a(LockName("atomic_tests_a"));
+  Atomic<int, atomic_policy::SeqLock> b(1, LockName("atomic_tests_b"));
+  LockProfiler::instance().enable();
+  a = 1;
+  // Copies keep the lock name
+  Atomic<int> c(a);
+  ASSERT_EQ(c.get(), 1);
+  b = 2;
+  LockProfiler::instance().disable();
+  auto &profiler = LockProfiler::instance();
+  ASSERT_EQ(profiler.statistics("atomic_tests_a")->summary().acquisitions, 4u);
+  ASSERT_EQ(profiler.statistics("atomic_tests_b")->summary().acquisitions, 1u);
+}
+#endif
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/async_timer.h>
+#include <aerial_autonomy/common/clock.h>
+
+#include <string>
+#include <vector>
+
+/**
+* @brief Installs a simulated process clock for the duration of a test
+*/
+class ClockTests : public ::testing::Test {
+public:
+  ClockTests() : clock_(std::make_shared<SimulatedClock>()) {
+    Clock::setInstance(clock_);
+  }
+
+  ~ClockTests() { Clock::setInstance(nullptr); }
+
+protected:
+  std::shared_ptr<SimulatedClock> clock_; ///< Process clock
+};
+
+TEST(SystemClockTests, Default) {
+  ASSERT_NE(dynamic_cast<SystemClock *>(&Clock::instance()), nullptr);
+  auto start = Clock::instance().now();
+  ASSERT_GE(Clock::instance().now(), start);
+}
+
+TEST_F(ClockTests, Advance) {
+  ASSERT_EQ(&Clock::instance(), clock_.get());
+  auto start = Clock::instance().now();
+  ASSERT_EQ(Clock::instance().now(), start);
+  clock_->advance(std::chrono::milliseconds(250));
+  ASSERT_EQ(Clock::instance().now() - start, std::chrono::milliseconds(250));
+  // Moving backwards is ignored
+  clock_->advanceTo(start);
+  ASSERT_EQ(Clock::instance().now() - start, std::chrono::milliseconds(250));
+}
+
+TEST_F(ClockTests, TimerOrder) {
+  std::vector<std::string> calls;
+  auto start = clock_->now();
+  std::vector<Clock::duration> call_times;
+  clock_->addTimer(
+      [&] {
+        calls.push_back("slow");
+        call_times.push_back(clock_->now() - start);
+      },
+      std::chrono::milliseconds(30));
+  clock_->addTimer(
+      [&] {
+        calls.push_back("fast");
+        call_times.push_back(clock_->now() - start);
+      },
+      std::chrono::milliseconds(20));
+  clock_->advance(std::chrono::milliseconds(60));
+  ASSERT_EQ(calls, std::vector<std::string>({"slow", "fast", "fast", "slow",
+                                             "fast", "slow", "fast"}));
+  std::vector<Clock::duration> expected_times;
+  for (int ms : {0, 0, 20, 30, 40, 60, 60}) {
+    expected_times.push_back(std::chrono::milliseconds(ms));
+  }
+  ASSERT_EQ(call_times, expected_times);
+}
+
+TEST_F(ClockTests, RemoveTimerFromCall) {
+  int calls = 0;
+  SimulatedClock::TimerId id = clock_->addTimer(
+      [&] {
+        ++calls;
+        clock_->removeTimer(id);
+      },
+      std::chrono::milliseconds(10));
+  clock_->advance(std::chrono::milliseconds(100));
+  ASSERT_EQ(calls, 1);
+}
+
+TEST_F(ClockTests, SetPeriod) {
+  std::vector<Clock::duration> call_times;
+  auto start = clock_->now();
+  SimulatedClock::TimerId id = clock_->addTimer(
+      [&] {
+        call_times.push_back(clock_->now() - start);
+        if (call_times.size() == 2) {
+          clock_->setPeriod(id, std::chrono::milliseconds(50));
+        }
+      },
+      std::chrono::milliseconds(20));
+  clock_->advance(std::chrono::milliseconds(30));
+  // The next call is one new period after the previous one
+  clock_->setPeriod(id, std::chrono::milliseconds(40));
+  clock_->advance(std::chrono::milliseconds(100));
+  std::vector<Clock::duration> expected_times;
+  for (int ms : {0, 20, 60, 100}) {
+    expected_times.push_back(std::chrono::milliseconds(ms));
+  }
+  ASSERT_EQ(call_times, expected_times);
+}
+
+TEST_F(ClockTests, AsyncTimer) {
+  int calls = 0;
+  AsyncTimer timer([&calls] { ++calls; }, std::chrono::milliseconds(20));
+  timer.start();
+  clock_->advance(std::chrono::seconds(10));
+  // Includes the call at the start time
+  ASSERT_EQ(calls, 501);
+  timer.stop();
+  clock_->advance(std::chrono::seconds(1));
+  ASSERT_EQ(calls, 501);
+  timer.setDuration(std::chrono::milliseconds(100));
+  timer.start();
+  clock_->advance(std::chrono::seconds(1));
+  ASSERT_EQ(calls, 512);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
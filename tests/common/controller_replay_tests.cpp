@@ -0,0 +1,144 @@
+#include "aerial_autonomy/common/controller_replay.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+/**
+* @brief Proportional controller whose config is its gain. Fails for negative
+* sensor data
+*/
+class GainController : public Controller<double, double, double> {
+public:
+  GainController(double gain) : gain_(gain) {}
+
+protected:
+  bool runImplementation(double sensor_data, const double &goal,
+                         double &control) {
+    control = gain_ * (goal - sensor_data);
+    return sensor_data >= 0;
+  }
+
+  ControllerStatus isConvergedImplementation(double, const double &) {
+    return ControllerStatus::Active;
+  }
+
+private:
+  double gain_;
+};
+
+class ControllerReplayTests : public ::testing::Test {
+public:
+  using Replay = ControllerReplay<double, double, double, double>;
+
+  ControllerReplayTests() {
+    trace_.goal = 1.0;
+    for (int i = 0; i < 50; ++i) {
+      trace_.sensor_data.push_back(0.02 * i);
+      // Recorded with a gain of 2
+      trace_.recorded_controls.push_back(
+          Eigen::VectorXd::Constant(1, 2.0 * (1.0 - 0.02 * i)));
+    }
+  }
+
+  static Replay::Factory factory() {
+    return [](const double &gain) {
+      if (gain == 0) {
+        throw std::runtime_error("Zero gain");
+      }
+      return std::unique_ptr<Replay::ControllerT>(new GainController(gain));
+    };
+  }
+
+  static Eigen::VectorXd toVector(const double &control) {
+    return Eigen::VectorXd::Constant(1, control);
+  }
+
+protected:
+  ReplayTrace<double, double> trace_;
+};
+
+TEST_F(ControllerReplayTests, RecordedConfigHasNoDeviation) {
+  Replay replay(trace_, factory(), toVector);
+  auto results = replay.replay({{"recorded", 2.0}});
+  ASSERT_EQ(results.size(), 1u);
+  ASSERT_EQ(results[0].name, "recorded");
+  ASSERT_EQ(results[0].steps, 50u);
+  ASSERT_EQ(results[0].failures, 0u);
+  ASSERT_EQ(results[0].rms_deviation.size(), 1);
+  ASSERT_NEAR(results[0].rms_deviation(0), 0, 1e-12);
+  ASSERT_GE(results[0].max_solve_time, results[0].mean_solve_time);
+  ASSERT_TRUE(results[0].error.empty());
+}
+
+TEST_F(ControllerReplayTests, DeviationFromRecordedControls) {
+  Replay replay(trace_, factory(), toVector);
+  auto results = replay.replay({{"recorded", 2.0}, {"higher", 3.0}});
+  // Deviation is the error times the gain difference
+  double squared_error = 0;
+  for (double sensor_data : trace_.sensor_data) {
+    squared_error += (1.0 - sensor_data) * (1.0 - sensor_data);
+  }
+  ASSERT_NEAR(results[1].rms_deviation(0), std::sqrt(squared_error / 50),
+              1e-9);
+}
+
+TEST_F(ControllerReplayTests, DeviationFromBaseline) {
+  trace_.recorded_controls.clear();
+  Replay replay(trace_, factory(), toVector);
+  auto results =
+      replay.replay({{"baseline", 3.0}, {"same", 3.0}, {"lower", 2.0}});
+  ASSERT_NEAR(results[0].rms_deviation(0), 0, 1e-12);
+  ASSERT_NEAR(results[1].rms_deviation(0), 0, 1e-12);
+  ASSERT_GT(results[2].rms_deviation(0), 0.1);
+}
+
+TEST_F(ControllerReplayTests, ParallelMatchesSerial) {
+  std::vector<Replay::NamedConfig> configs;
+  for (int i = 1; i <= 16; ++i) {
+    configs.emplace_back(std::to_string(i), 0.5 * i);
+  }
+  Replay replay(trace_, factory(), toVector);
+  auto serial = replay.replay(configs, 1);
+  auto parallel = replay.replay(configs, 4);
+  ASSERT_EQ(serial.size(), configs.size());
+  ASSERT_EQ(parallel.size(), configs.size());
+  for (size_t i = 0; i < configs.size(); ++i) {
+    ASSERT_EQ(parallel[i].name, configs[i].first);
+    ASSERT_EQ(parallel[i].steps, 50u);
+    ASSERT_DOUBLE_EQ(parallel[i].rms_deviation(0),
+                     serial[i].rms_deviation(0));
+  }
+}
+
+TEST_F(ControllerReplayTests, CountFailures) {
+  trace_.sensor_data[3] = -1;
+  trace_.sensor_data[7] = -1;
+  Replay replay(trace_, factory(), toVector);
+  auto results = replay.replay({{"recorded", 2.0}});
+  ASSERT_EQ(results[0].steps, 50u);
+  ASSERT_EQ(results[0].failures, 2u);
+}
+
+TEST_F(ControllerReplayTests, ReportErrors) {
+  Replay replay(trace_, factory(), toVector);
+  auto results = replay.replay({{"invalid", 0.0}, {"recorded", 2.0}}, 2);
+  ASSERT_EQ(results[0].error, "Zero gain");
+  ASSERT_EQ(results[0].steps, 0u);
+  ASSERT_TRUE(results[1].error.empty());
+  ASSERT_EQ(results[1].steps, 50u);
+}
+
+TEST_F(ControllerReplayTests, RecordControls) {
+  Replay replay(trace_, factory(), toVector);
+  std::vector<Eigen::VectorXd> controls;
+  auto result = replay.replay({"recorded", 2.0}, {}, &controls);
+  ASSERT_EQ(controls.size(), 50u);
+  ASSERT_DOUBLE_EQ(controls[0](0), 2.0);
+  ASSERT_EQ(result.rms_deviation.size(), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/event_dispatcher.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(EventDispatcherTests, Order) {
+  std::vector<int> order;
+  std::atomic<bool> done(false);
+  EventDispatcher dispatcher;
+  for (int i = 0; i < 10; ++i) {
+    dispatcher.post("item", [&order, i] { order.push_back(i); });
+  }
+  dispatcher.post("done", [&done] { done = true; });
+  while (!done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(order, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(EventDispatcherTests, PostDoesNotWait) {
+  std::atomic<int> handled(0);
+  EventDispatcher dispatcher;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 5; ++i) {
+    dispatcher.post("slow", [&handled] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      handled++;
+    });
+  }
+  ASSERT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_EQ(handled, 5);
+}
+
+TEST(EventDispatcherTests, ConcurrentProducers) {
+  std::atomic<int> handled(0);
+  {
+    EventDispatcher dispatcher;
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < 4; ++producer) {
+      producers.emplace_back([&dispatcher, &handled] {
+        for (int i = 0; i < 1000; ++i) {
+          dispatcher.post("count", [&handled] { handled++; });
+          // Let the dispatch thread go back to sleep now and then
+          if (i % 100 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        }
+      });
+    }
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handled < 4000 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  ASSERT_EQ(handled, 4000);
+}
+
+TEST(EventDispatcherTests, Statistics) {
+  EventDispatcher dispatcher;
+  dispatcher.post("slow", [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  });
+  dispatcher.post("fast", [] {});
+  dispatcher.post("fast", [] {});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto statistics = dispatcher.statistics();
+  ASSERT_EQ(statistics.size(), 2u);
+  ASSERT_EQ(statistics[0].name, "fast");
+  ASSERT_EQ(statistics[0].count, 2u);
+  // The fast items waited for the slow one
+  ASSERT_GE(statistics[0].latency_p50, 0.01);
+  ASSERT_EQ(statistics[1].name, "slow");
+  ASSERT_EQ(statistics[1].count, 1u);
+  ASSERT_GE(statistics[1].latency_max, 0.01);
+  ASSERT_LE(statistics[1].latency_p50, statistics[1].latency_max);
+}
+
+TEST(EventDispatcherTests, Stop) {
+  std::atomic<int> handled(0);
+  EventDispatcher dispatcher;
+  dispatcher.post("slow", [&handled] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    handled++;
+  });
+  dispatcher.post("pending", [&handled] { handled++; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  // Waits for the running item and drops the pending one
+  dispatcher.stop();
+  ASSERT_EQ(handled, 1);
+  dispatcher.post("after_stop", [&handled] { handled++; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_EQ(handled, 1);
+}
+
+TEST(EventDispatcherTests, StopWithoutPost) {
+  EventDispatcher dispatcher;
+  ASSERT_NO_THROW(dispatcher.stop());
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/latency_histogram.h>
+
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogramTests, Empty) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(histogram.count(), 0u);
+  ASSERT_EQ(histogram.max(), 0);
+  ASSERT_EQ(histogram.percentile(0.5), 0);
+}
+
+TEST(LatencyHistogramTests, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int i = 0; i < 8; ++i) {
+    histogram.record(i);
+  }
+  ASSERT_EQ(histogram.count(), 8u);
+  ASSERT_EQ(histogram.max(), 7);
+  ASSERT_EQ(histogram.percentile(0.5), 3);
+  ASSERT_EQ(histogram.percentile(1.0), 7);
+}
+
+TEST(LatencyHistogramTests, NegativeValues) {
+  LatencyHistogram histogram;
+  histogram.record(-5);
+  ASSERT_EQ(histogram.count(), 1u);
+  ASSERT_EQ(histogram.percentile(0.5), 0);
+}
+
+TEST(LatencyHistogramTests, RelativeError) {
+  LatencyHistogram histogram;
+  // 1 us to 1000 us
+  for (int64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i * 1000);
+  }
+  ASSERT_EQ(histogram.max(), 1000000);
+  int64_t p50 = histogram.percentile(0.5);
+  ASSERT_GE(p50, 500000);
+  ASSERT_LE(p50, 500000 * 1.125);
+  int64_t p99 = histogram.percentile(0.99);
+  ASSERT_GE(p99, 990000);
+  // Never above the max
+  ASSERT_LE(p99, 1000000);
+}
+
+TEST(LatencyHistogramTests, LargeValues) {
+  LatencyHistogram histogram;
+  histogram.record(INT64_MAX);
+  ASSERT_EQ(histogram.max(), INT64_MAX);
+  ASSERT_EQ(histogram.percentile(0.5), INT64_MAX);
+}
+
+TEST(LatencyHistogramTests, ConcurrentRecording) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram, t] {
+      for (int i = 0; i < 10000; ++i) {
+        histogram.record(t * 10000 + i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(histogram.count(), 40000u);
+  ASSERT_EQ(histogram.max(), 39999);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
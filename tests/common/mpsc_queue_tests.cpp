@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/mpsc_queue.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MPSCQueueTests, PushPop) {
+  MPSCQueue<int> queue;
+  int value;
+  ASSERT_TRUE(queue.empty());
+  ASSERT_FALSE(queue.pop(value));
+  queue.push(1);
+  queue.push(2);
+  ASSERT_FALSE(queue.empty());
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(value, 1);
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(value, 2);
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(MPSCQueueTests, DestroyWithValues) {
+  auto value = std::make_shared<int>(1);
+  {
+    MPSCQueue<std::shared_ptr<int>> queue;
+    queue.push(value);
+    queue.push(value);
+    ASSERT_EQ(value.use_count(), 3);
+  }
+  ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(MPSCQueueTests, ConcurrentProducers) {
+  const int producer_count = 4;
+  const int values_per_producer = 100000;
+  MPSCQueue<std::pair<int, int>> queue;
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < producer_count; ++producer) {
+    producers.emplace_back([&queue, producer, values_per_producer] {
+      for (int i = 0; i < values_per_producer; ++i) {
+        queue.push(std::make_pair(producer, i));
+      }
+    });
+  }
+  // Values of each producer arrive in order
+  std::vector<int> next(producer_count, 0);
+  int popped = 0;
+  std::pair<int, int> value;
+  while (popped < producer_count * values_per_producer) {
+    if (queue.pop(value)) {
+      ASSERT_EQ(value.second, next[value.first]++);
+      ++popped;
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/phase_aligned_pipeline.h>
+
+TEST(PhaseAlignedPipelineTests, Divisors) {
+  PhaseAlignedPipeline pipeline(std::chrono::milliseconds(20));
+  pipeline.addStage("high_level", [] {}, std::chrono::milliseconds(60));
+  pipeline.addStage("uav", [] {}, std::chrono::milliseconds(20));
+  // Rounded to the nearest multiple
+  pipeline.addStage("arm", [] {}, std::chrono::milliseconds(50));
+  // Faster stages run every tick
+  pipeline.addStage("fast", [] {}, std::chrono::milliseconds(5));
+  ASSERT_EQ(pipeline.divisor(0), 3u);
+  ASSERT_EQ(pipeline.divisor(1), 1u);
+  ASSERT_EQ(pipeline.divisor(2), 3u);
+  ASSERT_EQ(pipeline.divisor(3), 1u);
+}
+
+TEST(PhaseAlignedPipelineTests, Order) {
+  PhaseAlignedPipeline pipeline(std::chrono::milliseconds(20));
+  std::string calls;
+  pipeline.addStage("high_level", [&calls] { calls += "H"; },
+                    std::chrono::milliseconds(40));
+  pipeline.addStage("uav", [&calls] { calls += "U"; },
+                    std::chrono::milliseconds(20));
+  for (int i = 0; i < 5; ++i) {
+    pipeline.tick();
+    calls += "|";
+  }
+  // The high level stage always runs right before the uav stage
+  ASSERT_EQ(calls, "HU|U|HU|U|HU|");
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/profiled_mutex.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace {
+LockStatistics::Summary summary(const std::string &name) {
+  return LockProfiler::instance().statistics(name)->summary();
+}
+}
+
+class ProfiledMutexTests : public ::testing::Test {
+protected:
+  void SetUp() { LockProfiler::instance().enable(); }
+  void TearDown() { LockProfiler::instance().disable(); }
+};
+
+TEST_F(ProfiledMutexTests, Disabled) {
+  LockProfiler::instance().disable();
+  ProfiledMutex mutex("disabled");
+  {
+    std::lock_guard<ProfiledMutex> lock(mutex);
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+  ASSERT_EQ(summary("disabled").acquisitions, 0u);
+}
+
+TEST_F(ProfiledMutexTests, LazyStatistics) {
+  LockProfiler::instance().disable();
+  ProfiledMutex mutex("lazy");
+  {
+    std::lock_guard<ProfiledMutex> lock(mutex);
+  }
+  // Mutexes that were never profiled do not register their name
+  for (const auto &statistics : LockProfiler::instance().summaries()) {
+    ASSERT_NE(statistics.name, "lazy");
+  }
+}
+
+#ifndef AERIAL_AUTONOMY_NO_LOCK_PROFILING
+TEST_F(ProfiledMutexTests, Uncontended) {
+  ProfiledMutex mutex("uncontended");
+  for (int i = 0; i < 10; ++i) {
+    std::lock_guard<ProfiledMutex> lock(mutex);
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+  auto statistics = summary("uncontended");
+  ASSERT_EQ(statistics.acquisitions, 11u);
+  ASSERT_EQ(statistics.contended, 0u);
+  ASSERT_EQ(statistics.wait_max, 0);
+}
+
+TEST_F(ProfiledMutexTests, Contended) {
+  ProfiledMutex mutex("contended");
+  std::unique_lock<ProfiledMutex> lock(mutex);
+  std::thread waiter([&mutex] {
+    std::lock_guard<ProfiledMutex> lock(mutex);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  lock.unlock();
+  waiter.join();
+  auto statistics = summary("contended");
+  ASSERT_EQ(statistics.acquisitions, 2u);
+  ASSERT_EQ(statistics.contended, 1u);
+  ASSERT_GE(statistics.wait_max, 10e-3);
+  ASSERT_GE(statistics.hold_max, 10e-3);
+}
+
+TEST_F(ProfiledMutexTests, RecursiveHold) {
+  ProfiledRecursiveMutex mutex("recursive");
+  {
+    std::lock_guard<ProfiledRecursiveMutex> outer(mutex);
+    {
+      std::lock_guard<ProfiledRecursiveMutex> inner(mutex);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  auto statistics = summary("recursive");
+  ASSERT_EQ(statistics.acquisitions, 2u);
+  // Only the outermost lock records a hold, so the median is not the short
+  // inner hold
+  ASSERT_GE(statistics.hold_p50, 4e-3);
+}
+
+TEST_F(ProfiledMutexTests, SharedName) {
+  ProfiledMutex first("shared");
+  ProfiledMutex second("shared");
+  {
+    std::lock_guard<ProfiledMutex> lock(first);
+  }
+  {
+    std::lock_guard<ProfiledMutex> lock(second);
+  }
+  ASSERT_EQ(summary("shared").acquisitions, 2u);
+}
+
+TEST_F(ProfiledMutexTests, Report) {
+  ProfiledMutex mutex("reported");
+  {
+    std::lock_guard<ProfiledMutex> lock(mutex);
+  }
+  std::ostringstream report;
+  LockProfiler::instance().writeReport(report);
+  ASSERT_NE(report.str().find("hold_p99"), std::string::npos);
+  ASSERT_NE(report.str().find("reported"), std::string::npos);
+}
+#endif
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,186 @@
+#include "aerial_autonomy/common/replay_traces.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+/**
+* @brief Writes text stream files of a recorded run into a log directory
+*/
+class ReplayTracesTests : public ::testing::Test {
+public:
+  ReplayTracesTests() : log_directory_("/tmp/replay_traces_test") {
+    boost::filesystem::create_directories(log_directory_);
+  }
+
+  ~ReplayTracesTests() { boost::filesystem::remove_all(log_directory_); }
+
+  /**
+  * @brief Write a stream file. The first value of each row is the timestamp
+  */
+  void writeStream(std::string stream_id, std::string header,
+                   const std::vector<std::vector<double>> &rows) {
+    std::ofstream file((log_directory_ / stream_id).string());
+    file << "#Time," << header << "\n";
+    for (const auto &row : rows) {
+      file << int64_t(row[0]);
+      for (size_t i = 1; i < row.size(); ++i) {
+        file << "," << row[i];
+      }
+      file << "\n";
+    }
+  }
+
+protected:
+  boost::filesystem::path log_directory_;
+  const double ms_ = 1e6; ///< Nanoseconds in a millisecond
+};
+
+TEST_F(ReplayTracesTests, RPYTReference) {
+  writeStream("rpyt_reference_connector",
+              "Thrust_gain,x,y,z,roll,pitch,yaw,vx,vy,vz,roll_bias,"
+              "pitch_bias,Sensor_roll,Sensor_pitch,Sensor_yaw",
+              {{0 * ms_, 0.16, 1, 2, 3, 0, 0, 0.1, 4, 5, 6, 0, 0, 0, 0, 0},
+               {20 * ms_, 0.17, 1.5, 2, 3, 0, 0, 0.2, 4, 5, 6, 0, 0, 0, 0, 0}});
+  writeStream("rpyt_reference_controller",
+              "Errorx,Errory,Errorz,Erroryaw,Errorvx,Errorvy,Errorvz,Cmd_roll,"
+              "Cmd_pitch,Cmd_yawrate,Cmd_thrust",
+              {{0 * ms_ + 1000, 1, 1, 1, 0.5, -1, -1, -1, 0.1, 0.2, 0.3, 0.4},
+               {20 * ms_ + 1000, 0.5, 1, 1, 0.4, -1, -1, -1, 0, 0, 0, 0.5}});
+  auto trace = replay_traces::rpytReferenceTrace(log_directory_);
+  ASSERT_EQ(trace.sensor_data.size(), 2u);
+  ASSERT_EQ(trace.recorded_controls.size(), 2u);
+  double time = std::get<0>(trace.sensor_data[1]);
+  ASSERT_NEAR(time, 0.02, 1e-9);
+  ASSERT_EQ(std::get<1>(trace.sensor_data[1]), 0.17);
+  ASSERT_EQ(std::get<2>(trace.sensor_data[1]), Velocity(4, 5, 6));
+  ASSERT_EQ(std::get<3>(trace.sensor_data[1]), PositionYaw(1.5, 2, 3, 0.2));
+  ASSERT_EQ(trace.recorded_controls[0], Eigen::Vector4d(0.1, 0.2, 0.3, 0.4));
+  // Reference is the state plus the error
+  Eigen::VectorXd reference = trace.goal->atTime(time).first;
+  ASSERT_EQ(reference.size(), 15);
+  ASSERT_NEAR(reference(0), 2, 1e-9);
+  ASSERT_NEAR(reference(1), 3, 1e-9);
+  ASSERT_NEAR(reference(5), 0.6, 1e-9);
+  ASSERT_NEAR(reference(6), 3, 1e-9);
+  ASSERT_EQ(trace.goal->atTime(time).second(0), 1.0);
+  // Reference holds outside of the logged span
+  ASSERT_EQ(trace.goal->atTime(10.0).first, reference);
+}
+
+TEST_F(ReplayTracesTests, SkipUnpairedDataPoints) {
+  std::string connector_header =
+      "Thrust_gain,x,y,z,roll,pitch,yaw,vx,vy,vz,roll_bias,pitch_bias,"
+      "Sensor_roll,Sensor_pitch,Sensor_yaw";
+  std::string controller_header =
+      "Errorx,Errory,Errorz,Erroryaw,Errorvx,Errorvy,Errorvz,Cmd_roll,"
+      "Cmd_pitch,Cmd_yawrate,Cmd_thrust";
+  std::vector<double> connector_row(16, 0), controller_row(12, 0);
+  std::vector<std::vector<double>> connector_rows, controller_rows;
+  for (int i = 0; i < 10; ++i) {
+    controller_row[0] = 20 * i * ms_;
+    controller_rows.push_back(controller_row);
+    // Connector logged every other step
+    if (i % 2 == 0) {
+      connector_row[0] = 20 * i * ms_;
+      connector_rows.push_back(connector_row);
+    }
+  }
+  writeStream("rpyt_reference_connector", connector_header, connector_rows);
+  writeStream("rpyt_reference_controller", controller_header,
+              controller_rows);
+  auto trace = replay_traces::rpytReferenceTrace(log_directory_);
+  ASSERT_EQ(trace.sensor_data.size(), 5u);
+  ASSERT_NEAR(std::get<0>(trace.sensor_data[4]), 0.16, 1e-9);
+  // A larger skew pairs every controller data point
+  trace = replay_traces::rpytReferenceTrace(log_directory_, 0.025);
+  ASSERT_EQ(trace.sensor_data.size(), 10u);
+}
+
+TEST_F(ReplayTracesTests, QuadMPC) {
+  std::vector<double> state_row = {0};
+  for (int i = 0; i < 15; ++i) {
+    state_row.push_back(i);
+  }
+  state_row.insert(state_row.end(), {0.16, 0.01, 0.02});
+  std::vector<double> controller_row = {0, 0, 0, 0, 0, 0, 0};
+  controller_row.insert(controller_row.end(), {1.1, 0.1, 0.2, 0.3, 5});
+  for (int i = 0; i < 9; ++i) {
+    controller_row.push_back(10 + i);
+  }
+  controller_row.push_back(0.02);
+  std::vector<std::vector<double>> state_rows, controller_rows;
+  for (int i = 0; i < 3; ++i) {
+    state_row[0] = controller_row[0] = 20 * i * ms_;
+    state_rows.push_back(state_row);
+    controller_rows.push_back(controller_row);
+  }
+  writeStream("quad_mpc_state_estimator",
+              "x,y,z,r,p,y,vx,vy,vz,rdot,pdot,ydot,rd,pd,yd,kt,bias_r,bias_p",
+              state_rows);
+  writeStream("ddp_quad_mpc_controller",
+              "Errorx,Errory,Errorz,Errorvx,Errorvy,Errorvz,thrust_d,rd,pd,"
+              "yaw_rate_d,J,x_ref,y_ref,z_ref,r_ref,p_ref,y_ref,vx_ref,vy_ref,"
+              "vz_ref,Loop timer",
+              controller_rows);
+  auto trace = replay_traces::quadMPCTrace(log_directory_);
+  ASSERT_EQ(trace.sensor_data.size(), 3u);
+  const auto &mpc_inputs = trace.sensor_data[2];
+  ASSERT_NEAR(mpc_inputs.time_since_goal, 0.04, 1e-9);
+  ASSERT_EQ(mpc_inputs.initial_state.size(), 15);
+  ASSERT_EQ(mpc_inputs.initial_state(14), 14);
+  ASSERT_EQ(mpc_inputs.parameters.size(), 1);
+  ASSERT_EQ(mpc_inputs.parameters(0), 0.16);
+  ASSERT_EQ(trace.recorded_controls[2], Eigen::Vector4d(1.1, 0.1, 0.2, 0.3));
+  Eigen::VectorXd reference = trace.goal->atTime(0.03).first;
+  ASSERT_EQ(reference(8), 18);
+  ASSERT_EQ(reference(9), 0);
+}
+
+TEST_F(ReplayTracesTests, QrotorBackstepping) {
+  std::vector<std::vector<double>> connector_rows, controller_rows;
+  for (int i = 0; i < 4; ++i) {
+    // roll, pitch, yaw, roll_cmd, pitch_cmd, yaw_rate_cmd, thrust
+    connector_rows.push_back(
+        {20.0 * i * ms_ + 1000, 0, 0, 0.01 * i, 0, 0, 0, 30.0 + i});
+    // p, pd, v, vd
+    controller_rows.push_back({20.0 * i * ms_, 1, 2, 3, 1, 2, 3.1, 0, 0, 0, 0,
+                               0, 0.1 * i * i});
+  }
+  writeStream("qrotor_backstepping_controller_connector",
+              "roll,pitch,yaw,roll_cmd,pitch_cmd,yaw_rate_cmd,thrust",
+              connector_rows);
+  writeStream("qrotor_backstepping_controller",
+              "p_x,p_y,p_z,pd_x,pd_y,pd_z,v_x,v_y,v_z,vd_x,vd_y,vd_z",
+              controller_rows);
+  auto trace = replay_traces::qrotorBacksteppingTrace(log_directory_);
+  ASSERT_EQ(trace.sensor_data.size(), 4u);
+  ASSERT_TRUE(trace.recorded_controls.empty());
+  const QrotorBacksteppingState &state = trace.sensor_data[2].second;
+  // Thrust is the one logged in the previous step
+  ASSERT_EQ(state.thrust, 31);
+  ASSERT_NEAR(state.thrust_dot, 50, 1e-6);
+  ASSERT_NEAR(state.w.z(), 0.5, 1e-6);
+  ASSERT_EQ(state.pose.getOrigin().z(), 3);
+  ParticleState reference = trace.goal->atTime(0.04).first;
+  ASSERT_NEAR(reference.p.z, 3.1, 1e-9);
+  // vd_z = 0.1 * i^2 gives constant jerk
+  ASSERT_NEAR(reference.v.z, 0.4, 1e-9);
+  ASSERT_NEAR(reference.a.z, 15, 1e-6);
+  ASSERT_NEAR(reference.j.z, 500, 1e-6);
+}
+
+TEST_F(ReplayTracesTests, MissingStream) {
+  ASSERT_THROW(replay_traces::quadMPCTrace(log_directory_), std::runtime_error);
+}
+
+TEST_F(ReplayTracesTests, MissingColumns) {
+  writeStream("quad_mpc_state_estimator", "x,y,z", {{0, 1, 2, 3}});
+  writeStream("ddp_quad_mpc_controller", "thrust_d", {{0, 1}});
+  ASSERT_THROW(replay_traces::quadMPCTrace(log_directory_), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
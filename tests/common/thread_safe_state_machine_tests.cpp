@@ -12,6 +12,9 @@
 // functor row
 #include <boost/msm/front/functor_row.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace msmf = boost::msm::front;
 
 // Event:
@@ -81,7 +84,9 @@ struct SampleStateMachineFrontEnd
                            msmf::Row<DoubleCount, Count, msmf::none,
                                      count_action_fct, msmf::none>,
                            msmf::Row<DoubleCount, DoubleCountEvt, msmf::none,
-                                     double_count_action_fct, msmf::none>> {};
+                                     double_count_action_fct, msmf::none>,
+                           msmf::Row<SingleCount, uav_basic_events::Abort,
+                                     msmf::none, msmf::none, msmf::none>> {};
 };
 
 void countTillHundred(SampleStateMachine *state_machine) {
@@ -135,6 +140,59 @@ TEST(ThreadSafeStateMachineTests, MultiThreadDoubleCount) {
   t2.join();
   ASSERT_EQ(state_machine.count_value, 300);
 }
+
+TEST(ThreadSafeStateMachineTests, PostEvent) {
+  SampleStateMachine state_machine(0);
+  state_machine.start();
+  state_machine.postEvent(SwitchToDoubleCount());
+  boost::thread t1([&state_machine] {
+    for (int i = 0; i < 100; ++i) {
+      state_machine.postEvent(Count());
+    }
+  });
+  boost::thread t2([&state_machine] {
+    for (int i = 0; i < 100; ++i) {
+      state_machine.postEvent(DoubleCountEvt());
+    }
+  });
+  t1.join();
+  t2.join();
+  std::atomic<bool> done(false);
+  state_machine.post("done", [&done] { done = true; });
+  while (!done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(state_machine.count_value, 300);
+  auto statistics = state_machine.eventLatencyStatistics();
+  ASSERT_EQ(statistics.size(), 4u);
+  for (const auto &event : statistics) {
+    if (event.name == typeid(Count).name() ||
+        event.name == typeid(DoubleCountEvt).name()) {
+      ASSERT_EQ(event.count, 100u);
+    }
+  }
+}
+
+TEST(ThreadSafeStateMachineTests, AbortDumpsFlightRecorder) {
+  LogConfig log_config;
+  log_config.set_directory("/tmp/thread_safe_state_machine_test");
+  DataStreamConfig *stream_config = log_config.add_data_stream_configs();
+  stream_config->set_stream_id("recorded_stream");
+  stream_config->set_recorder_duration(1);
+  Log log(log_config);
+  LogContext context(log);
+  SampleStateMachine state_machine(0);
+  state_machine.start();
+  DATA_LOG("recorded_stream") << 1 << DataStream::endl;
+  state_machine.process_event(Count());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(boost::filesystem::exists(log.directory() / "recorder_0"));
+  state_machine.process_event(uav_basic_events::Abort());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_TRUE(boost::filesystem::exists(log.directory() / "recorder_0" /
+                                        "recorded_stream"));
+  boost::filesystem::remove_all(log.directory());
+}
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
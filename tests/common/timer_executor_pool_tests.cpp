@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/realtime.h>
+#include <aerial_autonomy/common/timer_executor_pool.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <sched.h>
+
+TEST(RealtimeTests, ThreadAffinity) {
+  std::thread([] {
+    ASSERT_TRUE(realtime::setThreadAffinity({0}));
+    std::this_thread::yield();
+    ASSERT_EQ(sched_getcpu(), 0);
+  }).join();
+}
+
+TEST(RealtimeTests, InvalidSettings) {
+  std::thread([] {
+    ASSERT_FALSE(realtime::setThreadAffinity({-1}));
+    ASSERT_FALSE(realtime::setThreadPriority(1000));
+  }).join();
+}
+
+TEST(RealtimeTests, PrefaultStack) {
+  std::thread([] { realtime::prefaultStack(64 * 1024); }).join();
+}
+
+TEST(RealtimeTests, PrefaultStackLargerThanStack) {
+  // Clamped to the stack of the thread instead of overflowing it
+  std::thread([] { realtime::prefaultStack(1ul << 30); }).join();
+}
+
+TEST(TimerExecutorPoolTests, SharedExecutor) {
+  TimerExecutorPool pool(2);
+  ASSERT_EQ(pool.executor("timer"), pool.executor("other_timer"));
+  ASSERT_EQ(pool.executor("timer")->workerCount(), 2u);
+  ASSERT_FALSE(pool.memoryLocked());
+}
+
+TEST(TimerExecutorPoolTests, RealtimeTimer) {
+  RealtimeConfig config;
+  config.set_prefault_stack_bytes(64 * 1024);
+  auto timer_config = config.add_timers();
+  timer_config->set_timer("realtime_timer");
+  timer_config->add_cpus(0);
+  std::atomic<int> cpu(-1);
+  // Declared after the captured state so that it stops before it is destroyed
+  TimerExecutorPool pool(2, config);
+  auto executor = pool.executor("realtime_timer");
+  ASSERT_NE(executor, pool.executor("other_timer"));
+  ASSERT_EQ(executor->workerCount(), 1u);
+  executor->schedule([&cpu] { cpu = sched_getcpu(); },
+                     std::chrono::milliseconds(10), TimerPriority::High,
+                     "realtime_timer");
+  pool.executor("other_timer")
+      ->schedule([] {}, std::chrono::milliseconds(10), TimerPriority::Normal,
+                 "other_timer");
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(cpu, 0);
+  auto statistics = pool.statistics();
+  ASSERT_EQ(statistics.size(), 2u);
+  ASSERT_EQ(statistics[0].name, "other_timer");
+  ASSERT_EQ(statistics[1].name, "realtime_timer");
+}
+
+TEST(TimerExecutorPoolTests, DuplicateTimer) {
+  RealtimeConfig config;
+  config.add_timers()->set_timer("timer");
+  config.add_timers()->set_timer("timer");
+  ASSERT_THROW(TimerExecutorPool(1, config), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+
+#include <aerial_autonomy/common/timer_executor.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+TEST(TimerExecutorTests, Timing) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(2);
+  executor.schedule([&x] { x++; }, std::chrono::milliseconds(20));
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  ASSERT_GE(x, 49);
+  ASSERT_LE(x, 51);
+}
+
+TEST(TimerExecutorTests, MoreTimersThanWorkers) {
+  std::vector<std::atomic<int>> counters(6);
+  // Declared after the counters so that it stops before they are destroyed
+  TimerExecutor executor(2);
+  for (size_t i = 0; i < counters.size(); ++i) {
+    counters[i] = 0;
+    std::atomic<int> &counter = counters[i];
+    executor.schedule([&counter] { counter++; },
+                      std::chrono::milliseconds(10 * (i + 1)));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  for (size_t i = 0; i < counters.size(); ++i) {
+    int expected = 60 / (i + 1);
+    ASSERT_GE(counters[i], expected - 2) << "Timer " << i;
+    ASSERT_LE(counters[i], expected + 2) << "Timer " << i;
+  }
+}
+
+TEST(TimerExecutorTests, LongPeriod) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1, "timer_executor", std::chrono::milliseconds(1));
+  // The period spans more than one turn of the wheel
+  executor.schedule([&x] { x++; }, std::chrono::milliseconds(400));
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  ASSERT_EQ(x, 3);
+}
+
+TEST(TimerExecutorTests, Cancel) {
+  std::atomic<int> x(0);
+  std::atomic<bool> in_call(false);
+  TimerExecutor executor(2);
+  auto id = executor.schedule(
+      [&x, &in_call] {
+        in_call = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        x++;
+        in_call = false;
+      },
+      std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  executor.cancel(id);
+  // Cancel waits for the running call
+  ASSERT_FALSE(in_call);
+  int count = x;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(x, count);
+  // Unknown ids are ignored
+  executor.cancel(id);
+}
+
+TEST(TimerExecutorTests, CancelFromCall) {
+  std::atomic<int> x(0);
+  TimerExecutor::TaskId id;
+  std::mutex id_mutex;
+  TimerExecutor executor(1);
+  {
+    std::lock_guard<std::mutex> lock(id_mutex);
+    id = executor.schedule(
+        [&] {
+          std::lock_guard<std::mutex> lock(id_mutex);
+          x++;
+          executor.cancel(id);
+        },
+        std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(x, 1);
+}
+
+TEST(TimerExecutorTests, Priority) {
+  std::mutex order_mutex;
+  std::vector<std::string> order;
+  auto record = [&order, &order_mutex](std::string name) {
+    std::lock_guard<std::mutex> lock(order_mutex);
+    order.push_back(name);
+  };
+  TimerExecutor executor(1);
+  // Keep the worker busy while the other timers become due
+  executor.schedule(
+      [&record] {
+        record("busy");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      },
+      std::chrono::seconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  executor.schedule([&record] { record("low"); }, std::chrono::seconds(10),
+                    TimerPriority::Low);
+  executor.schedule([&record] { record("normal"); }, std::chrono::seconds(10),
+                    TimerPriority::Normal);
+  executor.schedule([&record] { record("high"); }, std::chrono::seconds(10),
+                    TimerPriority::High);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::lock_guard<std::mutex> lock(order_mutex);
+  ASSERT_EQ(order,
+            std::vector<std::string>({"busy", "high", "normal", "low"}));
+}
+
+TEST(TimerExecutorTests, LowPriorityKeepsWorkerFree) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(2);
+  auto slow = [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  };
+  executor.schedule(slow, std::chrono::milliseconds(10), TimerPriority::Low);
+  executor.schedule(slow, std::chrono::milliseconds(10), TimerPriority::Low);
+  executor.schedule([&x] { x++; }, std::chrono::milliseconds(10),
+                    TimerPriority::High);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_GE(x, 45);
+}
+
+TEST(TimerExecutorTests, Overrun) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1);
+  executor.schedule(
+      [&x] {
+        x++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+      },
+      std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(310));
+  // Calls follow each other without catching up on missed periods
+  ASSERT_GE(x, 9);
+  ASSERT_LE(x, 11);
+}
+
+TEST(TimerExecutorTests, Statistics) {
+  int calls = 0;
+  TimerExecutor executor(1);
+  executor.schedule(
+      [] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); },
+      std::chrono::milliseconds(10), TimerPriority::Normal, "fast");
+  executor.schedule(
+      [&calls] {
+        // Every other call overruns
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(++calls % 2 ? 30 : 1));
+      },
+      std::chrono::milliseconds(20), TimerPriority::High, "slow");
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  auto statistics = executor.statistics();
+  ASSERT_EQ(statistics.size(), 2u);
+  ASSERT_EQ(statistics[0].name, "fast");
+  ASSERT_EQ(statistics[1].name, "slow");
+  ASSERT_GT(statistics[0].ticks, 0u);
+  ASSERT_GE(statistics[0].execution_p50, 0.005);
+  ASSERT_LT(statistics[0].execution_p50, 0.01);
+  // The slow timer delays the fast one on the single worker
+  ASSERT_GT(statistics[0].jitter_max, 0.001);
+  ASSERT_GT(statistics[1].overruns, 0u);
+  ASSERT_GE(statistics[1].execution_max, 0.03);
+  ASSERT_LE(statistics[1].execution_p50, statistics[1].execution_p99);
+}
+
+TEST(TimerExecutorTests, Trigger) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1);
+  auto id = executor.schedule([&x] { x++; }, std::chrono::seconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(x, 1);
+  for (int i = 0; i < 10; ++i) {
+    executor.trigger(id, std::chrono::milliseconds(0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_EQ(x, 11);
+  // Unknown ids are ignored
+  executor.trigger(id + 1, std::chrono::milliseconds(0));
+}
+
+TEST(TimerExecutorTests, TriggerMinInterval) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1);
+  auto id = executor.schedule([&x] { x++; }, std::chrono::seconds(10));
+  // Triggers every millisecond are capped to one call per 20 ms
+  for (int i = 0; i < 200; ++i) {
+    executor.trigger(id, std::chrono::milliseconds(20));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_GE(x, 8);
+  ASSERT_LE(x, 12);
+}
+
+TEST(TimerExecutorTests, TriggerMinIntervalWorkers) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(3);
+  auto id = executor.schedule([&x] { x++; }, std::chrono::seconds(10));
+  // Capped deadlines wake the worker waiting for the next deadline, not only
+  // an idle one
+  for (int i = 0; i < 200; ++i) {
+    executor.trigger(id, std::chrono::milliseconds(20));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_GE(x, 8);
+  ASSERT_LE(x, 12);
+}
+
+TEST(TimerExecutorTests, TriggerTimeout) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1);
+  auto id = executor.schedule(
+      [&x] {
+        x++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      },
+      std::chrono::milliseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  // Triggered while running, the next call follows the running one
+  executor.trigger(id, std::chrono::milliseconds(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(x, 2);
+  // Without triggers the period is a timeout after the triggered call
+  std::this_thread::sleep_for(std::chrono::milliseconds(95));
+  ASSERT_EQ(x, 3);
+}
+
+TEST(TimerExecutorTests, SetPeriod) {
+  std::atomic<int> x(0);
+  TimerExecutor executor(1);
+  auto id = executor.schedule([&x] { x++; }, std::chrono::milliseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(x, 1);
+  // The next call, 10 ms after the first one, is due now
+  executor.setPeriod(id, std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASSERT_EQ(x, 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_GE(x, 50);
+  ASSERT_LE(x, 53);
+  // Unknown ids are ignored
+  executor.setPeriod(id + 1, std::chrono::milliseconds(10));
+}
+
+TEST(TimerExecutorTests, SetPeriodFromCall) {
+  std::atomic<int> x(0);
+  TimerExecutor::TaskId id;
+  std::mutex id_mutex;
+  TimerExecutor executor(1);
+  {
+    std::lock_guard<std::mutex> lock(id_mutex);
+    id = executor.schedule(
+        [&] {
+          std::lock_guard<std::mutex> lock(id_mutex);
+          // Slow down after five calls
+          if (++x == 5) {
+            executor.setPeriod(id, std::chrono::milliseconds(50));
+          }
+        },
+        std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(295));
+  // Calls at 0, 10, 20, 30, 40, then 90, 140, 190, 240, 290 ms
+  ASSERT_EQ(x, 10);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,20 +2,37 @@
 #include <aerial_autonomy/tests/sample_robot_system.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 //// \brief Definitions
 ///  Define any necessary subclasses for tests here
 struct SampleController : public Controller<int, int, int> {
-  virtual bool runImplementation(int, int goal, int &control) {
+  virtual bool runImplementation(int, const int &goal, int &control) {
     control = goal + 1;
     control_ = control;
     return true;
   }
-  virtual ControllerStatus isConvergedImplementation(int, int) {
+  virtual ControllerStatus isConvergedImplementation(int, const int &) {
     return ControllerStatus(ControllerStatus::Completed);
   }
   int control_ = 0;
 };
 
+struct FailingController : public SampleController {
+  virtual bool runImplementation(int, const int &, int &) { return false; }
+};
+
+struct SlowController : public SampleController {
+  virtual bool runImplementation(int sensor_data, const int &goal,
+                                 int &control) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(run_time_));
+    return SampleController::runImplementation(sensor_data, goal, control);
+  }
+  int run_time_ = 5;
+};
+
 class LowlevelSampleControllerConnector
     : public ControllerConnector<int, int, int> {
 public:
@@ -29,6 +46,49 @@ public:
   }
 };
 
+class SlowSampleControllerConnector : public LowlevelSampleControllerConnector {
+public:
+  SlowSampleControllerConnector(Controller<int, int, int> &controller)
+      : LowlevelSampleControllerConnector(controller) {}
+};
+
+class OverlapCheckingConnector : public LowlevelSampleControllerConnector {
+public:
+  OverlapCheckingConnector(Controller<int, int, int> &controller)
+      : LowlevelSampleControllerConnector(controller), runs_(0), inside_(0),
+        overlap_(false), initialize_time_(0) {}
+  virtual void run() {
+    enter();
+    ++runs_;
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    LowlevelSampleControllerConnector::run();
+    leave();
+  }
+  virtual void initialize() {
+    enter();
+    std::this_thread::sleep_for(std::chrono::milliseconds(initialize_time_));
+    LowlevelSampleControllerConnector::initialize();
+    leave();
+  }
+  virtual void disengage() {
+    enter();
+    LowlevelSampleControllerConnector::disengage();
+    leave();
+  }
+  std::atomic<int> runs_;
+  std::atomic<int> inside_;
+  std::atomic<bool> overlap_;
+  int initialize_time_;
+
+private:
+  void enter() {
+    if (inside_++ != 0) {
+      overlap_ = true;
+    }
+  }
+  void leave() { inside_--; }
+};
+
 class SampleControllerConnector : public ControllerConnector<int, int, int> {
 public:
   SampleControllerConnector(
@@ -63,6 +123,19 @@ protected:
 
 /// \brief TEST
 /// All the tests are defined here
+TEST(BaseControllerTests, GoalSnapshot) {
+  SampleController controller;
+  ASSERT_EQ(controller.getGoal(), 0);
+  controller.setGoal(3);
+  auto snapshot = controller.getGoalSnapshot();
+  controller.setGoal(4);
+  // A snapshot is not changed by later goals
+  ASSERT_EQ(*snapshot, 3);
+  ASSERT_EQ(*controller.getGoalSnapshot(), 4);
+  int control;
+  controller.run(0, control);
+  ASSERT_EQ(control, 5);
+}
 TEST(BaseControllerConnectorTests, EmptyConnector) {
   SampleController controller;
   ASSERT_NO_THROW(new LowlevelSampleControllerConnector(controller));
@@ -90,6 +163,30 @@ TEST(BaseControllerConnectorTests, Disengage) {
   controller_connector.run();
   ASSERT_EQ(controller_connector.getStatus(), ControllerStatus::NotEngaged);
 }
+TEST(BaseControllerConnectorTests, CriticalDumpsFlightRecorder) {
+  LogConfig log_config;
+  log_config.set_directory("/tmp/controller_connector_test");
+  log_config.set_recorder_dump_interval(0);
+  DataStreamConfig *stream_config = log_config.add_data_stream_configs();
+  stream_config->set_stream_id("recorded_stream");
+  stream_config->set_recorder_duration(1);
+  Log log(log_config);
+  LogContext context(log);
+  FailingController controller;
+  LowlevelSampleControllerConnector controller_connector(controller);
+  DATA_LOG("recorded_stream") << 1 << DataStream::endl;
+  controller_connector.setGoal(2);
+  controller_connector.run();
+  ASSERT_EQ(controller_connector.getStatus(), ControllerStatus::Critical);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  // Staying critical does not dump again
+  controller_connector.run();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_TRUE(boost::filesystem::exists(log.directory() / "recorder_0" /
+                                        "recorded_stream"));
+  ASSERT_FALSE(boost::filesystem::exists(log.directory() / "recorder_1"));
+  boost::filesystem::remove_all(log.directory());
+}
 
 ///
 /// \brief TEST Sample robot system
@@ -148,6 +245,143 @@ TEST(SampleRobotSystemTest, DependentConnectorAbort) {
   robot_system.runActiveController(ControllerGroup::UAV);
   ASSERT_EQ(controller1.control_, 0);
 }
+TEST(SampleRobotSystemTest, DeadlineWatchdog) {
+  SlowController slow_controller;
+  SampleController fallback_controller;
+  SlowSampleControllerConnector slow_connector(slow_controller);
+  LowlevelSampleControllerConnector fallback_connector(fallback_controller);
+  SampleRobotSystem robot_system;
+  robot_system.addControllerConnector(slow_connector);
+  robot_system.addControllerConnector(fallback_connector);
+  robot_system.setDeadlineWatchdog(
+      &slow_connector, std::chrono::milliseconds(1), 2, [&robot_system] {
+        robot_system.setGoal<LowlevelSampleControllerConnector>(0);
+      });
+  robot_system.setGoal<SlowSampleControllerConnector>(5);
+  // A single missed deadline is tolerated
+  robot_system.runActiveController(ControllerGroup::UAV);
+  slow_controller.run_time_ = 0;
+  robot_system.runActiveController(ControllerGroup::UAV);
+  slow_controller.run_time_ = 5;
+  robot_system.runActiveController(ControllerGroup::UAV);
+  ASSERT_EQ(robot_system.getStatus<SlowSampleControllerConnector>(),
+            ControllerStatus::Completed);
+  // The second consecutive miss switches to the fallback
+  robot_system.runActiveController(ControllerGroup::UAV);
+  ASSERT_EQ(robot_system.getStatus<SlowSampleControllerConnector>(),
+            ControllerStatus::Critical);
+  ASSERT_EQ(robot_system.getStatus<LowlevelSampleControllerConnector>(),
+            ControllerStatus::Active);
+  robot_system.runActiveController(ControllerGroup::UAV);
+  ASSERT_EQ(fallback_controller.control_, 1);
+  ASSERT_EQ(robot_system.getActiveControllerStatus(ControllerGroup::UAV),
+            ControllerStatus::Completed);
+  // Activating the connector again clears the fallback
+  robot_system.setGoal<SlowSampleControllerConnector>(5);
+  ASSERT_EQ(robot_system.getStatus<LowlevelSampleControllerConnector>(),
+            ControllerStatus::NotEngaged);
+  ASSERT_EQ(robot_system.getStatus<SlowSampleControllerConnector>(),
+            ControllerStatus::Active);
+}
+TEST(SampleRobotSystemTest, DeadlineWatchdogDumpsOwnLog) {
+  LogConfig log_config;
+  log_config.set_directory("/tmp/robot_system_watchdog_test");
+  DataStreamConfig *stream_config = log_config.add_data_stream_configs();
+  stream_config->set_stream_id("recorded_stream");
+  stream_config->set_recorder_duration(1);
+  Log log(log_config);
+  SlowController slow_controller;
+  SlowSampleControllerConnector slow_connector(slow_controller);
+  std::unique_ptr<SampleRobotSystem> robot_system;
+  {
+    LogContext context(log);
+    robot_system.reset(new SampleRobotSystem());
+    DATA_LOG("recorded_stream") << 1 << DataStream::endl;
+  }
+  robot_system->addControllerConnector(slow_connector);
+  robot_system->setDeadlineWatchdog(&slow_connector,
+                                    std::chrono::milliseconds(1), 1, [] {});
+  robot_system->setGoal<SlowSampleControllerConnector>(5);
+  // Timer threads have no log context
+  std::thread([&robot_system] {
+    robot_system->runActiveController(ControllerGroup::UAV);
+  }).join();
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  ASSERT_TRUE(boost::filesystem::exists(log.directory() / "recorder_0" /
+                                        "recorded_stream"));
+  boost::filesystem::remove_all(log.directory());
+}
+TEST(SampleRobotSystemTest, ExecutionPeriod) {
+  SampleController controller1, controller2;
+  SlowSampleControllerConnector slow_connector(controller1);
+  LowlevelSampleControllerConnector fast_connector(controller2);
+  slow_connector.setExecutionPeriod(std::chrono::milliseconds(50));
+  SampleRobotSystem robot_system;
+  robot_system.addControllerConnector(slow_connector);
+  robot_system.addControllerConnector(fast_connector);
+  std::vector<double> periods;
+  robot_system.setExecutionPeriodCallback(
+      ControllerGroup::UAV,
+      [&periods](std::chrono::duration<double> period) {
+        periods.push_back(period.count());
+      });
+  robot_system.setGoal<SlowSampleControllerConnector>(1);
+  robot_system.setGoal<LowlevelSampleControllerConnector>(1);
+  // Zero stands for the default period of the group timer
+  ASSERT_EQ(periods, std::vector<double>({0.05, 0}));
+  robot_system.setExecutionPeriodCallback(ControllerGroup::UAV, nullptr);
+  robot_system.setGoal<SlowSampleControllerConnector>(1);
+  ASSERT_EQ(periods.size(), 2u);
+}
+TEST(SampleRobotSystemTest, SwitchWhileRunning) {
+  SampleController controller1, controller2;
+  OverlapCheckingConnector connector1(controller1), connector2(controller2);
+  connector1.setGoal(1);
+  connector2.setGoal(2);
+  SampleRobotSystem robot_system;
+  std::atomic<bool> stop(false);
+  std::thread runner([&robot_system, &stop] {
+    while (!stop) {
+      robot_system.runActiveController(ControllerGroup::UAV);
+    }
+  });
+  for (int i = 0; i < 200; ++i) {
+    robot_system.activateControllerConnector(&connector1);
+    // Activating the active connector initializes it again
+    robot_system.activateControllerConnector(&connector1);
+    robot_system.activateControllerConnector(&connector2);
+    robot_system.abortController(ControllerGroup::UAV);
+    // No run after the abort returned
+    int runs = connector2.runs_;
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    ASSERT_EQ(connector2.runs_, runs);
+  }
+  stop = true;
+  runner.join();
+  // Connectors never run while they are initialized or disengaged
+  ASSERT_FALSE(connector1.overlap_);
+  ASSERT_FALSE(connector2.overlap_);
+}
+TEST(SampleRobotSystemTest, RunDoesNotWaitForSwitch) {
+  SampleController controller1, controller2;
+  OverlapCheckingConnector connector1(controller1), connector2(controller2);
+  connector2.initialize_time_ = 100;
+  SampleRobotSystem robot_system;
+  robot_system.activateControllerConnector(&connector1);
+  std::thread switcher([&robot_system, &connector2] {
+    robot_system.activateControllerConnector(&connector2);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // The previous connector keeps running while the next one initializes
+  auto start = std::chrono::steady_clock::now();
+  robot_system.runActiveController(ControllerGroup::UAV);
+  ASSERT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(50));
+  ASSERT_EQ(connector1.runs_, 1);
+  switcher.join();
+  robot_system.runActiveController(ControllerGroup::UAV);
+  ASSERT_EQ(connector2.runs_, 1);
+}
 ///
 
 int main(int argc, char **argv) {
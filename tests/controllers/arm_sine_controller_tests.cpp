@@ -1,3 +1,4 @@
+#include "aerial_autonomy/common/clock.h"
 #include "aerial_autonomy/controllers/arm_sine_controller.h"
 #include "aerial_autonomy/log/log.h"
 #include <chrono>
@@ -51,10 +52,13 @@ TEST_F(ArmSineControllerTests, Constructor) {
 TEST_F(ArmSineControllerTests, CheckDuration) {
   auto config = createJointConfig();
   ArmSineController controller(config);
+  auto clock = std::make_shared<SimulatedClock>();
+  Clock::setInstance(clock);
   controller.setZeroTime();
-  std::this_thread::sleep_for(std::chrono::duration<double>(1.0));
+  clock->advance(std::chrono::duration<double>(1.0));
   double duration = controller.duration().count();
-  ASSERT_NEAR(duration, 1.0, 1e-2);
+  Clock::setInstance(nullptr);
+  ASSERT_NEAR(duration, 1.0, 1e-9);
 }
 
 TEST_F(ArmSineControllerTests, CheckZeroFreq) {
@@ -1,15 +1,23 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
 #include <cstdio>
+#include <fstream>
 #include <thread>
 
 #include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/log/stream_table.h"
 #include "aerial_autonomy/tests/test_utils.h"
 
 class DataStreamTest : public testing::Test {
 public:
   DataStreamTest() : test_path_("/tmp/dstest") {
     std::remove(test_path_.c_str());
+    for (unsigned segment = 0; segment < 4; ++segment) {
+      std::remove(
+          SegmentedFileWriter::segmentPath(test_path_, segment).c_str());
+    }
     config_.set_delimiter(",");
   }
 
@@ -57,6 +65,18 @@ TEST_F(DataStreamTest, WriteOneLine) {
   test_utils::verifyFileData(data, ds->path(), config_.delimiter());
 }
 
+TEST_F(DataStreamTest, WriteCharacters) {
+  DataStream ds(test_path_, config_);
+  ds << DataStream::startl << 'A' << static_cast<signed char>('B')
+     << static_cast<unsigned char>('C') << 66 << true << DataStream::endl;
+  ds.write();
+  std::ifstream file(test_path_);
+  std::string line;
+  ASSERT_TRUE(std::getline(file, line));
+  // Characters are written as with std::ostream, after the time stamp
+  ASSERT_EQ(line.substr(line.find(',')), ",A,B,C,66,1");
+}
+
 TEST_F(DataStreamTest, WriteMultipleLines) {
   std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
   std::vector<std::vector<int>> data = {
@@ -144,6 +164,322 @@ TEST_F(DataStreamTest, LogDataFalse) {
                              config_.delimiter());
 }
 
+TEST_F(DataStreamTest, WriteBinary) {
+  config_.set_format(DataStreamConfig::BINARY);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  std::vector<std::vector<double>> data = {{1.5, -2.25, 3}, {4, 5.125, -6}};
+  *ds << DataStream::starth << "X"
+      << "Y"
+      << "Z" << DataStream::endl;
+  for (auto line : data) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    *ds << DataStream::startl << line[0] << Eigen::Vector2d(line[1], line[2])
+        << DataStream::endl;
+  }
+  ds->write();
+
+  binary_log::BinaryLogReader reader(ds->path());
+  ASSERT_TRUE(reader.hasSchema());
+  std::vector<std::string> names = {"#Time", "X", "Y", "Z"};
+  ASSERT_EQ(reader.schema().names, names);
+  ASSERT_EQ(reader.schema().types.size(), 4u);
+  ASSERT_EQ(reader.schema().types[0], binary_log::ColumnType::Int64);
+  for (auto line : data) {
+    ASSERT_TRUE(reader.next());
+    ASSERT_GT(reader.getInt64(0), 0);
+    for (unsigned int i = 0; i < line.size(); ++i) {
+      ASSERT_EQ(reader.getDouble(i + 1), line[i]);
+    }
+  }
+  ASSERT_FALSE(reader.next());
+}
+
+TEST_F(DataStreamTest, BinaryFormatMatchesText) {
+  std::string text_path = test_path_ + "_text";
+  std::unique_ptr<DataStream> text_ds(new DataStream(text_path, config_));
+  config_.set_format(DataStreamConfig::BINARY);
+  std::unique_ptr<DataStream> binary_ds(new DataStream(test_path_, config_));
+  for (auto ds : {text_ds.get(), binary_ds.get()}) {
+    *ds << DataStream::starth << "a"
+        << "b"
+        << "c" << DataStream::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    *ds << DataStream::startl << 3 << 0.123456789 << -1e-12 << DataStream::endl;
+    ds->write();
+  }
+
+  binary_log::BinaryLogReader reader(binary_ds->path());
+  std::ifstream text_file(text_path);
+  std::string line;
+  ASSERT_TRUE(std::getline(text_file, line));
+  ASSERT_EQ(reader.formatHeader(), line);
+  ASSERT_TRUE(std::getline(text_file, line));
+  ASSERT_TRUE(reader.next());
+  // Timestamps differ between the two streams
+  auto strip_time = [](const std::string &s) { return s.substr(s.find(',')); };
+  ASSERT_EQ(strip_time(reader.formatRecord()), strip_time(line));
+}
+
+TEST_F(DataStreamTest, BinarySchemaMismatch) {
+  config_.set_format(DataStreamConfig::BINARY);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  *ds << DataStream::startl << 1.0 << 2.0 << DataStream::endl;
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  // Different number of columns
+  *ds << DataStream::startl << 1.0 << DataStream::endl;
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  // Non-numeric data
+  *ds << DataStream::startl << 1.0 << "text" << DataStream::endl;
+  ds->write();
+  ASSERT_EQ(ds->droppedDataPoints(), 2u);
+
+  binary_log::BinaryLogReader reader(ds->path());
+  ASSERT_TRUE(reader.schema().names.empty());
+  ASSERT_TRUE(reader.next());
+  ASSERT_EQ(reader.getDouble(2), 2.0);
+  ASSERT_FALSE(reader.next());
+}
+
+TEST_F(DataStreamTest, BinaryNoData) {
+  config_.set_format(DataStreamConfig::BINARY);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  *ds << DataStream::starth << "X" << DataStream::endl;
+  ds->write();
+
+  binary_log::BinaryLogReader reader(ds->path());
+  ASSERT_FALSE(reader.hasSchema());
+  ASSERT_FALSE(reader.next());
+}
+
+TEST_F(DataStreamTest, WriteCompressed) {
+  config_.set_format(DataStreamConfig::COMPRESSED);
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  *ds << DataStream::starth << "X"
+      << "N" << DataStream::endl;
+  for (int i = 0; i < 20; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    *ds << DataStream::startl << 0.1 * (i / 5) << i << DataStream::endl;
+    // Each write starts a new block
+    if (i % 7 == 0) {
+      ds->write();
+    }
+  }
+  ds->write();
+
+  binary_log::BinaryLogReader reader(ds->path());
+  ASSERT_TRUE(reader.hasSchema());
+  ASSERT_EQ(reader.schema().encoding, binary_log::Encoding::Compressed);
+  std::vector<std::string> names = {"#Time", "X", "N"};
+  ASSERT_EQ(reader.schema().names, names);
+  int64_t time = 0;
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(reader.next());
+    ASSERT_GT(reader.getInt64(0), time);
+    time = reader.getInt64(0);
+    ASSERT_EQ(reader.getDouble(1), 0.1 * (i / 5));
+    ASSERT_EQ(reader.getInt64(2), i);
+  }
+  ASSERT_FALSE(reader.next());
+}
+
+TEST_F(DataStreamTest, CompressedFormatMatchesBinary) {
+  std::string binary_path = test_path_ + "_binary";
+  config_.set_format(DataStreamConfig::BINARY);
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> binary_ds(new DataStream(binary_path, config_));
+  config_.set_format(DataStreamConfig::COMPRESSED);
+  std::unique_ptr<DataStream> compressed_ds(
+      new DataStream(test_path_, config_));
+  for (int i = 0; i < 100; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (auto ds : {binary_ds.get(), compressed_ds.get()}) {
+      *ds << DataStream::startl << std::sin(0.01 * i) << 9.81 << -i
+          << DataStream::endl;
+    }
+  }
+  binary_ds->write();
+  compressed_ds->write();
+
+  binary_log::BinaryLogReader binary_reader(binary_path);
+  binary_log::BinaryLogReader compressed_reader(test_path_);
+  // Timestamps differ between the two streams
+  auto strip_time = [](const std::string &s) { return s.substr(s.find(',')); };
+  while (binary_reader.next()) {
+    ASSERT_TRUE(compressed_reader.next());
+    ASSERT_EQ(strip_time(compressed_reader.formatRecord()),
+              strip_time(binary_reader.formatRecord()));
+  }
+  ASSERT_FALSE(compressed_reader.next());
+  ASSERT_LT(boost::filesystem::file_size(test_path_),
+            boost::filesystem::file_size(binary_path));
+}
+
+TEST_F(DataStreamTest, BufferOverflow) {
+  // Each record is a 4 byte length followed by "<time>,1\n"
+  config_.set_buffer_size(40);
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  int pushed = 0;
+  while (ds->overflowDataPoints() == 0) {
+    *ds << DataStream::startl << 1 << DataStream::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ++pushed;
+  }
+  ASSERT_GT(pushed, 1);
+  ds->write();
+  std::vector<std::vector<int>> data(pushed - 1, std::vector<int>{1});
+  test_utils::verifyFileData(data, ds->path(), config_.delimiter());
+
+  // Space is available again after writing
+  *ds << DataStream::startl << 1 << DataStream::endl;
+  ds->write();
+  data.push_back({1});
+  test_utils::verifyFileData(data, ds->path(), config_.delimiter());
+  ASSERT_EQ(ds->overflowDataPoints(), 1u);
+}
+
+TEST_F(DataStreamTest, WriteFromSeparateThread) {
+  config_.set_buffer_size(256);
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  std::atomic<bool> done(false);
+  std::thread writer([&]() {
+    while (!done) {
+      ds->write();
+    }
+  });
+  std::vector<std::vector<int>> data;
+  for (int i = 0; i < 100; i++) {
+    std::vector<int> line = {i, 2 * i, -i};
+    *ds << DataStream::startl;
+    for (auto j : line) {
+      *ds << j;
+    }
+    *ds << DataStream::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    data.push_back(line);
+  }
+  done = true;
+  writer.join();
+  ds->write();
+
+  ASSERT_EQ(ds->overflowDataPoints(), 0u);
+  test_utils::verifyFileData(data, ds->path(), config_.delimiter());
+}
+
+TEST_F(DataStreamTest, WriteSegments) {
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_, 64));
+  *ds << DataStream::starth << "X" << DataStream::endl;
+  std::vector<std::vector<int>> data;
+  for (int i = 0; i < 4; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    *ds << DataStream::startl << i << DataStream::endl;
+    data.push_back({i});
+  }
+  ds->write();
+  ds.reset();
+
+  // Each "<time>,i\n" record is 22 bytes, so each 64 byte segment holds the
+  // header and two data points
+  for (unsigned segment = 0; segment < 2; ++segment) {
+    std::ifstream file(
+        SegmentedFileWriter::segmentPath(test_path_, segment).string());
+    std::string line;
+    ASSERT_TRUE(std::getline(file, line));
+    ASSERT_EQ(line, "#Time,X");
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_TRUE(std::getline(file, line));
+      ASSERT_EQ(std::stoi(line.substr(line.find(',') + 1)),
+                data[2 * segment + i][0]);
+    }
+    ASSERT_FALSE(std::getline(file, line));
+  }
+}
+
+TEST_F(DataStreamTest, WriteBinarySegments) {
+  config_.set_format(DataStreamConfig::BINARY);
+  config_.set_log_rate(1000);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_, 128));
+  *ds << DataStream::starth << "X" << DataStream::endl;
+  for (int i = 0; i < 10; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    *ds << DataStream::startl << double(i) << DataStream::endl;
+  }
+  ds->write();
+  ds.reset();
+
+  // Every segment starts with the schema
+  int i = 0;
+  for (unsigned segment = 0; boost::filesystem::exists(
+           SegmentedFileWriter::segmentPath(test_path_, segment));
+       ++segment) {
+    binary_log::BinaryLogReader reader(
+        SegmentedFileWriter::segmentPath(test_path_, segment));
+    ASSERT_EQ(reader.schema().names.size(), 2u);
+    while (reader.next()) {
+      ASSERT_EQ(reader.getDouble(1), i);
+      ++i;
+    }
+  }
+  ASSERT_EQ(i, 10);
+}
+
+/**
+* @brief Flight recorder tests for each stream format
+*/
+class DataStreamRecorderTest
+    : public DataStreamTest,
+      public testing::WithParamInterface<DataStreamConfig::Format> {
+public:
+  DataStreamRecorderTest() : dump_path_(test_path_ + "_recorder") {
+    std::remove(dump_path_.c_str());
+    config_.set_format(GetParam());
+  }
+
+  ~DataStreamRecorderTest() { std::remove(dump_path_.c_str()); }
+
+protected:
+  std::string dump_path_;
+};
+
+TEST_P(DataStreamRecorderTest, KeepThrottledDataPoints) {
+  config_.set_log_rate(1);
+  config_.set_recorder_duration(10);
+  std::unique_ptr<DataStream> ds(new DataStream(test_path_, config_));
+  *ds << DataStream::starth << "X"
+      << "Y" << DataStream::endl;
+  for (int i = 0; i < 5; ++i) {
+    *ds << DataStream::startl << 0.5 * i << i << DataStream::endl;
+  }
+  ds->write();
+  // The log rate keeps all data points within a second of the header out of
+  // the file
+  ASSERT_EQ(readStreamTable(test_path_).rows.size(), 0u);
+
+  ASSERT_EQ(ds->dumpRecorder(dump_path_), 5u);
+  StreamTable table = readStreamTable(dump_path_);
+  ASSERT_EQ(table.names, std::vector<std::string>({"#Time", "X", "Y"}));
+  ASSERT_EQ(table.rows.size(), 5u);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_DOUBLE_EQ(table.rows[i][table.column("X")], 0.5 * i);
+    ASSERT_DOUBLE_EQ(table.rows[i][table.column("Y")], i);
+  }
+}
+
+TEST_P(DataStreamRecorderTest, Disabled) {
+  DataStream ds(test_path_, config_);
+  ds << DataStream::startl << 1.0 << DataStream::endl;
+  ASSERT_EQ(ds.dumpRecorder(dump_path_), 0u);
+  ASSERT_FALSE(boost::filesystem::exists(dump_path_));
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, DataStreamRecorderTest,
+                        testing::Values(DataStreamConfig::TEXT,
+                                        DataStreamConfig::BINARY,
+                                        DataStreamConfig::COMPRESSED));
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
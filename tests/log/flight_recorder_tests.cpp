@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/flight_recorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+/**
+* @brief Ticks of the high resolution clock in a second
+*/
+const int64_t kSecond =
+    std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::seconds(1))
+        .count();
+
+TEST(FlightRecorderTests, Empty) {
+  FlightRecorder recorder(64, 1.0);
+  std::string header("old"), data("old");
+  ASSERT_EQ(recorder.snapshot(header, data), 0u);
+  ASSERT_TRUE(header.empty());
+  ASSERT_TRUE(data.empty());
+}
+
+TEST(FlightRecorderTests, Snapshot) {
+  FlightRecorder recorder(1024, 1.0);
+  recorder.setHeader("#Time,x\n", 8);
+  recorder.record(1, "1,2\n", 4);
+  recorder.record(2, "2,3\n", 4);
+  std::string header, data;
+  ASSERT_EQ(recorder.snapshot(header, data), 2u);
+  ASSERT_EQ(header, "#Time,x\n");
+  ASSERT_EQ(data, "1,2\n2,3\n");
+}
+
+TEST(FlightRecorderTests, OverwriteOldest) {
+  // Room for three data points of 4 bytes
+  FlightRecorder recorder(3 * (12 + 4), 1.0);
+  for (int i = 0; i < 10; ++i) {
+    std::string data_point = std::to_string(i) + ",0\n";
+    recorder.record(i, data_point.data(), data_point.size());
+  }
+  std::string header, data;
+  ASSERT_EQ(recorder.snapshot(header, data), 3u);
+  ASSERT_EQ(data, "7,0\n8,0\n9,0\n");
+}
+
+TEST(FlightRecorderTests, VariableSizeDataPoints) {
+  FlightRecorder recorder(100, 1.0);
+  std::vector<std::string> data_points;
+  for (int i = 0; i < 50; ++i) {
+    data_points.push_back(std::string(i % 7 + 1, 'a' + i % 26));
+    recorder.record(i, data_points.back().data(), data_points.back().size());
+  }
+  std::string header, data;
+  size_t count = recorder.snapshot(header, data);
+  ASSERT_GT(count, 0u);
+  // The newest data points are kept in order
+  std::string expected;
+  for (size_t i = data_points.size() - count; i < data_points.size(); ++i) {
+    expected += data_points[i];
+  }
+  ASSERT_EQ(data, expected);
+}
+
+TEST(FlightRecorderTests, KeepDuration) {
+  FlightRecorder recorder(1024, 0.5);
+  for (int i = 0; i < 10; ++i) {
+    std::string data_point = std::to_string(i);
+    recorder.record(i * kSecond / 10, data_point.data(), data_point.size());
+  }
+  std::string header, data;
+  // Data points from 0.4 s to 0.9 s
+  ASSERT_EQ(recorder.snapshot(header, data), 6u);
+  ASSERT_EQ(data, "456789");
+}
+
+TEST(FlightRecorderTests, DropOversizedDataPoint) {
+  FlightRecorder recorder(32, 1.0);
+  recorder.record(1, "a", 1);
+  std::string oversized(32, 'b');
+  recorder.record(2, oversized.data(), oversized.size());
+  std::string header, data;
+  ASSERT_EQ(recorder.snapshot(header, data), 1u);
+  ASSERT_EQ(data, "a");
+}
+
+TEST(FlightRecorderTests, SnapshotWhileRecording) {
+  FlightRecorder recorder(4096, 10.0);
+  std::atomic<bool> done(false);
+  std::thread producer([&recorder, &done] {
+    for (int64_t i = 0; i < 100000; ++i) {
+      recorder.record(i, reinterpret_cast<const char *>(&i), sizeof(i));
+    }
+    done = true;
+  });
+  std::string header, data;
+  bool consistent = true;
+  while (!done) {
+    size_t count = recorder.snapshot(header, data);
+    consistent &= data.size() == count * sizeof(int64_t);
+    // Data points are consecutive
+    for (size_t i = 1; i < count && consistent; ++i) {
+      int64_t previous, current;
+      std::memcpy(&previous, &data[(i - 1) * sizeof(int64_t)],
+                  sizeof(int64_t));
+      std::memcpy(&current, &data[i * sizeof(int64_t)], sizeof(int64_t));
+      consistent &= current == previous + 1;
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(consistent);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
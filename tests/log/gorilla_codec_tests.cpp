@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/gorilla_codec.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace binary_log;
+
+/**
+* @brief Encode records into a block and decode them again
+* @param types Column types
+* @param records Records with the given column types
+* @param block Encoded block including the block header
+* @return Decoded records
+*/
+std::vector<std::vector<uint64_t>>
+roundTrip(const std::vector<ColumnType> &types,
+          const std::vector<std::vector<uint64_t>> &records,
+          std::string &block) {
+  BlockEncoder encoder(types);
+  for (const auto &record : records) {
+    encoder.add(reinterpret_cast<const char *>(record.data()));
+  }
+  block = encoder.finish();
+  uint32_t record_count;
+  uint32_t size;
+  std::memcpy(&record_count, block.data(), sizeof(record_count));
+  std::memcpy(&size, block.data() + sizeof(record_count), sizeof(size));
+  EXPECT_EQ(record_count, records.size());
+  EXPECT_EQ(size, block.size() - 2 * sizeof(uint32_t));
+
+  BlockDecoder decoder(types);
+  decoder.reset(block.data() + 2 * sizeof(uint32_t), size, record_count);
+  std::vector<std::vector<uint64_t>> decoded;
+  std::vector<uint64_t> record(types.size());
+  while (decoder.next(reinterpret_cast<char *>(record.data()))) {
+    decoded.push_back(record);
+  }
+  return decoded;
+}
+
+/**
+* @brief Bits of a double
+*/
+uint64_t bits(double value) {
+  uint64_t result;
+  std::memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+TEST(BitWriterTest, WriteRead) {
+  BitWriter writer;
+  writer.write(0x1, 1);
+  writer.write(0x5, 3);
+  writer.write(0xdeadbeefcafef00d, 64);
+  writer.write(0x3ff, 10);
+  ASSERT_EQ(writer.bytes().size(), 10u);
+
+  BitReader reader(writer.bytes().data(), writer.bytes().size());
+  uint64_t value;
+  ASSERT_TRUE(reader.read(1, value));
+  ASSERT_EQ(value, 0x1u);
+  ASSERT_TRUE(reader.read(3, value));
+  ASSERT_EQ(value, 0x5u);
+  ASSERT_TRUE(reader.read(64, value));
+  ASSERT_EQ(value, 0xdeadbeefcafef00d);
+  ASSERT_TRUE(reader.read(10, value));
+  ASSERT_EQ(value, 0x3ffu);
+  // Padding
+  ASSERT_TRUE(reader.read(2, value));
+  ASSERT_EQ(value, 0u);
+  ASSERT_FALSE(reader.read(1, value));
+}
+
+TEST(BitWriterTest, Clear) {
+  BitWriter writer;
+  writer.write(0x7, 3);
+  writer.clear();
+  ASSERT_TRUE(writer.bytes().empty());
+  writer.write(0x1, 1);
+  ASSERT_EQ(writer.bytes(), std::string(1, char(0x80)));
+}
+
+TEST(BlockEncoderTest, EmptyBlock) {
+  BlockEncoder encoder({ColumnType::Int64});
+  ASSERT_EQ(encoder.recordCount(), 0u);
+  ASSERT_TRUE(encoder.finish().empty());
+}
+
+TEST(BlockEncoderTest, RoundTrip) {
+  std::vector<ColumnType> types = {ColumnType::Int64, ColumnType::Double,
+                                   ColumnType::Int64, ColumnType::Double};
+  std::mt19937 generator(0);
+  std::normal_distribution<double> noise(0, 1);
+  std::vector<std::vector<uint64_t>> records;
+  int64_t time = 1500000000000000000;
+  double state = 0;
+  for (int i = 0; i < 500; ++i) {
+    // 100 Hz with jitter in nanoseconds
+    time += 10000000 + int64_t(1e5 * noise(generator));
+    state += 0.01 * noise(generator);
+    records.push_back({uint64_t(time), bits(state),
+                       uint64_t(int64_t(i % 7) - 3),
+                       bits(i < 250 ? 1.0 : 2.0)});
+  }
+  std::string block;
+  ASSERT_EQ(roundTrip(types, records, block), records);
+}
+
+TEST(BlockEncoderTest, RoundTripExtremeValues) {
+  std::vector<ColumnType> types = {ColumnType::Int64, ColumnType::Int64,
+                                   ColumnType::Double};
+  int64_t int_min = std::numeric_limits<int64_t>::min();
+  int64_t int_max = std::numeric_limits<int64_t>::max();
+  std::vector<double> doubles = {0.0,
+                                 -0.0,
+                                 std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN(),
+                                 std::numeric_limits<double>::denorm_min(),
+                                 -std::numeric_limits<double>::max(),
+                                 1e-300};
+  std::vector<int64_t> ints = {0, int_max, int_min, -1, 1, int_max, int_min};
+  std::vector<std::vector<uint64_t>> records;
+  for (unsigned i = 0; i < doubles.size(); ++i) {
+    records.push_back(
+        {uint64_t(ints[i]), uint64_t(ints[doubles.size() - 1 - i]),
+         bits(doubles[i])});
+  }
+  std::string block;
+  ASSERT_EQ(roundTrip(types, records, block), records);
+}
+
+TEST(BlockEncoderTest, CompressSlowSignals) {
+  std::vector<ColumnType> types(1, ColumnType::Int64);
+  types.resize(10, ColumnType::Double);
+  std::vector<std::vector<uint64_t>> records;
+  for (int i = 0; i < 1000; ++i) {
+    int64_t time = 1000000000 + i * int64_t(10000000);
+    std::vector<uint64_t> record = {uint64_t(time)};
+    for (int j = 1; j < 10; ++j) {
+      // Constant and slowly stepping signals
+      record.push_back(bits(j < 5 ? 0.5 * j : double(i / 100)));
+    }
+    records.push_back(record);
+  }
+  std::string block;
+  ASSERT_EQ(roundTrip(types, records, block), records);
+  size_t fixed_size = records.size() * types.size() * sizeof(uint64_t);
+  ASSERT_LT(block.size() * 20, fixed_size);
+}
+
+TEST(BlockEncoderTest, IndependentBlocks) {
+  std::vector<ColumnType> types = {ColumnType::Int64, ColumnType::Double};
+  BlockEncoder encoder(types);
+  std::vector<uint64_t> record = {100, bits(3.5)};
+  encoder.add(reinterpret_cast<const char *>(record.data()));
+  std::string first_block = encoder.finish();
+  encoder.add(reinterpret_cast<const char *>(record.data()));
+  ASSERT_EQ(encoder.recordCount(), 1u);
+  ASSERT_EQ(encoder.finish(), first_block);
+}
+
+TEST(BlockDecoderTest, CorruptBlock) {
+  std::vector<ColumnType> types = {ColumnType::Int64, ColumnType::Double};
+  std::vector<std::vector<uint64_t>> records = {{100, bits(3.5)},
+                                                {200, bits(4.5)}};
+  std::string block;
+  roundTrip(types, records, block);
+  std::string bits = block.substr(2 * sizeof(uint32_t));
+  BlockDecoder decoder(types);
+  // Claim more records than the block holds
+  decoder.reset(bits.data(), bits.size(), 10);
+  std::vector<uint64_t> record(types.size());
+  ASSERT_THROW(
+      while (decoder.next(reinterpret_cast<char *>(record.data()))) {},
+      std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -5,6 +5,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <fstream>
+
 class LogTest : public testing::Test {
 public:
   LogTest() : test_path_("/tmp/log_test") {
@@ -55,6 +57,13 @@ TEST_F(LogTest, ConfigureStreamNotUnique) {
   DataStreamConfig *ds = config_.add_data_stream_configs();
   ds->set_stream_id("stream0");
   ASSERT_THROW(Log::instance().configure(config_), std::runtime_error);
+  // The streams configured before the duplicate are still written
+  std::vector<std::vector<double>> data0 = {{8.8, -2.2, 3.5}, {5.6, -90.1, 4}};
+  writeToStream(data0, "stream0", 30);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  test_utils::verifyFileData(
+      data0, Log::instance()["stream0"].path(),
+      Log::instance()["stream0"].configuration().delimiter());
 }
 
 TEST_F(LogTest, IndexOperator) {
@@ -78,6 +87,60 @@ TEST_F(LogTest, AddDataStream) {
   ASSERT_EQ(ds0.configuration().stream_id(), ds_config.stream_id());
 }
 
+TEST_F(LogTest, RegisterStream) {
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  StreamHandle handle = Log::instance().registerStream("stream0");
+  ASSERT_EQ(&Log::instance()[handle], &Log::instance()["stream0"]);
+  StreamHandle handle2 = Log::instance().registerStream("stream0");
+  ASSERT_EQ(&Log::instance()[handle2], &Log::instance()[handle]);
+}
+
+TEST_F(LogTest, RegisterUnknownStream) {
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  StreamHandle handle = Log::instance().registerStream("unknown_stream");
+  ASSERT_FALSE(Log::instance()[handle].configuration().log_data());
+
+  // Handle is bound once the stream is added
+  DataStreamConfig ds_config;
+  ds_config.set_stream_id("unknown_stream");
+  Log::instance().addDataStream(ds_config);
+  ASSERT_EQ(Log::instance()[handle].configuration().stream_id(),
+            ds_config.stream_id());
+}
+
+TEST_F(LogTest, RegisterStreamBeforeConfigure) {
+  StreamHandle handle = Log::instance().registerStream("stream4");
+  DataStreamConfig *ds = config_.add_data_stream_configs();
+  ds->set_stream_id("stream4");
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  ASSERT_EQ(&Log::instance()[handle], &Log::instance()["stream4"]);
+
+  // Handle is rebound when the log is reconfigured
+  config_.mutable_data_stream_configs()->RemoveLast();
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  ASSERT_FALSE(Log::instance()[handle].configuration().log_data());
+}
+
+TEST_F(LogTest, WriteHandle) {
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  StreamHandle handle = Log::instance().registerStream("stream2");
+  std::vector<std::vector<double>> data = {
+      {8.8, -2.2, 3.5}, {5.6, -90.1, 4}, {3, 4, 5}};
+  for (auto line : data) {
+    DATA_LOG(handle);
+    for (auto i : line) {
+      Log::instance()[handle] << i;
+    }
+    Log::instance()[handle] << DataStream::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  test_utils::verifyFileData(
+      data, Log::instance()[handle].path(),
+      Log::instance()[handle].configuration().delimiter());
+}
+
 TEST_F(LogTest, Write) {
   ASSERT_NO_THROW(Log::instance().configure(config_));
   std::vector<std::vector<double>> data0 = {
@@ -96,6 +159,185 @@ TEST_F(LogTest, Write) {
       data1, Log::instance()["stream1"].path(),
       Log::instance()["stream1"].configuration().delimiter());
 }
+TEST_F(LogTest, WriteSegments) {
+  config_.set_backend(LogConfig::MMAP_SEGMENTS);
+  config_.set_segment_size(4096);
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  std::vector<std::vector<double>> data0 = {
+      {8.8, -2.2, 3.5}, {5.6, -90.1, 4}, {3, 4, 5}};
+  writeToStream(data0, "stream0", 30);
+  boost::filesystem::path path = Log::instance()["stream0"].path();
+  // Segments are truncated to their contents when the streams are closed
+  config_.set_backend(LogConfig::FSTREAM);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+
+  test_utils::verifyFileData(data0,
+                             SegmentedFileWriter::segmentPath(path, 0), ",");
+}
+
+TEST_F(LogTest, IndependentLogs) {
+  config_.set_directory(test_path_ + "_vehicle0");
+  Log log0(config_);
+  config_.set_directory(test_path_ + "_vehicle1");
+  Log log1(config_);
+  ASSERT_NE(log0.directory(), log1.directory());
+  ASSERT_NE(&log0["stream0"], &log1["stream0"]);
+  std::vector<std::vector<double>> data0 = {{1, 2}, {3, 4}};
+  std::vector<std::vector<double>> data1 = {{-1, -2}, {-3, -4}, {-5, -6}};
+  StreamHandle handle0 = log0.registerStream("stream0");
+  StreamHandle handle1 = log1.registerStream("stream0");
+  for (size_t i = 0; i < data1.size(); ++i) {
+    if (i < data0.size()) {
+      DATA_LOG(handle0) << data0[i][0] << data0[i][1] << DataStream::endl;
+    }
+    DATA_LOG(handle1) << data1[i][0] << data1[i][1] << DataStream::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  test_utils::verifyFileData(data0, log0["stream0"].path(), ",");
+  test_utils::verifyFileData(data1, log1["stream0"].path(), ",");
+}
+
+TEST_F(LogTest, Context) {
+  Log log0, log1;
+  ASSERT_EQ(&Log::current(), &Log::instance());
+  {
+    LogContext context0(log0);
+    ASSERT_EQ(&Log::current(), &log0);
+    {
+      LogContext context1(log1);
+      ASSERT_EQ(&Log::current(), &log1);
+    }
+    ASSERT_EQ(&Log::current(), &log0);
+    // Other threads are not bound to the context
+    Log *thread_log = nullptr;
+    std::thread([&thread_log] { thread_log = &Log::current(); }).join();
+    ASSERT_EQ(thread_log, &Log::instance());
+  }
+  ASSERT_EQ(&Log::current(), &Log::instance());
+}
+
+TEST_F(LogTest, WriteInContext) {
+  ASSERT_NO_THROW(Log::instance().configure(config_));
+  config_.set_directory(test_path_ + "_context");
+  Log log(config_);
+  StreamHandle handle = [&log] {
+    LogContext context(log);
+    DATA_HEADER("stream1") << "x" << DataStream::endl;
+    return Log::current().registerStream("stream0");
+  }();
+  ASSERT_EQ(&Log::instance()[handle], &log["stream0"]);
+  // The handle keeps referring to the log of the context on other threads
+  std::vector<std::vector<double>> data = {{1.5, 2}, {3, 4.5}};
+  std::thread([&handle, &data] {
+    for (auto line : data) {
+      DATA_LOG(handle) << line[0] << line[1] << DataStream::endl;
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+  }).join();
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  test_utils::verifyFileData(data, log["stream0"].path(), ",");
+  test_utils::verifyFileData(std::vector<std::vector<double>>(),
+                             Log::instance()["stream0"].path(), ",");
+}
+
+TEST_F(LogTest, ReconfigureWhileWriting) {
+  config_.set_directory(test_path_ + "_reconfigure");
+  Log log(config_);
+  StreamHandle handle = log.registerStream("stream0");
+  std::atomic<bool> running(true);
+  std::thread writer([&handle, &running] {
+    while (running) {
+      DATA_LOG(handle) << 1 << 2 << DataStream::endl;
+    }
+  });
+  for (int i = 0; i < 20; ++i) {
+    log.configure(config_);
+  }
+  ASSERT_GT(log.retiredStreams(), 0u);
+  // The writer thread frees the replaced streams after the grace period
+  std::this_thread::sleep_for(std::chrono::milliseconds(1600));
+  ASSERT_EQ(log.retiredStreams(), 0u);
+  running = false;
+  writer.join();
+  ASSERT_EQ(&log[handle], &log["stream0"]);
+}
+
+TEST_F(LogTest, TelemetryNameInUse) {
+  config_.mutable_data_stream_configs(0)->set_telemetry_name("log_test_tap");
+  config_.set_directory(test_path_ + "_telemetry0");
+  Log log0(config_);
+  // The replaced stream releases its tap
+  ASSERT_NO_THROW(log0.configure(config_));
+  config_.set_directory(test_path_ + "_telemetry1");
+  Log log1;
+  ASSERT_THROW(log1.configure(config_), std::runtime_error);
+}
+
+TEST_F(LogTest, RecorderDump) {
+  config_.set_directory(test_path_ + "_recorder");
+  config_.mutable_data_stream_configs(0)->set_recorder_duration(10);
+  config_.mutable_data_stream_configs(0)->set_log_rate(1);
+  Log log(config_);
+  StreamHandle handle = log.registerStream("stream0");
+  for (int i = 0; i < 20; ++i) {
+    DATA_LOG(handle) << i << DataStream::endl;
+  }
+  log.requestRecorderDump("Test fault");
+  // Faults within the dump interval are ignored
+  log.requestRecorderDump("Second test fault");
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  boost::filesystem::path dump_directory = log.directory() / "recorder_0";
+  ASSERT_TRUE(boost::filesystem::exists(dump_directory / "stream0"));
+  ASSERT_FALSE(boost::filesystem::exists(log.directory() / "recorder_1"));
+  // Streams without a recorder are not dumped
+  ASSERT_FALSE(boost::filesystem::exists(dump_directory / "stream1"));
+  std::vector<std::vector<int>> data;
+  for (int i = 0; i < 20; ++i) {
+    data.push_back({i});
+  }
+  test_utils::verifyFileData(data, dump_directory / "stream0", ",");
+}
+
+TEST_F(LogTest, RecorderDumpWithoutData) {
+  config_.set_directory(test_path_ + "_recorder_empty");
+  config_.mutable_data_stream_configs(0)->set_recorder_duration(10);
+  Log log(config_);
+  ASSERT_TRUE(log.dumpRecorders("Test fault").empty());
+  ASSERT_FALSE(boost::filesystem::exists(log.directory() / "recorder_0"));
+}
+
+TEST_F(LogTest, LockProfile) {
+  config_.set_directory(test_path_ + "_lock_profile");
+  config_.set_write_duration(50);
+  config_.set_lock_profile_period(0.1);
+  Log log(config_);
+  ASSERT_TRUE(LockProfiler::instance().enabled());
+  log["stream0"] << DataStream::startl << 1 << DataStream::endl;
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  std::ifstream report((log.directory() / "lock_profile.txt").string());
+  ASSERT_TRUE(report.good());
+  std::string contents((std::istreambuf_iterator<char>(report)),
+                       std::istreambuf_iterator<char>());
+  ASSERT_NE(contents.find("log_streams"), std::string::npos);
+  LockProfiler::instance().disable();
+}
+
+TEST_F(LogTest, DirectoryUsedByAnotherLog) {
+  config_.set_directory(test_path_ + "_shared");
+  Log log0(config_);
+  Log log1;
+  bool thrown = false;
+  try {
+    log1.configure(config_);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  // Both logs can only be configured if the time stamp changed in between
+  ASSERT_TRUE(thrown || log0.directory() != log1.directory());
+}
+
 /**
 * Non deterministic test
 * \todo Matt Fix this test
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/segmented_file_writer.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+class SegmentedFileWriterTest : public testing::Test {
+public:
+  SegmentedFileWriterTest() : test_dir_("/tmp/segmented_file_writer_test") {
+    boost::filesystem::remove_all(test_dir_);
+    boost::filesystem::create_directory(test_dir_);
+    test_path_ = test_dir_ / "stream";
+  }
+
+  ~SegmentedFileWriterTest() { boost::filesystem::remove_all(test_dir_); }
+
+  std::string readSegment(unsigned index) {
+    std::ifstream file(
+        SegmentedFileWriter::segmentPath(test_path_, index).string(),
+        std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+  }
+
+  bool segmentExists(unsigned index) {
+    return boost::filesystem::exists(
+        SegmentedFileWriter::segmentPath(test_path_, index));
+  }
+
+protected:
+  boost::filesystem::path test_dir_;
+  boost::filesystem::path test_path_;
+};
+
+TEST_F(SegmentedFileWriterTest, Constructor) {
+  ASSERT_NO_THROW(SegmentedFileWriter(test_path_, 16));
+  ASSERT_TRUE(segmentExists(0));
+}
+
+TEST_F(SegmentedFileWriterTest, ConstructorBadPath) {
+  ASSERT_THROW(SegmentedFileWriter(test_dir_ / "missing" / "stream", 16),
+               std::runtime_error);
+}
+
+TEST_F(SegmentedFileWriterTest, PreallocateSegment) {
+  SegmentedFileWriter writer(test_path_, 4096);
+  ASSERT_EQ(boost::filesystem::file_size(
+                SegmentedFileWriter::segmentPath(test_path_, 0)),
+            4096u);
+}
+
+TEST_F(SegmentedFileWriterTest, TruncateOnClose) {
+  {
+    SegmentedFileWriter writer(test_path_, 4096);
+    ASSERT_TRUE(writer.write("abc\n", 4));
+  }
+  ASSERT_EQ(readSegment(0), "abc\n");
+}
+
+TEST_F(SegmentedFileWriterTest, Rotate) {
+  {
+    SegmentedFileWriter writer(test_path_, 8);
+    ASSERT_TRUE(writer.write("abc\n", 4));
+    ASSERT_TRUE(writer.write("def\n", 4));
+    // Records are not split across segments
+    ASSERT_TRUE(writer.write("gh\n", 3));
+    ASSERT_TRUE(writer.write("ijk\n", 4));
+    ASSERT_EQ(writer.segmentCount(), 2u);
+  }
+  ASSERT_EQ(readSegment(0), "abc\ndef\n");
+  ASSERT_EQ(readSegment(1), "gh\nijk\n");
+}
+
+TEST_F(SegmentedFileWriterTest, RepeatHeader) {
+  {
+    SegmentedFileWriter writer(test_path_, 8);
+    ASSERT_TRUE(writer.writeHeader("#h\n", 3));
+    ASSERT_TRUE(writer.write("ab\n", 3));
+    ASSERT_TRUE(writer.write("cd\n", 3));
+  }
+  ASSERT_EQ(readSegment(0), "#h\nab\n");
+  ASSERT_EQ(readSegment(1), "#h\ncd\n");
+}
+
+TEST_F(SegmentedFileWriterTest, RecordTooLarge) {
+  {
+    SegmentedFileWriter writer(test_path_, 8);
+    ASSERT_TRUE(writer.writeHeader("#h\n", 3));
+    ASSERT_FALSE(writer.write("abcdef\n", 7));
+    ASSERT_TRUE(writer.write("ab\n", 3));
+    ASSERT_EQ(writer.segmentCount(), 1u);
+  }
+  ASSERT_EQ(readSegment(0), "#h\nab\n");
+}
+
+TEST_F(SegmentedFileWriterTest, DiskBudget) {
+  auto disk_budget = std::make_shared<DiskBudget>(12);
+  {
+    SegmentedFileWriter writer(test_path_, 4, disk_budget);
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(writer.write("abc\n", 4));
+    }
+    ASSERT_EQ(writer.segmentCount(), 5u);
+    // The open segment is included in the budget
+    ASSERT_LE(disk_budget->usage(), 12u);
+  }
+  ASSERT_FALSE(segmentExists(0));
+  ASSERT_FALSE(segmentExists(1));
+  ASSERT_TRUE(segmentExists(2));
+  ASSERT_TRUE(segmentExists(3));
+  ASSERT_TRUE(segmentExists(4));
+}
+
+TEST_F(SegmentedFileWriterTest, DiskBudgetKeepsOpenSegments) {
+  auto disk_budget = std::make_shared<DiskBudget>(4);
+  SegmentedFileWriter writer1(test_path_, 4, disk_budget);
+  SegmentedFileWriter writer2(test_dir_ / "stream2", 4, disk_budget);
+  ASSERT_TRUE(segmentExists(0));
+  ASSERT_TRUE(boost::filesystem::exists(
+      SegmentedFileWriter::segmentPath(test_dir_ / "stream2", 0)));
+  ASSERT_EQ(disk_budget->usage(), 8u);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
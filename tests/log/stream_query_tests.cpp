@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/log/stream_query.h"
+
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+class StreamQueryTest
+    : public testing::TestWithParam<DataStreamConfig::Format> {
+public:
+  StreamQueryTest() : test_path_("/tmp/stream_query_test") {
+    config_.set_stream_id("stream_query_test");
+    config_.set_format(GetParam());
+    config_.set_log_rate(10000);
+    config_.set_index_interval(5);
+    DataStream ds(test_path_, config_);
+    ds << DataStream::starth << "x"
+       << "n" << DataStream::endl;
+    for (int i = 0; i < 50; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ds << DataStream::startl << 0.5 * i << i << DataStream::endl;
+      ds.write();
+      times_.push_back(std::chrono::high_resolution_clock::now()
+                           .time_since_epoch()
+                           .count());
+    }
+  }
+
+  ~StreamQueryTest() {
+    std::remove(test_path_.c_str());
+    std::remove(TimeIndexWriter::indexPath(test_path_).c_str());
+  }
+
+  /**
+  * @brief Expected query output for data points in [begin, end)
+  */
+  std::string expectedColumn(int begin, int end) {
+    std::stringstream ss;
+    ss << "n\n";
+    for (int i = begin; i < end; ++i) {
+      ss << i << "\n";
+    }
+    return ss.str();
+  }
+
+protected:
+  DataStreamConfig config_;
+  std::string test_path_;
+  std::vector<int64_t> times_; ///< Times after writing each data point
+};
+
+TEST_P(StreamQueryTest, IndexWritten) {
+  TimeIndex index(TimeIndexWriter::indexPath(test_path_));
+  ASSERT_EQ(index.size(), 10u);
+}
+
+TEST_P(StreamQueryTest, QueryAll) {
+  std::stringstream out;
+  ASSERT_EQ(queryStream(test_path_, StreamQuery(), out), 50u);
+  std::string header;
+  std::getline(out, header);
+  ASSERT_EQ(header, "#Time,x,n");
+}
+
+TEST_P(StreamQueryTest, QueryWindow) {
+  StreamQuery query;
+  query.columns = {"n"};
+  for (auto window : std::vector<std::pair<int, int>>{
+           {0, 50}, {7, 8}, {12, 31}, {45, 50}}) {
+    // Data point i is logged between times_[i - 1] and times_[i]
+    query.start = window.first == 0 ? 0 : times_[window.first - 1];
+    query.end = times_[window.second - 1];
+    std::stringstream out;
+    ASSERT_EQ(queryStream(test_path_, query, out),
+              uint64_t(window.second - window.first));
+    ASSERT_EQ(out.str(), expectedColumn(window.first, window.second));
+  }
+}
+
+TEST_P(StreamQueryTest, QueryWithoutIndex) {
+  std::remove(TimeIndexWriter::indexPath(test_path_).c_str());
+  StreamQuery query;
+  query.columns = {"n"};
+  query.start = times_[19];
+  query.end = times_[29];
+  std::stringstream out;
+  ASSERT_EQ(queryStream(test_path_, query, out), 10u);
+  ASSERT_EQ(out.str(), expectedColumn(20, 30));
+}
+
+TEST_P(StreamQueryTest, ColumnOrder) {
+  StreamQuery query;
+  query.columns = {"n", "x"};
+  query.start = times_[9];
+  query.end = times_[10];
+  std::stringstream out;
+  ASSERT_EQ(queryStream(test_path_, query, out), 1u);
+  ASSERT_EQ(out.str(), "n,x\n10,5\n");
+}
+
+TEST_P(StreamQueryTest, UnknownColumn) {
+  StreamQuery query;
+  query.columns = {"y"};
+  std::stringstream out;
+  ASSERT_THROW(queryStream(test_path_, query, out), std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, StreamQueryTest,
+                        testing::Values(DataStreamConfig::TEXT,
+                                        DataStreamConfig::BINARY,
+                                        DataStreamConfig::COMPRESSED));
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
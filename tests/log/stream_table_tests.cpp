@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/log/stream_table.h"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+class StreamTableTest
+    : public testing::TestWithParam<DataStreamConfig::Format> {
+public:
+  StreamTableTest() : test_path_("/tmp/stream_table_test") {
+    DataStreamConfig config;
+    config.set_stream_id("stream_table_test");
+    config.set_format(GetParam());
+    config.set_log_rate(10000);
+    DataStream ds(test_path_, config);
+    ds << DataStream::starth << "x"
+       << "n" << DataStream::endl;
+    for (int i = 0; i < 20; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ds << DataStream::startl << 0.25 * i << i << DataStream::endl;
+      ds.write();
+    }
+  }
+
+  ~StreamTableTest() {
+    std::remove(test_path_.c_str());
+    std::remove((test_path_ + ".idx").c_str());
+  }
+
+protected:
+  std::string test_path_;
+};
+
+TEST_P(StreamTableTest, ReadAll) {
+  StreamTable table = readStreamTable(test_path_);
+  ASSERT_EQ(table.names, std::vector<std::string>({"#Time", "x", "n"}));
+  ASSERT_EQ(table.rows.size(), 20u);
+  ASSERT_EQ(table.times.size(), 20u);
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_EQ(table.rows[i].size(), 3u);
+    ASSERT_DOUBLE_EQ(table.rows[i][table.column("x")], 0.25 * i);
+    ASSERT_DOUBLE_EQ(table.rows[i][table.column("n")], i);
+  }
+}
+
+TEST_P(StreamTableTest, Seconds) {
+  StreamTable table = readStreamTable(test_path_);
+  ASSERT_EQ(table.seconds(0), 0);
+  for (size_t i = 1; i < table.rows.size(); ++i) {
+    // Data points are at least 1 ms apart
+    ASSERT_GE(table.seconds(i) - table.seconds(i - 1), 1e-3);
+  }
+}
+
+TEST_P(StreamTableTest, NearestRow) {
+  StreamTable table = readStreamTable(test_path_);
+  ASSERT_EQ(table.nearestRow(table.times.front() - 1000), 0u);
+  ASSERT_EQ(table.nearestRow(table.times.back() + 1000), 19u);
+  for (size_t i = 0; i < table.rows.size(); ++i) {
+    ASSERT_EQ(table.nearestRow(table.times[i]), i);
+    ASSERT_EQ(table.nearestRow(table.times[i] + 1), i);
+    ASSERT_EQ(table.nearestRow(table.times[i] - 1), i);
+  }
+}
+
+TEST_P(StreamTableTest, MissingColumn) {
+  StreamTable table = readStreamTable(test_path_);
+  ASSERT_THROW(table.column("y"), std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, StreamTableTest,
+                        testing::Values(DataStreamConfig::TEXT,
+                                        DataStreamConfig::BINARY,
+                                        DataStreamConfig::COMPRESSED));
+
+TEST(StreamTableSegmentsTest, ReadSegmentsInOrder) {
+  std::string path("/tmp/stream_table_segments_test");
+  std::vector<std::string> segments = {path + ".000003", path + ".000004"};
+  for (size_t i = 0; i < segments.size(); ++i) {
+    std::ofstream file(segments[i]);
+    file << "#Time,x\n";
+    file << 10 * i << "," << i << "\n";
+    file << 10 * i + 5 << "," << i + 0.5 << "\n";
+  }
+  StreamTable table = readStreamTable(path);
+  for (const auto &segment : segments) {
+    std::remove(segment.c_str());
+  }
+  ASSERT_EQ(table.times, std::vector<int64_t>({0, 5, 10, 15}));
+  ASSERT_DOUBLE_EQ(table.rows[3][table.column("x")], 1.5);
+}
+
+TEST(StreamTableSegmentsTest, MissingFile) {
+  ASSERT_THROW(readStreamTable("/tmp/stream_table_missing_test"),
+               std::runtime_error);
+}
+
+TEST(StreamTableSegmentsTest, EmptyTable) {
+  StreamTable table;
+  ASSERT_EQ(table.nearestRow(0), 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
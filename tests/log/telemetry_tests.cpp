@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/data_stream.h"
+#include "aerial_autonomy/log/telemetry_reader.h"
+
+#include <cstdio>
+#include <thread>
+
+class TelemetryTest : public testing::Test {
+public:
+  TelemetryTest() : tap_name_("aerial_autonomy_telemetry_test") {}
+
+protected:
+  std::string tap_name_;
+};
+
+TEST_F(TelemetryTest, ReaderMissingTap) {
+  ASSERT_THROW(TelemetryReader reader(tap_name_), std::runtime_error);
+}
+
+TEST_F(TelemetryTest, ShmName) {
+  ASSERT_EQ(telemetry::shmName("tap"), "/tap");
+  ASSERT_EQ(telemetry::shmName("/tap"), "/tap");
+}
+
+TEST_F(TelemetryTest, PublishRead) {
+  TelemetryTap tap(tap_name_, 4, 16, false, ",");
+  // Records published before the reader is opened are not read
+  ASSERT_TRUE(tap.publish("1,2\n", 4));
+  TelemetryReader reader(tap_name_);
+  std::string record;
+  ASSERT_FALSE(reader.next(record));
+  ASSERT_TRUE(tap.publish("3,4\n", 4));
+  ASSERT_TRUE(reader.next(record));
+  ASSERT_EQ(record, "3,4\n");
+  ASSERT_FALSE(reader.next(record));
+  ASSERT_FALSE(reader.binary());
+  ASSERT_FALSE(reader.closed());
+}
+
+TEST_F(TelemetryTest, RecordTooLarge) {
+  TelemetryTap tap(tap_name_, 4, 4, false, ",");
+  TelemetryReader reader(tap_name_);
+  ASSERT_FALSE(tap.publish("12345", 5));
+  std::string record;
+  ASSERT_FALSE(reader.next(record));
+}
+
+TEST_F(TelemetryTest, LostRecords) {
+  TelemetryTap tap(tap_name_, 4, 16, false, ",");
+  TelemetryReader reader(tap_name_);
+  for (int i = 0; i < 10; ++i) {
+    std::string record = std::to_string(i);
+    tap.publish(record.data(), record.size());
+  }
+  std::string record;
+  for (int i = 6; i < 10; ++i) {
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record, std::to_string(i));
+  }
+  ASSERT_FALSE(reader.next(record));
+  ASSERT_EQ(reader.lostRecords(), 6u);
+}
+
+TEST_F(TelemetryTest, Closed) {
+  std::unique_ptr<TelemetryTap> tap(
+      new TelemetryTap(tap_name_, 4, 16, false, ","));
+  TelemetryReader reader(tap_name_);
+  tap.reset();
+  ASSERT_TRUE(reader.closed());
+}
+
+TEST_F(TelemetryTest, NameInUse) {
+  TelemetryTap tap(tap_name_, 4, 16, false, ",");
+  ASSERT_THROW(TelemetryTap(tap_name_, 4, 16, false, ","), std::runtime_error);
+  // The failed tap does not remove the ring of the first one
+  TelemetryReader reader(tap_name_);
+  ASSERT_FALSE(reader.closed());
+}
+
+TEST_F(TelemetryTest, CloseDataStream) {
+  DataStreamConfig config;
+  config.set_stream_id("telemetry_test");
+  config.set_telemetry_name(tap_name_);
+  config.set_index_interval(0);
+  std::string path = "/tmp/telemetry_test";
+  DataStream ds(path, config);
+  TelemetryReader reader(tap_name_);
+  ds.close();
+  ASSERT_TRUE(reader.closed());
+  // A new stream can reuse the tap name
+  DataStream ds2(path, config);
+  std::remove(path.c_str());
+}
+
+TEST_F(TelemetryTest, TextDataStream) {
+  DataStreamConfig config;
+  config.set_stream_id("telemetry_test");
+  config.set_telemetry_name(tap_name_);
+  config.set_index_interval(0);
+  std::string path = "/tmp/telemetry_test";
+  DataStream ds(path, config);
+  TelemetryReader reader(tap_name_);
+  ds << DataStream::starth << "x"
+     << "y" << DataStream::endl;
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ds << DataStream::startl << 1.5 << -2 << DataStream::endl;
+  ds.write();
+
+  std::vector<std::string> names = {"#Time", "x", "y"};
+  ASSERT_EQ(reader.names(), names);
+  std::vector<double> values;
+  ASSERT_TRUE(reader.next(values));
+  ASSERT_EQ(values.size(), 3u);
+  ASSERT_GT(values[0], 0);
+  ASSERT_EQ(values[1], 1.5);
+  ASSERT_EQ(values[2], -2);
+  std::remove(path.c_str());
+}
+
+TEST_F(TelemetryTest, CompressedDataStream) {
+  DataStreamConfig config;
+  config.set_stream_id("telemetry_test");
+  config.set_format(DataStreamConfig::COMPRESSED);
+  config.set_log_rate(1000);
+  config.set_telemetry_name(tap_name_);
+  config.set_index_interval(0);
+  std::string path = "/tmp/telemetry_test";
+  DataStream ds(path, config);
+  TelemetryReader reader(tap_name_);
+  ds << DataStream::starth << "x"
+     << "n" << DataStream::endl;
+  for (int i = 0; i < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ds << DataStream::startl << 0.25 * i << i << DataStream::endl;
+  }
+  ds.write();
+
+  ASSERT_TRUE(reader.binary());
+  std::vector<std::string> names = {"#Time", "x", "n"};
+  ASSERT_EQ(reader.names(), names);
+  std::vector<double> values;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(reader.next(values));
+    ASSERT_EQ(values.size(), 3u);
+    ASSERT_EQ(values[1], 0.25 * i);
+    ASSERT_EQ(values[2], i);
+  }
+  ASSERT_FALSE(reader.next(values));
+  std::remove(path.c_str());
+}
+
+TEST_F(TelemetryTest, ConcurrentReader) {
+  TelemetryTap tap(tap_name_, 8, 32, false, ",");
+  TelemetryReader reader(tap_name_);
+  const int count = 100000;
+  std::thread writer([&tap]() {
+    for (int i = 0; i < count; ++i) {
+      std::string record = std::to_string(i) + "," + std::to_string(-i);
+      tap.publish(record.data(), record.size());
+    }
+  });
+  // Records are either read whole and in order or counted as lost
+  int last = -1;
+  uint64_t read = 0;
+  std::vector<double> values;
+  while (last < count - 1) {
+    if (reader.next(values)) {
+      ASSERT_EQ(values.size(), 2u);
+      ASSERT_GT(values[0], last);
+      ASSERT_EQ(values[1], -values[0]);
+      last = values[0];
+      ++read;
+    }
+  }
+  writer.join();
+  ASSERT_EQ(read + reader.lostRecords(), uint64_t(count));
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
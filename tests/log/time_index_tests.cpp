@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/log/time_index.h"
+
+#include <cstdio>
+
+class TimeIndexTest : public testing::Test {
+public:
+  TimeIndexTest() : index_path_("/tmp/time_index_test.idx") {
+    std::remove(index_path_.c_str());
+  }
+
+  ~TimeIndexTest() { std::remove(index_path_.c_str()); }
+
+protected:
+  std::string index_path_;
+};
+
+TEST_F(TimeIndexTest, ConstructorBadPath) {
+  ASSERT_THROW(TimeIndexWriter("/tmp/missing_dir/stream.idx", 10),
+               std::runtime_error);
+  ASSERT_THROW(TimeIndex("/tmp/missing_dir/stream.idx"), std::runtime_error);
+}
+
+TEST_F(TimeIndexTest, NotAnIndex) {
+  {
+    std::ofstream file(index_path_);
+    file << "#Time,x" << std::endl;
+  }
+  ASSERT_THROW(TimeIndex index(index_path_), std::runtime_error);
+}
+
+TEST_F(TimeIndexTest, IndexPath) {
+  ASSERT_EQ(TimeIndexWriter::indexPath("/tmp/stream").string(),
+            "/tmp/stream.idx");
+}
+
+TEST_F(TimeIndexTest, Interval) {
+  {
+    TimeIndexWriter writer(index_path_, 3);
+    for (int i = 0; i < 10; ++i) {
+      writer.add(100 * i, 10 * i);
+    }
+  }
+  TimeIndex index(index_path_);
+  // Records 0, 3, 6 and 9
+  ASSERT_EQ(index.size(), 4u);
+}
+
+TEST_F(TimeIndexTest, MultipleDataPoints) {
+  {
+    TimeIndexWriter writer(index_path_, 3);
+    // Blocks of data points are indexed if the interval has passed
+    writer.add(0, 0, 5);
+    writer.add(500, 50, 1);
+    writer.add(600, 60, 2);
+  }
+  TimeIndex index(index_path_);
+  ASSERT_EQ(index.size(), 2u);
+}
+
+TEST_F(TimeIndexTest, Seek) {
+  {
+    TimeIndexWriter writer(index_path_, 2);
+    for (int i = 0; i < 10; ++i) {
+      writer.add(100 * i, 10 * i);
+    }
+  }
+  TimeIndex index(index_path_);
+  uint64_t offset = 0;
+  // No indexed record before the first one
+  ASSERT_FALSE(index.seek(0, offset));
+  ASSERT_TRUE(index.seek(1, offset));
+  ASSERT_EQ(offset, 0u);
+  ASSERT_TRUE(index.seek(200, offset));
+  ASSERT_EQ(offset, 0u);
+  ASSERT_TRUE(index.seek(201, offset));
+  ASSERT_EQ(offset, 20u);
+  ASSERT_TRUE(index.seek(1000000, offset));
+  ASSERT_EQ(offset, 80u);
+}
+
+TEST_F(TimeIndexTest, PartialEntry) {
+  {
+    TimeIndexWriter writer(index_path_, 1);
+    writer.add(100, 10);
+    writer.add(200, 20);
+  }
+  {
+    std::ofstream file(index_path_, std::ios::app | std::ios::binary);
+    file.write("abc", 3);
+  }
+  TimeIndex index(index_path_);
+  ASSERT_EQ(index.size(), 2u);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
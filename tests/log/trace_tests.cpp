@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "aerial_autonomy/common/async_timer.h"
+#include "aerial_autonomy/log/log.h"
+#include "aerial_autonomy/log/trace.h"
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+/**
+* @brief Export the recorded spans
+* @return Chrome trace JSON
+*/
+std::string exportTrace() {
+  std::stringstream trace;
+  Tracer::instance().writeChromeTrace(trace);
+  return trace.str();
+}
+
+/**
+* @brief Count the occurrences of a string
+*/
+size_t count(const std::string &text, const std::string &pattern) {
+  size_t occurrences = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1)) {
+    ++occurrences;
+  }
+  return occurrences;
+}
+
+TEST(TraceTests, Intern) {
+  const char *name = Tracer::instance().intern("interned");
+  ASSERT_STREQ(name, "interned");
+  ASSERT_EQ(Tracer::instance().intern(std::string("inter") + "ned"), name);
+}
+
+TEST(TraceTests, Disabled) {
+  Tracer::instance().disable();
+  std::thread([] { TRACE_SPAN("disabled_span"); }).join();
+  ASSERT_EQ(count(exportTrace(), "disabled_span"), 0u);
+}
+
+TEST(TraceTests, Span) {
+  Tracer::instance().enable();
+  std::thread([] {
+    Tracer::instance().setThreadName("span_thread");
+    TRACE_SPAN("outer_span");
+    TRACE_SPAN("inner_span");
+  }).join();
+  std::string trace = exportTrace();
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  ASSERT_EQ(count(trace, "\"args\":{\"name\":\"span_thread\"}"), 1u);
+  ASSERT_EQ(count(trace, "{\"name\":\"outer_span\",\"ph\":\"X\""), 1u);
+  ASSERT_EQ(count(trace, "{\"name\":\"inner_span\",\"ph\":\"X\""), 1u);
+}
+
+TEST(TraceTests, OverwriteOldest) {
+  Tracer::instance().enable(4);
+  std::thread([] {
+    for (int i = 0; i < 10; ++i) {
+      TRACE_SPAN(Tracer::instance().intern("overwrite_" + std::to_string(i)));
+    }
+  }).join();
+  Tracer::instance().enable();
+  std::string trace = exportTrace();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(count(trace, "\"overwrite_" + std::to_string(i) + "\""),
+              i < 6 ? 0u : 1u);
+  }
+}
+
+TEST(TraceTests, EscapeThreadName) {
+  Tracer::instance().enable();
+  std::thread([] {
+    Tracer::instance().setThreadName("quoted \"name\"");
+    TRACE_SPAN("escaped_span");
+  }).join();
+  ASSERT_EQ(count(exportTrace(), "\"quoted \\\"name\\\"\""), 1u);
+}
+
+TEST(TraceTests, ExportWhileRecording) {
+  Tracer::instance().enable(64);
+  std::atomic<bool> done(false);
+  std::thread producer([&done] {
+    int64_t origin = Tracer::now();
+    // Every span lasts exactly one microsecond
+    for (int64_t i = 0; i < 100000; ++i) {
+      Tracer::instance().record("concurrent_span", origin + 2000 * i,
+                                origin + 2000 * i + 1000);
+    }
+    done = true;
+  });
+  bool consistent = true;
+  while (!done) {
+    std::string trace = exportTrace();
+    consistent &= count(trace, "\"concurrent_span\"") ==
+                  count(trace, "\"concurrent_span\",\"ph\":\"X\",") &&
+                  count(trace, "\"concurrent_span\"") <= 64;
+    std::stringstream lines(trace);
+    for (std::string line; std::getline(lines, line);) {
+      if (line.find("concurrent_span") != std::string::npos) {
+        consistent &= line.find("\"dur\":1.000}") != std::string::npos;
+      }
+    }
+  }
+  producer.join();
+  Tracer::instance().enable();
+  ASSERT_TRUE(consistent);
+}
+
+TEST(TraceTests, AsyncTimerTicks) {
+  Tracer::instance().enable();
+  {
+    AsyncTimer timer([] {}, std::chrono::milliseconds(5), "traced_timer");
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  std::string trace = exportTrace();
+  ASSERT_EQ(count(trace, "\"args\":{\"name\":\"traced_timer\"}"), 1u);
+  ASSERT_GT(count(trace, "{\"name\":\"traced_timer\",\"ph\":\"X\""), 1u);
+}
+
+TEST(TraceTests, LogWritesTrace) {
+  LogConfig config;
+  config.set_directory("/tmp/trace_test");
+  config.set_trace_events_per_thread(128);
+  boost::filesystem::path trace_file;
+  {
+    Log log(config);
+    trace_file = log.directory() / "trace.json";
+    std::thread([] { TRACE_SPAN("log_span"); }).join();
+  }
+  std::ifstream file(trace_file.string());
+  std::stringstream trace;
+  trace << file.rdbuf();
+  ASSERT_EQ(count(trace.str(), "{\"name\":\"log_span\",\"ph\":\"X\""), 1u);
+  boost::filesystem::remove_all(trace_file.parent_path());
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
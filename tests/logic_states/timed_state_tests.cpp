@@ -1,4 +1,5 @@
 #include <aerial_autonomy/actions_guards/base_functors.h>
+#include <aerial_autonomy/common/clock.h>
 #include <aerial_autonomy/logic_states/timed_state.h>
 #include <aerial_autonomy/tests/sample_logic_state_machine.h>
 #include <gtest/gtest.h>
@@ -25,15 +26,18 @@ TEST(TmedStateTests, Timing) {
 }
 
 TEST(TmedStateTests, TimingReset) {
+  auto clock = std::make_shared<SimulatedClock>();
+  Clock::setInstance(clock);
   TimedStateEmpty state;
   EmptyRobotSystem robot_system;
   SampleLogicStateMachine logic_state_machine(robot_system);
   state.on_entry(InternalTransitionEvent(), logic_state_machine);
-  this_thread::sleep_for(std::chrono::milliseconds(200));
+  clock->advance(std::chrono::milliseconds(200));
   state.on_entry(InternalTransitionEvent(), logic_state_machine);
-  this_thread::sleep_for(std::chrono::milliseconds(200));
-  ASSERT_GE(state.timeInState(), std::chrono::milliseconds(150));
-  ASSERT_LE(state.timeInState(), std::chrono::milliseconds(250));
+  clock->advance(std::chrono::milliseconds(200));
+  auto time_in_state = state.timeInState();
+  Clock::setInstance(nullptr);
+  ASSERT_EQ(time_in_state, std::chrono::milliseconds(200));
 }
 
 int main(int argc, char **argv) {
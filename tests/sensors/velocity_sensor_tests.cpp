@@ -40,6 +40,23 @@ TEST_F(VelocitySensorTests, SensorTest) {
   ASSERT_NEAR(sensor_vel.z, odom_msg.twist.twist.linear.z, 1e-4);
 }
 
+TEST_F(VelocitySensorTests, Sample) {
+  VelocitySensor sensor(config);
+  ASSERT_EQ(sensor.getSample().sequence, 0u);
+  nav_msgs::Odometry odom_msg;
+  for (int i = 1; i <= 3; ++i) {
+    odom_msg.twist.twist.linear.x = 0.1 * i;
+    odom_pub.publish(odom_msg);
+    ros::Duration(0.01).sleep();
+    ros::spinOnce();
+    auto sample = sensor.getSample();
+    ASSERT_EQ(sample.sequence, uint64_t(i));
+    ASSERT_NEAR(sample.data.x, odom_msg.twist.twist.linear.x, 1e-4);
+  }
+  // Reading again does not create a new sample
+  ASSERT_EQ(sensor.getSample().sequence, 3u);
+}
+
 TEST_F(VelocitySensorTests, Timeout) {
   VelocitySensor sensor(config);
   nav_msgs::Odometry odom_msg;